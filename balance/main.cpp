@@ -0,0 +1,293 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "game/world.hpp"
+#include "game/player_bot.hpp"
+#include "utils/resource_manager.hpp"
+
+#define BALANCE_DEFAULT_GAMES 1000
+#define BALANCE_DEFAULT_SEED 1
+#define BALANCE_DEFAULT_MAX_TIME 900.0f // seconds of game time, games still going are stopped
+#define BALANCE_DT (1.0f / 60.0f)
+
+/**
+ * @brief What happened in one game played by the bot
+ */
+typedef struct GameResult
+{
+    float survivalTime; // seconds of game time until the game was over or stopped
+    bool stopped;       // reached the max time with lives left
+    float totalScore;
+    float rawScores[NUM_SCORE_TYPES]; // counts of each score type
+    float scores[NUM_SCORE_TYPES];    // points of each score type
+    float difficultyTimes[NUM_DIFFICULTIES]; // seconds until the difficulty was reached, negative if it wasn't
+    int peakObjects;                         // asteroids, enemies and power ups
+    int peakBullets;
+    int peakAsteroids;
+    int peakEnemies;
+    double maxStepTime; // seconds of the slowest step
+    double stepTime;    // seconds of all the steps
+    int steps;
+} GameResult;
+
+typedef struct BalanceOptions
+{
+    int games;
+    int threads;
+    uint64_t seed;
+    float maxTime;
+    const char *csvPath;
+} BalanceOptions;
+
+static double Now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int CountBullets(World *world)
+{
+    int count = world->player->GetBullets()->size() + world->orphanBullets.size();
+    for (GameObject *object : world->gameObjects)
+    {
+        if (object->GetType() == ENEMY)
+        {
+            count += ((Enemy *)object)->GetBullets()->size();
+        }
+    }
+    return count;
+}
+
+static void PlayGame(World *world, PlayerBot *bot, uint64_t seed, float maxTime, GameResult *result)
+{
+    *result = {0};
+    for (int i = 0; i < NUM_DIFFICULTIES; i++)
+    {
+        result->difficultyTimes[i] = -1;
+    }
+
+    world->Create(INITIAL_ASTEROIDS, INITIAL_ENEMIES, seed);
+    world->player->Show();
+    bot->Reset(seed);
+    result->difficultyTimes[EASY] = 0;
+
+    while (!world->IsOver() && world->gameTime < maxTime)
+    {
+        world->player->SetInput(bot->Think(world));
+
+        const double start = Now();
+        world->Step(BALANCE_DT, true, true);
+        const double stepTime = Now() - start;
+        result->stepTime += stepTime;
+        result->maxStepTime = std::max(result->maxStepTime, stepTime);
+        result->steps++;
+
+        const int difficulty = world->diffSettings.difficulty;
+        if (result->difficultyTimes[difficulty] < 0)
+        {
+            result->difficultyTimes[difficulty] = world->gameTime;
+        }
+        result->peakObjects = std::max(result->peakObjects, (int)world->gameObjects.size());
+        result->peakBullets = std::max(result->peakBullets, CountBullets(world));
+        result->peakAsteroids = std::max(result->peakAsteroids, world->asteroidsCount);
+        result->peakEnemies = std::max(result->peakEnemies, world->shootersCount + world->stalkersCount + world->pulsersCount);
+    }
+
+    result->survivalTime = world->gameTime;
+    result->stopped = !world->IsOver();
+    WorldScope scope(world);
+    result->totalScore = GetTotalScore();
+    for (int i = 0; i < NUM_SCORE_TYPES; i++)
+    {
+        result->rawScores[i] = GetRawScore((ScoreType)i);
+        result->scores[i] = GetScore((ScoreType)i);
+    }
+}
+
+// each thread takes the next game until all are played, game i always plays seed + i
+static void PlayGames(const BalanceOptions *options, std::atomic<int> *nextGame, std::vector<GameResult> *results)
+{
+    World world;
+    PlayerBot bot;
+    int game;
+    while ((game = (*nextGame)++) < options->games)
+    {
+        PlayGame(&world, &bot, options->seed + game, options->maxTime, &(*results)[game]);
+    }
+}
+
+typedef struct Distribution
+{
+    double mean;
+    double p10;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+    int samples;
+} Distribution;
+
+static Distribution Summarize(std::vector<double> values)
+{
+    Distribution distribution = {0};
+    if (values.empty())
+    {
+        return distribution;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (double value : values)
+    {
+        sum += value;
+    }
+    // nearest rank percentiles
+    auto percentile = [&values](double p)
+    { return values[std::min(values.size() - 1, (size_t)(p * values.size()))]; };
+    distribution.mean = sum / values.size();
+    distribution.p10 = percentile(0.10);
+    distribution.p50 = percentile(0.50);
+    distribution.p90 = percentile(0.90);
+    distribution.p99 = percentile(0.99);
+    distribution.max = values.back();
+    distribution.samples = values.size();
+    return distribution;
+}
+
+template <typename F>
+static void PrintDistribution(const std::vector<GameResult> &results, const char *name, const char *unit, F value, bool skipNegative = false)
+{
+    std::vector<double> values;
+    for (const GameResult &result : results)
+    {
+        const double v = value(result);
+        if (!skipNegative || v >= 0)
+        {
+            values.push_back(v);
+        }
+    }
+    const Distribution d = Summarize(values);
+    printf("%-36s %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %7d  %s\n", name, d.mean, d.p10, d.p50, d.p90, d.p99, d.max, d.samples, unit);
+}
+
+static bool WriteCsv(const char *path, const std::vector<GameResult> &results, uint64_t seed)
+{
+    FILE *file = fopen(path, "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    fprintf(file, "seed,survival_time,stopped,total_score,medium_time,hard_time,peak_objects,peak_bullets,peak_asteroids,peak_enemies,max_step_us,mean_step_us");
+    for (int i = 0; i < NUM_SCORE_TYPES; i++)
+    {
+        fprintf(file, ",\"%s\"", GetScoreName((ScoreType)i));
+    }
+    fprintf(file, "\n");
+    for (size_t g = 0; g < results.size(); g++)
+    {
+        const GameResult *r = &results[g];
+        fprintf(file, "%llu,%.3f,%d,%.0f,%.3f,%.3f,%d,%d,%d,%d,%.2f,%.2f", (unsigned long long)(seed + g), r->survivalTime, r->stopped,
+                r->totalScore, r->difficultyTimes[MEDIUM], r->difficultyTimes[HARD], r->peakObjects, r->peakBullets,
+                r->peakAsteroids, r->peakEnemies, r->maxStepTime * 1e6, r->steps > 0 ? r->stepTime / r->steps * 1e6 : 0);
+        for (int i = 0; i < NUM_SCORE_TYPES; i++)
+        {
+            fprintf(file, ",%.0f", r->rawScores[i]);
+        }
+        fprintf(file, "\n");
+    }
+    fclose(file);
+    return true;
+}
+
+// usage: balance [--games <n>] [--threads <n>] [--seed <n>] [--max-time <seconds>] [--csv <file>]
+int main(int argc, char **argv)
+{
+    BalanceOptions options = {BALANCE_DEFAULT_GAMES, (int)std::thread::hardware_concurrency(), BALANCE_DEFAULT_SEED,
+                              BALANCE_DEFAULT_MAX_TIME, nullptr};
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+        {
+            options.games = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            options.threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--max-time") == 0 && i + 1 < argc)
+        {
+            options.maxTime = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+        {
+            options.csvPath = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--games <n>] [--threads <n>] [--seed <n>] [--max-time <seconds>] [--csv <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+    options.games = std::max(options.games, 1);
+    options.threads = std::clamp(options.threads, 1, options.games);
+
+    ResourceManager::LoadHeadlessResources();
+
+    printf("Playing %d games on %d threads (seeds %llu to %llu, at most %.0f s each)...\n", options.games, options.threads,
+           (unsigned long long)options.seed, (unsigned long long)(options.seed + options.games - 1), options.maxTime);
+    std::vector<GameResult> results(options.games);
+    std::atomic<int> nextGame = 0;
+    const double start = Now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < options.threads; i++)
+    {
+        threads.emplace_back(PlayGames, &options, &nextGame, &results);
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    const double seconds = Now() - start;
+
+    long steps = 0;
+    int stopped = 0;
+    for (const GameResult &result : results)
+    {
+        steps += result.steps;
+        stopped += result.stopped;
+    }
+    printf("Done in %.1f s, %.0f steps/s, %d games reached the max time\n\n", seconds, steps / seconds, stopped);
+
+    printf("%-36s %10s %10s %10s %10s %10s %10s %7s\n", "Balance", "mean", "p10", "p50", "p90", "p99", "max", "games");
+    PrintDistribution(results, "survival time", "s", [](const GameResult &r) { return r.survivalTime; });
+    PrintDistribution(results, "total score", "points", [](const GameResult &r) { return r.totalScore; });
+    PrintDistribution(results, "time to medium", "s", [](const GameResult &r) { return r.difficultyTimes[MEDIUM]; }, true);
+    PrintDistribution(results, "time to hard", "s", [](const GameResult &r) { return r.difficultyTimes[HARD]; }, true);
+    for (int i = 0; i < NUM_SCORE_TYPES; i++)
+    {
+        PrintDistribution(results, GetScoreName((ScoreType)i), "points", [i](const GameResult &r) { return r.scores[i]; });
+    }
+
+    printf("\n%-36s %10s %10s %10s %10s %10s %10s %7s\n", "Load", "mean", "p10", "p50", "p90", "p99", "max", "games");
+    PrintDistribution(results, "peak objects", "objects", [](const GameResult &r) { return r.peakObjects; });
+    PrintDistribution(results, "peak bullets", "bullets", [](const GameResult &r) { return r.peakBullets; });
+    PrintDistribution(results, "peak asteroids", "asteroids", [](const GameResult &r) { return r.peakAsteroids; });
+    PrintDistribution(results, "peak enemies", "enemies", [](const GameResult &r) { return r.peakEnemies; });
+    PrintDistribution(results, "mean step time", "us", [](const GameResult &r) { return r.steps > 0 ? r.stepTime / r.steps * 1e6 : 0; });
+    PrintDistribution(results, "slowest step time", "us", [](const GameResult &r) { return r.maxStepTime * 1e6; });
+
+    if (options.csvPath != nullptr && !WriteCsv(options.csvPath, results, options.seed))
+    {
+        fprintf(stderr, "Failed to write %s\n", options.csvPath);
+        return 1;
+    }
+    return 0;
+}
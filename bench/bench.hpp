@@ -0,0 +1,85 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stddef.h>
+
+#include "utils/memory_stats.hpp"
+
+/**
+ * @brief Gets a monotonic time in seconds used to time the benchmarks
+ */
+double BenchTime();
+
+/**
+ * @brief Records a benchmark result. Results are printed as a table when all the suites finish
+ * and written to the json file given with --json
+ *
+ * @param suite The suite the result belongs to
+ * @param name The name of the measured value
+ * @param value The measured value
+ * @param unit The unit of the value
+ */
+void ReportMetric(const char *suite, const char *name, double value, const char *unit);
+
+/**
+ * @brief Records the memory used by what a suite measured, printed and written to the json file with the results
+ *
+ * @param suite The suite the memory belongs to
+ * @param report The bytes of each category
+ */
+void ReportMemory(const char *suite, const MemoryReport *report);
+
+/**
+ * @brief Gets the game snapshot given with --snapshot, saved from the game with the debug save key
+ *
+ * @return The file, or null to use the built in late-game scene
+ */
+const char *GetBenchSnapshotFile();
+
+/**
+ * @brief Keeps the compiler from optimizing away the computation of a benchmark result
+ *
+ * @param data The result of the computation
+ */
+void DoNotOptimize(const void *data);
+
+// ------------------------------------------------------------------------------------------ //
+// ----------------------------------------- SUITES ----------------------------------------- //
+// ------------------------------------------------------------------------------------------ //
+
+/**
+ * @brief Point kernels (hitbox transforms) for every SIMD backend supported by the cpu
+ */
+void RunSimdBench();
+
+/**
+ * @brief Player bullets against asteroid hulls: brute force pairs vs the bullet grid and the SIMD kernels
+ */
+void RunBulletBench();
+
+/**
+ * @brief Separating axis tests between drifting asteroids with and without the contact cache
+ */
+void RunContactBench();
+
+/**
+ * @brief Behavior table decisions of mixed enemy types, cost per enemy for growing enemy counts
+ */
+void RunEnemyBench();
+
+/**
+ * @brief Writing and reading a late-game snapshot, and the asteroid contacts of the scene it holds
+ */
+void RunSnapshotBench();
+
+/**
+ * @brief Headless worlds playing the same seed, stepped one after the other and then each on its own thread
+ */
+void RunWorldBench();
+
+/**
+ * @brief Batched steps and observations of the embedding library driven by a random agent, one core
+ */
+void RunEmbedBench();
+
+#endif // __BENCH_H__
@@ -0,0 +1,125 @@
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+
+#include "bench.hpp"
+#include "game/point_grid.hpp"
+#include "utils/simd.hpp"
+
+#define BULLET_BENCH_BULLETS 1024
+#define BULLET_BENCH_HULLS 32
+#define BULLET_BENCH_HULL_SIZE 96.0f // pixels, a large asteroid
+#define BULLET_BENCH_CELL_SIZE 128   // pixels, same as the game
+#define BULLET_BENCH_ITERATIONS 200
+
+// large asteroid hitbox, closed like the ones used by the game
+static const Vector2 hullShape[] = {
+    {0.000f, -0.378f},
+    {0.250f, -0.252f},
+    {0.375f, 0.000f},
+    {0.250f, 0.252f},
+    {0.000f, 0.375f},
+    {-0.250f, 0.250f},
+    {-0.378f, 0.002f},
+    {-0.253f, -0.250f},
+    {0.000f, -0.378f},
+};
+
+// deterministic positions so every run tests the same scene
+static float Hash(unsigned int i)
+{
+    i = (i ^ 61) ^ (i >> 16);
+    i *= 9;
+    i = i ^ (i >> 4);
+    i *= 0x27d4eb2d;
+    i = i ^ (i >> 15);
+    return (float)(i & 0xffff) / 65535.0f;
+}
+
+void RunBulletBench()
+{
+    const Rectangle world = {-640, -360, 1280, 720};
+
+    std::vector<Vector2> bullets(BULLET_BENCH_BULLETS);
+    for (size_t i = 0; i < bullets.size(); i++)
+    {
+        bullets[i] = {world.x + Hash(2 * i) * world.width, world.y + Hash(2 * i + 1) * world.height};
+    }
+
+    const size_t hullCount = sizeof(hullShape) / sizeof(hullShape[0]);
+    std::vector<std::vector<Vector2>> hulls(BULLET_BENCH_HULLS, std::vector<Vector2>(hullCount));
+    std::vector<Rectangle> bounds(BULLET_BENCH_HULLS);
+    for (size_t h = 0; h < hulls.size(); h++)
+    {
+        const Vector2 center = {world.x + Hash(7919 + 2 * h) * world.width, world.y + Hash(7920 + 2 * h) * world.height};
+        TransformPoints(hullShape, hulls[h].data(), hullCount, MakePointTransform({0, 0}, h * 37.0f, BULLET_BENCH_HULL_SIZE, center));
+        bounds[h] = {center.x - BULLET_BENCH_HULL_SIZE / 2, center.y - BULLET_BENCH_HULL_SIZE / 2, BULLET_BENCH_HULL_SIZE, BULLET_BENCH_HULL_SIZE};
+    }
+
+    const double totalPairs = (double)BULLET_BENCH_BULLETS * BULLET_BENCH_HULLS * BULLET_BENCH_ITERATIONS;
+
+    // every bullet against every hull, what the game did before the grid
+    int expectedHits = 0;
+    double start = BenchTime();
+    for (int it = 0; it < BULLET_BENCH_ITERATIONS; it++)
+    {
+        expectedHits = 0;
+        for (size_t h = 0; h < hulls.size(); h++)
+        {
+            for (size_t b = 0; b < bullets.size(); b++)
+            {
+                expectedHits += CheckCollisionPointPoly(bullets[b], hulls[h].data(), hulls[h].size());
+            }
+        }
+    }
+    ReportMetric("bullets", "naive pairs", totalPairs / (BenchTime() - start) / 1e6, "Mpairs/s");
+    DoNotOptimize(&expectedHits);
+
+    const SimdBackend best = GetSimdBackend();
+    PointGrid grid;
+    HalfPlane planes[16];
+    std::vector<int> hits;
+
+    for (int b = SIMD_SCALAR; b < NUM_SIMD_BACKENDS; b++)
+    {
+        if (!SetSimdBackend((SimdBackend)b))
+        {
+            continue;
+        }
+        const std::string name = GetSimdBackendName((SimdBackend)b);
+
+        // pairs per second counts the pairs the naive loop would test, so both numbers can be compared
+        int tested = 0;
+        start = BenchTime();
+        for (int it = 0; it < BULLET_BENCH_ITERATIONS; it++)
+        {
+            grid.Begin(world, BULLET_BENCH_CELL_SIZE);
+            for (size_t i = 0; i < bullets.size(); i++)
+            {
+                grid.Add(bullets[i], (int)i);
+            }
+            grid.Finish();
+
+            hits.clear();
+            for (size_t h = 0; h < hulls.size(); h++)
+            {
+                const size_t planeCount = MakeConvexHalfPlanes(hulls[h].data(), hulls[h].size(), planes, 16);
+                if (planeCount > 0)
+                {
+                    grid.QueryConvex(bounds[h], planes, planeCount, &hits);
+                }
+                else
+                {
+                    grid.QueryPolygon(bounds[h], hulls[h].data(), hulls[h].size(), &hits);
+                }
+            }
+            tested = grid.GetTestedCount();
+        }
+        ReportMetric("bullets", ("grid pairs " + name).c_str(), totalPairs / (BenchTime() - start) / 1e6, "Mpairs/s");
+        ReportMetric("bullets", ("grid tested " + name).c_str(), 100.0 * tested / (BULLET_BENCH_BULLETS * BULLET_BENCH_HULLS), "% of pairs");
+        ReportMetric("bullets", ("hit mismatch " + name).c_str(), fabs((double)hits.size() - expectedHits), "hits");
+    }
+    SetSimdBackend(best);
+}
@@ -0,0 +1,103 @@
+#include <math.h>
+#include <vector>
+
+#include "raylib.h"
+
+#include "bench.hpp"
+#include "game/contact_cache.hpp"
+#include "game/objects/game_object.hpp"
+
+#define CONTACT_BENCH_OBJECTS 48
+#define CONTACT_BENCH_FRAMES 600
+#define CONTACT_BENCH_SIZE 96.0f  // pixels, a large asteroid
+#define CONTACT_BENCH_SPEED 40.0f // pixels/s, slow drifting objects stay close for many frames
+#define CONTACT_BENCH_DT (1.0f / 60.0f)
+
+// octagon hitbox, closed like the ones used by the game
+static std::vector<Vector2> MakeHull(Vector2 center)
+{
+    std::vector<Vector2> hull;
+    for (int i = 0; i <= 8; i++)
+    {
+        const float angle = (i % 8) * PI / 4;
+        hull.push_back({center.x + cosf(angle) * CONTACT_BENCH_SIZE * 0.375f, center.y + sinf(angle) * CONTACT_BENCH_SIZE * 0.375f});
+    }
+    return hull;
+}
+
+typedef struct ContactBenchResult
+{
+    double seconds;
+    double axesPerFrame;
+    double hitRate;
+    double contactsPerFrame;
+} ContactBenchResult;
+
+// moves the same scene every time and tests all the pairs every frame
+static ContactBenchResult RunScene(bool keepCache)
+{
+    const Rectangle world = {-640, -360, 1280, 720};
+    std::vector<GameObject> objects;
+    std::vector<Vector2> velocities;
+    objects.reserve(CONTACT_BENCH_OBJECTS);
+    for (int i = 0; i < CONTACT_BENCH_OBJECTS; i++)
+    {
+        // packed in a grid slightly smaller than the objects so neighbours start overlapping
+        const Vector2 center = {world.x + 80 + (i % 8) * CONTACT_BENCH_SIZE * 0.7f, world.y + 80 + (i / 8) * CONTACT_BENCH_SIZE * 0.7f};
+        const Rectangle bounds = {center.x - CONTACT_BENCH_SIZE / 2, center.y - CONTACT_BENCH_SIZE / 2, CONTACT_BENCH_SIZE, CONTACT_BENCH_SIZE};
+        objects.push_back(GameObject(bounds, 0, {0, -1}, MakeHull(center), ASTEROID));
+        velocities.push_back({cosf(i * 2.4f) * CONTACT_BENCH_SPEED, sinf(i * 2.4f) * CONTACT_BENCH_SPEED});
+    }
+
+    ContactCache cache;
+    ContactBenchResult result = {0};
+    Vector2 pushVector;
+    int collisions = 0;
+
+    const double start = BenchTime();
+    for (int frame = 0; frame < CONTACT_BENCH_FRAMES; frame++)
+    {
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            objects[i].Translate(Vector2Scale(velocities[i], CONTACT_BENCH_DT));
+            objects[i].Rotate(15.0f * CONTACT_BENCH_DT);
+        }
+
+        if (!keepCache)
+        {
+            cache.Clear();
+        }
+        cache.BeginFrame();
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            for (size_t j = i + 1; j < objects.size(); j++)
+            {
+                collisions += objects[i].CheckCollision(&objects[j], &pushVector, &cache);
+            }
+        }
+        result.axesPerFrame += cache.GetAxesTested();
+        result.hitRate += cache.GetHitRate();
+        result.contactsPerFrame += cache.GetContactCount();
+    }
+    result.seconds = BenchTime() - start;
+    DoNotOptimize(&collisions);
+
+    // stats are reported by the cache one frame late, the first frame has none
+    result.axesPerFrame /= CONTACT_BENCH_FRAMES - 1;
+    result.hitRate /= CONTACT_BENCH_FRAMES - 1;
+    result.contactsPerFrame /= CONTACT_BENCH_FRAMES - 1;
+    return result;
+}
+
+void RunContactBench()
+{
+    const ContactBenchResult cold = RunScene(false);
+    const ContactBenchResult warm = RunScene(true);
+
+    ReportMetric("contacts", "frame time cold", cold.seconds / CONTACT_BENCH_FRAMES * 1e6, "us");
+    ReportMetric("contacts", "frame time cached", warm.seconds / CONTACT_BENCH_FRAMES * 1e6, "us");
+    ReportMetric("contacts", "axes per frame cold", cold.axesPerFrame, "axes");
+    ReportMetric("contacts", "axes per frame cached", warm.axesPerFrame, "axes");
+    ReportMetric("contacts", "cache hit rate", warm.hitRate, "%");
+    ReportMetric("contacts", "cached pairs", warm.contactsPerFrame, "pairs");
+}
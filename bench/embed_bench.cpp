@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <vector>
+
+#include "bench.hpp"
+#include "minimeteor.h"
+#include "utils/rng.hpp"
+
+#define EMBED_BENCH_WORLDS 16
+#define EMBED_BENCH_STEPS 600 // steps of one tick, 10 seconds of game time per world
+#define EMBED_BENCH_SEED 0x6d696e69
+
+// an agent that holds random actions for a few steps, like a bot exploring
+static void PickActions(Rng *rng, std::vector<MMAction> *actions, const MMObservation *observations)
+{
+    for (size_t i = 0; i < actions->size(); i++)
+    {
+        if (rng->GetInt(0, 7) != 0)
+        {
+            continue;
+        }
+        MMAction *action = &(*actions)[i];
+        action->accelerate = rng->GetInt(0, 1);
+        action->turn = rng->GetInt(-1, 1);
+        action->moveX = rng->GetFloat(-1, 1);
+        action->moveY = rng->GetFloat(-1, 1);
+        action->aimX = observations[i].player.x + rng->GetFloat(-200, 200);
+        action->aimY = observations[i].player.y + rng->GetFloat(-200, 200);
+        action->boost = rng->GetInt(0, 3) == 0;
+        action->shoot = rng->GetInt(0, 1);
+        action->toggleShip = rng->GetInt(0, 63) == 0;
+    }
+}
+
+void RunEmbedBench()
+{
+    MMEnv *env = MMCreateEnv(EMBED_BENCH_WORLDS);
+    MMReset(env, -1, EMBED_BENCH_SEED);
+    std::vector<MMAction> actions(EMBED_BENCH_WORLDS, MMAction{0});
+    Rng rng(EMBED_BENCH_SEED, 0);
+
+    double stepTime = 0;
+    double observeTime = 0;
+    long entities = 0;
+    int resets = 0;
+    const MMObservation *observations = MMObserve(env);
+    for (int step = 0; step < EMBED_BENCH_STEPS; step++)
+    {
+        PickActions(&rng, &actions, observations);
+
+        double start = BenchTime();
+        MMStep(env, actions.data(), 1);
+        stepTime += BenchTime() - start;
+
+        start = BenchTime();
+        observations = MMObserve(env);
+        observeTime += BenchTime() - start;
+
+        for (int i = 0; i < EMBED_BENCH_WORLDS; i++)
+        {
+            entities += observations[i].count;
+            if (observations[i].over)
+            {
+                MMReset(env, i, EMBED_BENCH_SEED + step * EMBED_BENCH_WORLDS + i);
+                resets++;
+            }
+        }
+        DoNotOptimize(observations);
+    }
+    MMDestroyEnv(env);
+
+    const double envSteps = (double)EMBED_BENCH_WORLDS * EMBED_BENCH_STEPS;
+    ReportMetric("embed", "env steps per core", envSteps / (stepTime + observeTime), "steps/s");
+    ReportMetric("embed", "step time", stepTime / envSteps * 1e6, "us");
+    ReportMetric("embed", "observe time", observeTime / envSteps * 1e6, "us");
+    ReportMetric("embed", "entities per world", entities / envSteps, "entities");
+    ReportMetric("embed", "resets", resets, "games");
+}
@@ -0,0 +1,64 @@
+#include <math.h>
+#include <vector>
+
+#include "raylib.h"
+
+#include "bench.hpp"
+#include "game/enemy_brains.hpp"
+#include "game/objects/enemy.hpp"
+
+#define ENEMY_BENCH_FRAMES 200
+#define ENEMY_BENCH_DT (1.0f / 60.0f)
+#define ENEMY_BENCH_SEED 1234
+
+typedef struct EnemyBenchResult
+{
+    double secondsPerDecision;
+    double transitionsPerFrame;
+} EnemyBenchResult;
+
+// every enemy thinks every frame, the worst case for the scheduler budget
+static EnemyBenchResult RunScene(int count)
+{
+    const Rectangle world = {-640, -360, 1280, 720};
+    EnemyBrains brains;
+    std::vector<int> slots;
+    for (int i = 0; i < count; i++)
+    {
+        const EnemyDefinition *definition = GetEnemyDefinition((EnemyType)(i % NUM_ENEMY_TYPES));
+        const int slot = brains.Add(nullptr, definition->states, definition->initialState, 1.0f, 0.5f, Rng(ENEMY_BENCH_SEED, i), 0);
+        const Vector2 position = {world.x + fmodf(i * 37.0f, world.width), world.y + fmodf(i * 91.0f, world.height)};
+        brains.SetPose(slot, position, {cosf(i * 2.4f), sinf(i * 2.4f)}, true);
+        slots.push_back(slot);
+    }
+
+    EnemyBenchResult result = {0};
+    double time = 0;
+    int transitions = 0;
+
+    const double start = BenchTime();
+    for (int frame = 0; frame < ENEMY_BENCH_FRAMES; frame++)
+    {
+        time += ENEMY_BENCH_DT;
+        const BehaviorContext context = {{cosf(frame * 0.05f) * 200, sinf(frame * 0.05f) * 200}, true};
+        brains.Evaluate(time, slots, context);
+        transitions += brains.GetTransitionCount();
+    }
+    const double seconds = BenchTime() - start;
+    DoNotOptimize(&transitions);
+
+    result.secondsPerDecision = seconds / ((double)ENEMY_BENCH_FRAMES * count);
+    result.transitionsPerFrame = (double)transitions / ENEMY_BENCH_FRAMES;
+    return result;
+}
+
+void RunEnemyBench()
+{
+    static const int counts[] = {100, 1000, 10000};
+    for (int count : counts)
+    {
+        const EnemyBenchResult result = RunScene(count);
+        ReportMetric("enemies", TextFormat("decision time %d enemies", count), result.secondsPerDecision * 1e9, "ns");
+        ReportMetric("enemies", TextFormat("transitions per frame %d enemies", count), result.transitionsPerFrame, "transitions");
+    }
+}
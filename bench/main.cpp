@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "utils/counters.hpp"
+
+typedef struct BenchMetric
+{
+    std::string suite;
+    std::string name;
+    double value;
+    std::string unit;
+} BenchMetric;
+
+typedef struct BenchSuite
+{
+    const char *name;
+    void (*run)();
+} BenchSuite;
+
+static const BenchSuite suites[] = {
+    {"simd", RunSimdBench},
+    {"bullets", RunBulletBench},
+    {"contacts", RunContactBench},
+    {"enemies", RunEnemyBench},
+    {"snapshot", RunSnapshotBench},
+    {"worlds", RunWorldBench},
+    {"embed", RunEmbedBench},
+};
+
+typedef struct BenchMemory
+{
+    std::string suite;
+    MemoryReport report;
+} BenchMemory;
+
+static std::vector<BenchMetric> metrics;
+static std::vector<BenchMemory> memoryReports;
+static const char *snapshotPath = nullptr;
+
+double BenchTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ReportMetric(const char *suite, const char *name, double value, const char *unit)
+{
+    metrics.push_back({suite, name, value, unit});
+}
+
+void ReportMemory(const char *suite, const MemoryReport *report)
+{
+    memoryReports.push_back({suite, *report});
+}
+
+const char *GetBenchSnapshotFile()
+{
+    return snapshotPath;
+}
+
+void DoNotOptimize(const void *data)
+{
+    // an empty asm statement that may read the data, so whatever produced it can't be removed
+    __asm__ __volatile__("" : : "g"(data) : "memory");
+}
+
+bool WriteJson(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    fprintf(file, "{\n  \"metrics\": [\n");
+    for (size_t i = 0; i < metrics.size(); i++)
+    {
+        fprintf(file, "    {\"suite\": \"%s\", \"name\": \"%s\", \"value\": %.6g, \"unit\": \"%s\"}%s\n",
+                metrics[i].suite.c_str(), metrics[i].name.c_str(), metrics[i].value, metrics[i].unit.c_str(),
+                i + 1 < metrics.size() ? "," : "");
+    }
+    fprintf(file, "  ],\n  \"memory\": [\n");
+    for (size_t i = 0; i < memoryReports.size(); i++)
+    {
+        fprintf(file, "    {\"suite\": \"%s\"", memoryReports[i].suite.c_str());
+        for (int c = 0; c < NUM_MEMORY_CATEGORIES; c++)
+        {
+            const MemoryUsage usage = memoryReports[i].report.categories[c];
+            fprintf(file, ", \"%s\": {\"cpu\": %zu, \"gpu\": %zu}", GetMemoryCategoryName((MemoryCategory)c), usage.cpu, usage.gpu);
+        }
+        fprintf(file, "}%s\n", i + 1 < memoryReports.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+// usage: bench [--json <file>] [--snapshot <file>] [suite...]
+int main(int argc, char **argv)
+{
+    const char *jsonPath = nullptr;
+    std::vector<const char *> selected;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc)
+        {
+            snapshotPath = argv[++i];
+        }
+        else
+        {
+            selected.push_back(argv[i]);
+        }
+    }
+
+    for (const BenchSuite &suite : suites)
+    {
+        bool run = selected.empty();
+        for (const char *name : selected)
+        {
+            run = run || strcmp(name, suite.name) == 0;
+        }
+        if (run)
+        {
+            printf("Running %s...\n", suite.name);
+            uint64_t counters[NUM_COUNTERS];
+            for (int i = 0; i < NUM_COUNTERS; i++)
+            {
+                counters[i] = GetCounterTotal((CounterID)i);
+            }
+            suite.run();
+
+            // what the suite added to the hot path counters
+            for (int i = 0; i < NUM_COUNTERS; i++)
+            {
+                const uint64_t count = GetCounterTotal((CounterID)i) - counters[i];
+                if (count > 0)
+                {
+                    ReportMetric(suite.name, (std::string("counter: ") + GetCounterName((CounterID)i)).c_str(), count, "count");
+                }
+            }
+        }
+    }
+
+    printf("\n%-12s %-40s %16s  %s\n", "Suite", "Metric", "Value", "Unit");
+    for (const BenchMetric &metric : metrics)
+    {
+        printf("%-12s %-40s %16.4f  %s\n", metric.suite.c_str(), metric.name.c_str(), metric.value, metric.unit.c_str());
+    }
+    if (!memoryReports.empty())
+    {
+        printf("\n%-12s %-40s %16s %16s\n", "Suite", "Memory", "CPU KB", "GPU KB");
+    }
+    for (const BenchMemory &memory : memoryReports)
+    {
+        for (int c = 0; c < NUM_MEMORY_CATEGORIES; c++)
+        {
+            const MemoryUsage usage = memory.report.categories[c];
+            if (usage.cpu > 0 || usage.gpu > 0)
+            {
+                printf("%-12s %-40s %16.1f %16.1f\n", memory.suite.c_str(), GetMemoryCategoryName((MemoryCategory)c), usage.cpu / 1024.0, usage.gpu / 1024.0);
+            }
+        }
+    }
+
+    if (jsonPath != nullptr && !WriteJson(jsonPath))
+    {
+        fprintf(stderr, "Failed to write %s\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include "bench.hpp"
+#include "utils/simd.hpp"
+
+#define SIMD_BENCH_POINTS 9 * 4096 // 4096 asteroid sized hitboxes
+#define SIMD_BENCH_ITERATIONS 200
+
+// the per vertex Vector2Rotate path the kernels replaced
+static void RotatePointsRaymath(std::vector<Vector2> *points, Vector2 pivot, float angle)
+{
+    for (size_t i = 0; i < points->size(); i++)
+    {
+        Vector2 vertex = Vector2Subtract((*points)[i], pivot);
+        vertex = Vector2Rotate(vertex, angle * DEG2RAD);
+        (*points)[i] = Vector2Add(vertex, pivot);
+    }
+}
+
+void RunSimdBench()
+{
+    std::vector<Vector2> source(SIMD_BENCH_POINTS);
+    for (size_t i = 0; i < source.size(); i++)
+    {
+        source[i] = {(float)(i % 1280) - 640.0f, (float)(i % 720) - 360.0f};
+    }
+    const double totalPoints = (double)SIMD_BENCH_POINTS * SIMD_BENCH_ITERATIONS;
+    const PointTransform transform = MakePointTransform({12, -7}, 1.5f, 1.0f, {0.5f, -0.25f});
+
+    std::vector<Vector2> points = source;
+    double start = BenchTime();
+    for (int i = 0; i < SIMD_BENCH_ITERATIONS; i++)
+    {
+        RotatePointsRaymath(&points, {12, -7}, 1.5f);
+    }
+    ReportMetric("simd", "rotate raymath", totalPoints / (BenchTime() - start) / 1e6, "Mpoints/s");
+    DoNotOptimize(points.data());
+
+    // scalar result used to check the other backends
+    const SimdBackend best = GetSimdBackend();
+    std::vector<Vector2> expected(source.size());
+    SetSimdBackend(SIMD_SCALAR);
+    TransformPoints(source.data(), expected.data(), source.size(), transform);
+
+    for (int b = SIMD_SCALAR; b < NUM_SIMD_BACKENDS; b++)
+    {
+        if (!SetSimdBackend((SimdBackend)b))
+        {
+            continue;
+        }
+        const std::string name = GetSimdBackendName((SimdBackend)b);
+
+        points = source;
+        start = BenchTime();
+        for (int i = 0; i < SIMD_BENCH_ITERATIONS; i++)
+        {
+            TranslatePoints(points.data(), points.size(), {0.5f, -0.25f});
+        }
+        ReportMetric("simd", ("translate " + name).c_str(), totalPoints / (BenchTime() - start) / 1e6, "Mpoints/s");
+        DoNotOptimize(points.data());
+
+        points = source;
+        start = BenchTime();
+        for (int i = 0; i < SIMD_BENCH_ITERATIONS; i++)
+        {
+            TransformPoints(points.data(), points.data(), points.size(), transform);
+        }
+        ReportMetric("simd", ("transform " + name).c_str(), totalPoints / (BenchTime() - start) / 1e6, "Mpoints/s");
+        DoNotOptimize(points.data());
+
+        points.assign(source.size(), {0, 0});
+        TransformPoints(source.data(), points.data(), source.size(), transform);
+        float maxError = 0;
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            maxError = fmaxf(maxError, Vector2Distance(points[i], expected[i]));
+        }
+        ReportMetric("simd", ("max error " + name).c_str(), maxError, "pixels");
+    }
+    SetSimdBackend(best);
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+#include "raylib.h"
+
+#include "bench.hpp"
+#include "game/game_snapshot.hpp"
+#include "game/contact_cache.hpp"
+#include "game/objects/game_object.hpp"
+#include "game/world.hpp"
+#include "utils/resource_manager.hpp"
+
+#define SNAPSHOT_BENCH_ASTEROIDS 18       // max asteroids on hard
+#define SNAPSHOT_BENCH_ENEMIES 13         // max enemies on hard
+#define SNAPSHOT_BENCH_ENEMY_BULLETS 24   // bullets of a pulser burst on hard
+#define SNAPSHOT_BENCH_PLAYER_BULLETS 40
+#define SNAPSHOT_BENCH_POWER_UPS 6
+#define SNAPSHOT_BENCH_ROUNDS 200
+#define SNAPSHOT_BENCH_FRAMES 600
+#define SNAPSHOT_BENCH_DT (1.0f / 60.0f)
+
+static ObjectRecord MakeObject(GameSnapshot *snapshot, GameObjectType type, Vector2 origin, float size, Vector2 velocity)
+{
+    ObjectRecord record = {0};
+    record.type = type;
+    record.detail = -1;
+    record.bounds = {origin.x - size / 2, origin.y - size / 2, size, size};
+    record.origin = origin;
+    record.forwardDir = {0, -1};
+    record.velocity = velocity;
+    record.previousVelocity = velocity;
+    record.hitboxFirst = snapshot->hitboxPoints.size();
+
+    // octagon hitbox, closed like the ones used by the game
+    for (int i = 0; i <= 8; i++)
+    {
+        const float angle = (i % 8) * PI / 4;
+        snapshot->hitboxPoints.push_back({origin.x + cosf(angle) * size * 0.375f, origin.y + sinf(angle) * size * 0.375f});
+    }
+    record.hitboxCount = 9;
+    for (int i = 0; i < NUM_TIMER_EVENTS; i++)
+    {
+        record.timersLeft[i] = -1;
+    }
+    return record;
+}
+
+static void AddBullets(GameSnapshot *snapshot, CharacterRecord *character, Vector2 origin, int count, bool isPlayerBullet)
+{
+    character->bulletFirst = snapshot->bullets.size();
+    character->bulletCount = count;
+    for (int i = 0; i < count; i++)
+    {
+        const Vector2 dir = {cosf(i * 0.7f), sinf(i * 0.7f)};
+        BulletRecord bullet = {0};
+        bullet.object = MakeObject(snapshot, isPlayerBullet ? BULLET : ENEMY_BULLET, {origin.x + dir.x * i * 12, origin.y + dir.y * i * 12}, 8, {dir.x * 400, dir.y * 400});
+        bullet.isPlayerBullet = isPlayerBullet;
+        bullet.isAlive = true;
+        snapshot->bullets.push_back(bullet);
+    }
+}
+
+// the world of a hard game with every object type at its maximum, built as records so no window is needed
+static void BuildLateGame(GameSnapshot *snapshot)
+{
+    ClearGameSnapshot(snapshot);
+    WorldRecord *world = &snapshot->world;
+    world->gameTime = 600;
+    world->difficulty = 2;
+    world->asteroidsCount = SNAPSHOT_BENCH_ASTEROIDS;
+    world->shootersCount = 8;
+    world->stalkersCount = 3;
+    world->pulsersCount = 2;
+
+    for (int i = 0; i < SNAPSHOT_BENCH_ASTEROIDS; i++)
+    {
+        // packed in a grid slightly smaller than the objects so neighbours start overlapping
+        const Vector2 origin = {-560 + (i % 6) * 70.0f, -280 + (i / 6) * 70.0f};
+        ObjectRecord record = MakeObject(snapshot, ASTEROID, origin, 96, {cosf(i * 2.4f) * 40, sinf(i * 2.4f) * 40});
+        record.kind = i % 2;
+        record.detail = snapshot->asteroids.size();
+        snapshot->objects.push_back(record);
+        snapshot->asteroids.push_back({0, 96, -1, 0});
+    }
+
+    for (int i = 0; i < SNAPSHOT_BENCH_ENEMIES; i++)
+    {
+        const Vector2 origin = {100 + (i % 5) * 90.0f, -200 + (i / 5) * 90.0f};
+        ObjectRecord record = MakeObject(snapshot, ENEMY, origin, 64, {cosf(i * 1.3f) * 80, sinf(i * 1.3f) * 80});
+        record.kind = i % 3;
+        record.detail = snapshot->enemies.size();
+        EnemyRecord enemy = {0};
+        enemy.character.lives = 1;
+        AddBullets(snapshot, &enemy.character, origin, SNAPSHOT_BENCH_ENEMY_BULLETS, false);
+        snapshot->objects.push_back(record);
+        snapshot->enemies.push_back(enemy);
+    }
+    world->objectCount = snapshot->objects.size();
+
+    ObjectRecord playerObject = MakeObject(snapshot, PLAYER, {0, 0}, 64, {0, 0});
+    playerObject.detail = 0;
+    PlayerRecord player = {0};
+    player.character.lives = 3;
+    AddBullets(snapshot, &player.character, {0, 0}, SNAPSHOT_BENCH_PLAYER_BULLETS, true);
+    world->playerObject = snapshot->objects.size();
+    snapshot->objects.push_back(playerObject);
+
+    player.powerupFirst = snapshot->objects.size();
+    player.powerupCount = SNAPSHOT_BENCH_POWER_UPS;
+    for (int i = 0; i < SNAPSHOT_BENCH_POWER_UPS; i++)
+    {
+        ObjectRecord record = MakeObject(snapshot, POWER_UP, {0, 0}, 32, {0, 0});
+        record.kind = i;
+        record.detail = snapshot->powerups.size();
+        snapshot->objects.push_back(record);
+        snapshot->powerups.push_back({true, false});
+    }
+    snapshot->players.push_back(player);
+}
+
+static bool ReadSnapshotFile(const char *path, GameSnapshot *snapshot)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    std::vector<unsigned char> data;
+    unsigned char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return ReadGameSnapshot(data.data(), data.size(), snapshot);
+}
+
+// moves the asteroids and enemies of the snapshot with their saved velocities and tests all their pairs every frame
+static double RunSnapshotScene(const GameSnapshot *snapshot, int *bodies)
+{
+    std::vector<GameObject> objects;
+    std::vector<Vector2> velocities;
+    for (int i = 0; i < snapshot->world.objectCount; i++)
+    {
+        const ObjectRecord *record = &snapshot->objects[i];
+        if (record->type != ASTEROID && record->type != ENEMY)
+        {
+            continue;
+        }
+        std::vector<Vector2> hitbox(snapshot->hitboxPoints.begin() + record->hitboxFirst,
+                                    snapshot->hitboxPoints.begin() + record->hitboxFirst + record->hitboxCount);
+        objects.push_back(GameObject(record->bounds, record->rotation, record->forwardDir, hitbox, (GameObjectType)record->type));
+        velocities.push_back(record->velocity);
+    }
+    *bodies = objects.size();
+
+    ContactCache cache;
+    Vector2 pushVector;
+    int collisions = 0;
+
+    const double start = BenchTime();
+    for (int frame = 0; frame < SNAPSHOT_BENCH_FRAMES; frame++)
+    {
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            objects[i].Translate(Vector2Scale(velocities[i], SNAPSHOT_BENCH_DT));
+        }
+        cache.BeginFrame();
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            for (size_t j = i + 1; j < objects.size(); j++)
+            {
+                collisions += objects[i].CheckCollision(&objects[j], &pushVector, &cache);
+            }
+        }
+    }
+    const double seconds = BenchTime() - start;
+    DoNotOptimize(&collisions);
+    return seconds;
+}
+
+void RunSnapshotBench()
+{
+    GameSnapshot snapshot;
+    const char *path = GetBenchSnapshotFile();
+    if (path != nullptr && !ReadSnapshotFile(path, &snapshot))
+    {
+        fprintf(stderr, "Failed to read snapshot %s, using the built in scene\n", path);
+        path = nullptr;
+    }
+    if (path == nullptr)
+    {
+        BuildLateGame(&snapshot);
+    }
+
+    std::vector<unsigned char> data;
+    WriteGameSnapshot(&snapshot, &data); // warm up, the buffer keeps its memory after this
+
+    double start = BenchTime();
+    for (int i = 0; i < SNAPSHOT_BENCH_ROUNDS; i++)
+    {
+        WriteGameSnapshot(&snapshot, &data);
+        DoNotOptimize(data.data());
+    }
+    const double writeTime = (BenchTime() - start) / SNAPSHOT_BENCH_ROUNDS;
+
+    GameSnapshot read;
+    bool valid = true;
+    start = BenchTime();
+    for (int i = 0; i < SNAPSHOT_BENCH_ROUNDS; i++)
+    {
+        valid = valid && ReadGameSnapshot(data.data(), data.size(), &read);
+        DoNotOptimize(&read);
+    }
+    const double readTime = (BenchTime() - start) / SNAPSHOT_BENCH_ROUNDS;
+    if (!valid)
+    {
+        fprintf(stderr, "Snapshot written by the bench couldn't be read back\n");
+    }
+
+    int bodies = 0;
+    const double sceneTime = RunSnapshotScene(&read, &bodies);
+
+    // the memory of the objects of the scene once it is a world
+    ResourceManager::LoadHeadlessResources();
+    World world;
+    world.Create(0, 0, 1);
+    world.Restore(&read);
+    MemoryReport memory = {0};
+    world.GetMemoryUsage(&memory);
+    ReportMemory("snapshot", &memory);
+
+    ReportMetric("snapshot", "size", data.size() / 1024.0, "KB");
+    ReportMetric("snapshot", "objects", snapshot.objects.size() + snapshot.bullets.size(), "objects");
+    ReportMetric("snapshot", "write time", writeTime * 1e6, "us");
+    ReportMetric("snapshot", "read time", readTime * 1e6, "us");
+    ReportMetric("snapshot", "scene bodies", bodies, "bodies");
+    ReportMetric("snapshot", "scene frame time", sceneTime / SNAPSHOT_BENCH_FRAMES * 1e6, "us");
+}
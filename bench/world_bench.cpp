@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "game/world.hpp"
+#include "utils/resource_manager.hpp"
+
+#define WORLD_BENCH_FRAMES 1200 // 20 seconds of game time per world
+#define WORLD_BENCH_DT (1.0f / 60.0f)
+#define WORLD_BENCH_ASTEROIDS 5 // the objects of a new game
+#define WORLD_BENCH_ENEMIES 1
+#define WORLD_BENCH_MIN_WORLDS 2 // so the worlds have someone to compare their state with
+#define WORLD_BENCH_MAX_WORLDS 8
+#define WORLD_BENCH_SEED 0x6d696e69
+
+// steps one world for all the frames on the calling thread, then captures it to compare it with the others
+static void StepWorld(World *world, int frames, std::vector<unsigned char> *result)
+{
+    WorldScope scope(world);
+    for (int frame = 0; frame < frames; frame++)
+    {
+        world->Step(WORLD_BENCH_DT, true, true);
+    }
+    GameSnapshot snapshot;
+    world->Capture(&snapshot);
+    WriteGameSnapshot(&snapshot, result);
+}
+
+// every world plays the same seed, so they all must end in the same state
+static double RunWorlds(int count, bool threaded, bool *deterministic)
+{
+    std::vector<World> worlds(count);
+    std::vector<std::vector<unsigned char>> results(count);
+    for (World &world : worlds)
+    {
+        WorldScope scope(&world);
+        world.Create(WORLD_BENCH_ASTEROIDS, WORLD_BENCH_ENEMIES, WORLD_BENCH_SEED);
+        world.UpdateDifficultySettings(HARD); // after creating it, new games start on easy
+    }
+
+    const double start = BenchTime();
+    if (threaded)
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < count; i++)
+        {
+            threads.emplace_back(StepWorld, &worlds[i], WORLD_BENCH_FRAMES, &results[i]);
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            StepWorld(&worlds[i], WORLD_BENCH_FRAMES, &results[i]);
+        }
+    }
+    const double seconds = BenchTime() - start;
+
+    for (int i = 1; i < count; i++)
+    {
+        if (results[i].size() != results[0].size() || memcmp(results[i].data(), results[0].data(), results[0].size()) != 0)
+        {
+            *deterministic = false;
+        }
+    }
+    return seconds;
+}
+
+void RunWorldBench()
+{
+    ResourceManager::LoadHeadlessResources();
+
+    int count = std::thread::hardware_concurrency();
+    count = count < WORLD_BENCH_MIN_WORLDS ? WORLD_BENCH_MIN_WORLDS : (count > WORLD_BENCH_MAX_WORLDS ? WORLD_BENCH_MAX_WORLDS : count);
+
+    bool deterministic = true;
+    const double serialTime = RunWorlds(count, false, &deterministic);
+    const double threadedTime = RunWorlds(count, true, &deterministic);
+    if (!deterministic)
+    {
+        fprintf(stderr, "Worlds with the same seed ended in different states\n");
+    }
+
+    const double steps = (double)count * WORLD_BENCH_FRAMES;
+    ReportMetric("worlds", "worlds", count, "worlds");
+    ReportMetric("worlds", "serial step time", serialTime / steps * 1e6, "us");
+    ReportMetric("worlds", "threaded steps", steps / threadedTime, "steps/s");
+    ReportMetric("worlds", "threaded speedup", serialTime / threadedTime, "x");
+    ReportMetric("worlds", "deterministic", deterministic, "bool");
+}
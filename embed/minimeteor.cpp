@@ -0,0 +1,181 @@
+#include "minimeteor.h"
+#include "game/world.hpp"
+#include "utils/resource_manager.hpp"
+
+#include <vector>
+
+static_assert(MM_TYPE_ENEMY == ENEMY && MM_TYPE_BULLET == BULLET && MM_TYPE_ENEMY_BULLET == ENEMY_BULLET &&
+                  MM_TYPE_ASTEROID == ASTEROID && MM_TYPE_POWER_UP == POWER_UP,
+              "the entity types of the api are the game object types");
+
+#define MM_TICK_TIME (1.0f / MM_TICK_RATE) // seconds
+
+struct MMEnv
+{
+    std::vector<World> worlds;
+    std::vector<MMObservation> observations;
+    std::vector<int> firstEntities; // of each world in the entity arrays
+    // entities of all the worlds, one after the other
+    std::vector<float> positions;
+    std::vector<float> velocities;
+    std::vector<int> types;
+    bool observed; // the observations are up to date with the worlds
+};
+
+static void AddEntity(MMEnv *env, GameObject *object)
+{
+    const Vector2 origin = object->GetOrigin();
+    const Vector2 velocity = object->GetVelocity();
+    env->positions.push_back(origin.x);
+    env->positions.push_back(origin.y);
+    env->velocities.push_back(velocity.x);
+    env->velocities.push_back(velocity.y);
+    env->types.push_back(object->GetType());
+}
+
+static void AddBullets(MMEnv *env, std::vector<Bullet> *bullets)
+{
+    for (Bullet &bullet : *bullets)
+    {
+        if (bullet.IsAlive())
+        {
+            AddEntity(env, &bullet);
+        }
+    }
+}
+
+static void ObserveWorld(MMEnv *env, World *world, MMObservation *observation)
+{
+    for (GameObject *object : world->gameObjects)
+    {
+        AddEntity(env, object);
+        if (object->GetType() == ENEMY)
+        {
+            AddBullets(env, ((Enemy *)object)->GetBullets());
+        }
+    }
+    AddBullets(env, &world->orphanBullets);
+    AddBullets(env, world->player->GetBullets());
+
+    Player *player = world->player;
+    const Vector2 origin = player->GetOrigin();
+    const Vector2 velocity = player->GetVelocity();
+    const Vector2 forward = player->GetForwardDir();
+    observation->player = {origin.x, origin.y, velocity.x, velocity.y, forward.x, forward.y,
+                           player->GetLives(), player->IsAlive(), player->IsDirectionalShip(),
+                           player->GetBoostTime(), player->GetDirectionalShipMeter()};
+    observation->gameTime = world->gameTime;
+    observation->score = world->scores.totalScore;
+    observation->over = world->IsOver();
+}
+
+// gathers the entities of all the worlds into the arrays once per step, the observations point into them
+static void ObserveEnv(MMEnv *env)
+{
+    env->positions.clear();
+    env->velocities.clear();
+    env->types.clear();
+    for (size_t i = 0; i < env->worlds.size(); i++)
+    {
+        env->firstEntities[i] = env->types.size();
+        ObserveWorld(env, &env->worlds[i], &env->observations[i]);
+    }
+    // the arrays are complete, so they don't move anymore
+    for (size_t i = 0; i < env->worlds.size(); i++)
+    {
+        const int first = env->firstEntities[i];
+        const int end = i + 1 < env->worlds.size() ? env->firstEntities[i + 1] : (int)env->types.size();
+        env->observations[i].count = end - first;
+        env->observations[i].positions = env->positions.data() + first * 2;
+        env->observations[i].velocities = env->velocities.data() + first * 2;
+        env->observations[i].types = env->types.data() + first;
+    }
+    env->observed = true;
+}
+
+static void ResetWorld(World *world, uint64_t seed)
+{
+    world->Create(INITIAL_ASTEROIDS, INITIAL_ENEMIES, seed);
+    world->player->Show();
+    world->player->SetInput({0});
+}
+
+MMEnv *MMCreateEnv(int numWorlds)
+{
+    if (numWorlds <= 0)
+    {
+        return nullptr;
+    }
+    ResourceManager::LoadHeadlessResources();
+
+    MMEnv *env = new MMEnv();
+    env->worlds = std::vector<World>(numWorlds);
+    env->observations.resize(numWorlds);
+    env->firstEntities.resize(numWorlds);
+    MMReset(env, -1, 1);
+    return env;
+}
+
+void MMDestroyEnv(MMEnv *env)
+{
+    delete env;
+}
+
+int MMGetNumWorlds(const MMEnv *env)
+{
+    return env->worlds.size();
+}
+
+void MMReset(MMEnv *env, int world, uint64_t seed)
+{
+    if (world < 0)
+    {
+        for (size_t i = 0; i < env->worlds.size(); i++)
+        {
+            ResetWorld(&env->worlds[i], seed + i);
+        }
+    }
+    else if (world < (int)env->worlds.size())
+    {
+        ResetWorld(&env->worlds[world], seed);
+    }
+    env->observed = false;
+}
+
+void MMStep(MMEnv *env, const MMAction *actions, int numTicks)
+{
+    for (size_t i = 0; i < env->worlds.size(); i++)
+    {
+        World *world = &env->worlds[i];
+        if (world->IsOver())
+        {
+            continue;
+        }
+
+        const MMAction *action = &actions[i];
+        PlayerInput input;
+        input.accelerate = action->accelerate != 0;
+        input.turn = action->turn < 0 ? -1 : (action->turn > 0 ? 1 : 0);
+        input.moveDir = {action->moveX, action->moveY};
+        input.aimTarget = {action->aimX, action->aimY};
+        input.boost = action->boost != 0;
+        input.shoot = action->shoot != 0;
+        input.toggleShip = action->toggleShip != 0;
+        world->player->SetInput(input);
+
+        for (int tick = 0; tick < numTicks && !world->IsOver(); tick++)
+        {
+            world->Step(MM_TICK_TIME, true, true);
+        }
+    }
+    env->observed = false;
+}
+
+const MMObservation *MMObserve(MMEnv *env)
+{
+    if (!env->observed)
+    {
+        ObserveEnv(env);
+    }
+    return env->observations.data();
+}
@@ -0,0 +1,113 @@
+#ifndef __MINIMETEOR_H__
+#define __MINIMETEOR_H__
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define MM_API __declspec(dllexport)
+#else
+#define MM_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define MM_TICK_RATE 60 // ticks per second of game time, a step advances the worlds a whole number of ticks
+
+// entity types, the same numbers as the game object types
+#define MM_TYPE_ENEMY 1
+#define MM_TYPE_BULLET 2 // shot by the player
+#define MM_TYPE_ENEMY_BULLET 3
+#define MM_TYPE_ASTEROID 4
+#define MM_TYPE_POWER_UP 5
+
+    /**
+     * @brief A batch of independent worlds stepped together
+     */
+    typedef struct MMEnv MMEnv;
+
+    /**
+     * @brief What the player of a world does, held for all the ticks of a step
+     */
+    typedef struct MMAction
+    {
+        int accelerate;      // for the ship
+        int turn;            // -1 left, 0 none, 1 right, for the ship
+        float moveX, moveY;  // -1 to 1, for the directional ship
+        float aimX, aimY;    // world position the directional ship faces
+        int boost;
+        int shoot;
+        int toggleShip; // changes between the ship and the directional ship once, at the first tick
+    } MMAction;
+
+    typedef struct MMPlayerState
+    {
+        float x, y;   // world position, the world is centered on the origin
+        float vx, vy; // pixels/s
+        float forwardX, forwardY;
+        int lives;
+        int alive;
+        int directionalShip;
+        float boostTime;            // seconds of boost left
+        float directionalShipMeter; // 0 to 100
+    } MMPlayerState;
+
+    /**
+     * @brief The state of one world. The arrays point into memory owned by the env,
+     * valid until the next step or reset of the env
+     */
+    typedef struct MMObservation
+    {
+        int count;               // entities in the arrays
+        const float *positions;  // x, y per entity
+        const float *velocities; // vx, vy per entity
+        const int *types;        // MM_TYPE_* per entity
+        MMPlayerState player;
+        double gameTime; // seconds
+        float score;
+        int over; // the player died with no lives left, the world isn't stepped until it is reset
+    } MMObservation;
+
+    /**
+     * @brief Creates a batch of worlds, without a window. Create the envs of a process from one thread,
+     * then each env can be used from its own thread
+     *
+     * @param numWorlds The worlds of the batch
+     * @return The env, reset with seeds 1 to numWorlds, or null if numWorlds isn't positive
+     */
+    MM_API MMEnv *MMCreateEnv(int numWorlds);
+
+    MM_API void MMDestroyEnv(MMEnv *env);
+
+    MM_API int MMGetNumWorlds(const MMEnv *env);
+
+    /**
+     * @brief Starts a new game in a world. The same seed plays the same game for the same actions
+     *
+     * @param world The world, or -1 for all of them, seeded with seed, seed + 1...
+     * @param seed The seed of the game
+     */
+    MM_API void MMReset(MMEnv *env, int world, uint64_t seed);
+
+    /**
+     * @brief Steps every world that isn't over
+     *
+     * @param actions One action per world
+     * @param numTicks Ticks each world is advanced holding its action, a world stops early when it is over
+     */
+    MM_API void MMStep(MMEnv *env, const MMAction *actions, int numTicks);
+
+    /**
+     * @brief Gets the state of all the worlds
+     *
+     * @return One observation per world, valid until the next step or reset of the env
+     */
+    MM_API const MMObservation *MMObserve(MMEnv *env);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MINIMETEOR_H__
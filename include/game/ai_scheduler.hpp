@@ -0,0 +1,64 @@
+#ifndef __AI_SCHEDULER_H__
+#define __AI_SCHEDULER_H__
+
+#include "raylib.h"
+#include <stddef.h>
+#include <vector>
+
+#include "game/enemy_brains.hpp"
+
+#define AI_THINK_BUDGET 8                // decisions per frame
+#define AI_NEAR_DISTANCE 400.0f          // pixels from the player
+#define AI_THINK_INTERVAL_NEAR 0.05f     // seconds between decisions of the enemies close to the player
+#define AI_THINK_INTERVAL_VISIBLE 0.1f   // seconds between decisions of the other enemies inside the camera view
+#define AI_THINK_INTERVAL_FAR 0.3f       // seconds between decisions of the enemies outside the camera view
+
+/**
+ * @brief Spreads the enemy decisions over the frames. Enemies steer every frame in their Update,
+ * but only decide what to do (turn, accelerate, shoot) when their think interval has passed,
+ * more often when they are close to the player or visible.
+ * Due enemies are visited round-robin and at most a budget of them think each frame,
+ * the rest keep steering with their last decision and think in the next frames.
+ * The picked enemies are evaluated together by EnemyBrains
+ */
+class AIScheduler
+{
+private:
+    std::vector<int> due; // brain slots picked this frame
+    size_t cursor;        // first slot visited next frame
+    int budget;
+    int thinkCount;
+    int dueCount;
+
+public:
+    AIScheduler();
+    ~AIScheduler();
+
+    /**
+     * @brief Runs the decisions of the due enemies, up to the budget
+     *
+     * @param brains The behavior data of the enemies
+     * @param time The game time in seconds
+     * @param camera The camera the world is seen with, enemies outside of its view think less often
+     * @param context The player information, enemies close to it think more often
+     */
+    void Run(EnemyBrains *brains, double time, Camera2D camera, BehaviorContext context);
+
+    /**
+     * @brief Sets the maximum number of enemies that think each frame
+     *
+     * @param budget The number of decisions, at least 1
+     */
+    void SetBudget(int budget) { this->budget = budget > 0 ? budget : 1; }
+
+    /**
+     * @brief Starts visiting the enemies from the first slot again, for a new game
+     */
+    void Reset() { cursor = 0; }
+
+    int GetBudget() { return budget; }
+    int GetThinkCount() { return thinkCount; }
+    int GetDueCount() { return dueCount; }
+};
+
+#endif // __AI_SCHEDULER_H__
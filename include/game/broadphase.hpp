@@ -0,0 +1,80 @@
+#ifndef __BROADPHASE_H__
+#define __BROADPHASE_H__
+
+#include "raylib.h"
+#include <vector>
+
+#include "game/objects/game_object.hpp"
+
+/**
+ * @brief An entry of the broadphase: an object, or a ghost of an object that wraps around the world edges
+ */
+typedef struct BroadphaseProxy
+{
+    GameObject *object;
+    Rectangle bounds; // bounds of the object moved by the offset
+    Vector2 offset;   // (0, 0) for the object itself, a wrap period for its ghosts
+    int order;        // order the object was added in, keeps the pairs in a stable order
+} BroadphaseProxy;
+
+/**
+ * @brief Two objects whose bounding boxes overlap, directly or across the world edges
+ */
+typedef struct BroadphasePair
+{
+    GameObject *a;
+    GameObject *b;
+    Vector2 offset; // added to b to move it next to a, see GameObject::CheckCollision
+    int orderA;     // order a was added in
+    int orderB;     // order b was added in, always after a
+} BroadphasePair;
+
+/**
+ * @brief Finds the pairs of objects whose bounding boxes overlap with a sweep along the x axis.
+ * Objects that wrap around and cross the world edges also get ghosts on the other sides of the world,
+ * so they collide with the objects there. Only the objects on the edges get ghosts,
+ * so wrapping around only adds the pairs of the boundary bands
+ */
+class Broadphase
+{
+private:
+    Rectangle worldBox;
+    std::vector<BroadphaseProxy> proxies;
+    std::vector<BroadphasePair> pairs;
+    int objectCount;
+    int ghostCount;
+
+    void AddProxy(GameObject *object, Vector2 offset);
+
+public:
+    Broadphase();
+    ~Broadphase();
+
+    /**
+     * @brief Removes all the objects
+     *
+     * @param worldBox The world rectangle the objects wrap around
+     */
+    void Begin(Rectangle worldBox);
+
+    /**
+     * @brief Adds an object, and its ghosts if it crosses the world edges
+     *
+     * @param object The object
+     */
+    void Add(GameObject *object);
+
+    /**
+     * @brief Finds the overlapping pairs of the objects added since Begin.
+     * Each pair of objects is found once, in the order the objects were added
+     *
+     * @return The pairs, valid until the next call to Begin
+     */
+    const std::vector<BroadphasePair> &FindPairs();
+
+    int GetObjectCount() { return objectCount; }
+    int GetGhostCount() { return ghostCount; }
+    int GetPairCount() { return (int)pairs.size(); }
+};
+
+#endif // __BROADPHASE_H__
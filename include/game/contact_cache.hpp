@@ -0,0 +1,115 @@
+#ifndef __CONTACT_CACHE_H__
+#define __CONTACT_CACHE_H__
+
+#include "raylib.h"
+#include <stdint.h>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * @brief What is known about a pair of objects from the last time their hitboxes were tested.
+ * Axes and normals point from the object with the lowest id to the other one
+ */
+typedef struct Contact
+{
+    bool separated;         // the hitboxes did not overlap on the last test
+    Vector2 separatingAxis; // axis that separated them, tested first next time
+    Vector2 normal;         // contact normal of the last overlap
+    float depth;            // penetration depth of the last overlap
+    float normalImpulse;    // impulse the contact solver applied last frame, used to warm start it
+    int touchingFrames;     // consecutive frames the hitboxes have been overlapping
+    unsigned int lastFrame; // last frame the pair was tested
+} Contact;
+
+/**
+ * @brief Pairs of objects whose bounding boxes overlap, kept between frames so the
+ * separating axis test can start from the axis that separated them last time.
+ * Pairs are removed when their bounding boxes stop overlapping or when they are not tested for a frame
+ */
+class ContactCache
+{
+private:
+    std::unordered_map<uint64_t, Contact> contacts;
+    unsigned int frame;
+
+    // stats of the last finished frame and of the current one
+    int hits;
+    int misses;
+    int axesTested;
+    int lastHits;
+    int lastMisses;
+    int lastAxesTested;
+
+    static uint64_t GetKey(unsigned int a, unsigned int b);
+
+public:
+    ContactCache();
+    ~ContactCache();
+
+    /**
+     * @brief Starts a new frame, removing the pairs that were not tested in the last one
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Removes all the pairs
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the contact of a pair of objects, creating it if the pair is new
+     *
+     * @param a The id of one of the objects
+     * @param b The id of the other object
+     * @param created Set to true if the pair was not in the cache
+     * @return The contact, valid until the next call to this class
+     */
+    Contact *GetContact(unsigned int a, unsigned int b, bool *created);
+
+    /**
+     * @brief Removes a pair of objects, used when their bounding boxes stop overlapping
+     *
+     * @param a The id of one of the objects
+     * @param b The id of the other object
+     */
+    void Evict(unsigned int a, unsigned int b);
+
+    /**
+     * @brief Records the result of a lookup: a hit when the cached separating axis still separates the pair
+     */
+    void CountLookup(bool hit) { hit ? hits++ : misses++; }
+
+    /**
+     * @brief Records the number of axes a separating axis test projected the hitboxes onto
+     */
+    void CountAxes(int count) { axesTested += count; }
+
+    /**
+     * @brief Calls a function with every pair, the object with the lowest id first.
+     * The last frame of the contacts given is the frames since the pair was last tested
+     *
+     * @param func The function called with the ids of the objects and their contact
+     */
+    void ForEach(const std::function<void(unsigned int a, unsigned int b, Contact contact)> &func);
+
+    /**
+     * @brief Adds a pair of objects given by ForEach, used when restoring a snapshot
+     *
+     * @param a The id of the object the axes and normals of the contact point from
+     * @param b The id of the other object
+     * @param contact The contact, its last frame is the frames since the pair was last tested
+     */
+    void Add(unsigned int a, unsigned int b, Contact contact);
+
+    int GetContactCount() { return (int)contacts.size(); }
+    int GetHits() { return lastHits; }
+    int GetMisses() { return lastMisses; }
+    int GetAxesTested() { return lastAxesTested; }
+
+    /**
+     * @brief Gets the percentage of lookups of the last frame that were resolved with the cached separating axis
+     */
+    float GetHitRate();
+};
+
+#endif // __CONTACT_CACHE_H__
@@ -0,0 +1,73 @@
+#ifndef __CONTACT_SOLVER_H__
+#define __CONTACT_SOLVER_H__
+
+#include "raylib.h"
+#include <vector>
+
+#include "game/objects/game_object.hpp"
+#include "game/contact_cache.hpp"
+
+#define SOLVER_ITERATIONS 8
+#define SOLVER_RESTITUTION 0.85f          // same constant the old push response used
+#define SOLVER_RESTITUTION_THRESHOLD 20.0f // pixels per second, slower impacts do not bounce
+#define SOLVER_POSITION_SLOP 0.5f          // pixels of overlap left alone so resting contacts stay in contact
+#define SOLVER_POSITION_CORRECTION 0.8f    // fraction of the remaining overlap removed each frame
+
+/**
+ * @brief A contact between two bodies gathered for the solver
+ */
+typedef struct SolverContact
+{
+    GameObject *a;
+    GameObject *b;
+    Vector2 normal;      // from a to b
+    float depth;         // penetration depth in pixels
+    float velocityBias;  // normal velocity the bodies should separate with after the impact
+    float normalImpulse; // accumulated impulse, never negative so contacts only push
+} SolverContact;
+
+/**
+ * @brief Resolves the contacts between asteroids and enemies all at once:
+ * contacts are gathered first, then a fixed number of sequential impulse iterations are run over them
+ * and the remaining overlap is removed, so the result does not depend on the order pairs were found in.
+ * All bodies have the same mass
+ */
+class ContactSolver
+{
+private:
+    std::vector<SolverContact> contacts;
+    int lastContactCount;
+
+public:
+    ContactSolver();
+    ~ContactSolver();
+
+    /**
+     * @brief Removes all the gathered contacts
+     */
+    void Clear();
+
+    /**
+     * @brief Adds a contact between two bodies, waking them up if they were sleeping
+     *
+     * @param a One of the bodies
+     * @param b The other body
+     * @param pushVector The minimum translation vector from a to b, as given by a->CheckCollision(b)
+     * @param cache Cache with the impulse applied to the pair last frame, used to warm start the solver
+     */
+    void AddContact(GameObject *a, GameObject *b, Vector2 pushVector, ContactCache *cache);
+
+    /**
+     * @brief Solves the gathered contacts, changing the velocities and positions of the bodies, and clears them
+     *
+     * @param cache Cache where the impulse applied to each pair is stored for the next frame
+     */
+    void Solve(ContactCache *cache);
+
+    /**
+     * @brief Gets the number of contacts solved in the last call to Solve
+     */
+    int GetContactCount() { return lastContactCount; }
+};
+
+#endif // __CONTACT_SOLVER_H__
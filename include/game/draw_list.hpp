@@ -0,0 +1,108 @@
+#ifndef __DRAW_LIST_H__
+#define __DRAW_LIST_H__
+
+#include "raylib.h"
+#include <vector>
+
+#include "game/objects/game_object.hpp"
+#include "game/objects/bullet.hpp"
+
+/**
+ * @brief Layers of the world, drawn from the first to the last one
+ */
+enum DrawLayer
+{
+    DRAW_LAYER_WORLD,   // asteroids, enemies and powerups
+    DRAW_LAYER_BULLETS, // player and enemy bullets
+    DRAW_LAYER_PLAYER,  // the player and everything it draws on top of itself
+    NUM_DRAW_LAYERS
+};
+
+/**
+ * @brief A single object submitted to the draw list
+ */
+typedef struct DrawCommand
+{
+    GameObject *object;
+    DrawLayer layer;
+    int blendMode;
+    unsigned int textureId;
+    size_t order; // submission order, keeps the draw order stable inside a batch
+} DrawCommand;
+
+/**
+ * @brief Collects the objects of the world that are inside the camera view
+ * and draws them sorted by layer, blend mode and texture so consecutive draws can be batched
+ */
+class DrawList
+{
+private:
+    std::vector<DrawCommand> commands;
+    std::vector<Bullet *> bullets; // drawn together as textured quads in DRAW_LAYER_BULLETS
+    Rectangle view;                // world space rectangle seen by the camera
+    int total;
+    int culled;
+    int batches;
+
+    /**
+     * @brief Draws all the submitted bullets with one textured quad batch per bullet texture
+     */
+    void DrawBullets();
+
+public:
+    DrawList();
+    ~DrawList();
+
+    /**
+     * @brief Clears the list and computes the view rectangle of the given camera
+     *
+     * @param camera The camera the list is going to be drawn with
+     */
+    void Begin(Camera2D camera);
+
+    /**
+     * @brief Submits an object to the list if it is inside the camera view
+     *
+     * @param object The object to draw
+     * @param layer The layer to draw the object in
+     * @param cull If false, the object is always drawn (e.g. objects that draw more than their bounds)
+     * @param blendMode The blend mode to draw the object with
+     * @return true if the object was submitted, false if it was culled
+     */
+    bool Add(GameObject *object, DrawLayer layer, bool cull = true, int blendMode = BLEND_ALPHA);
+
+    /**
+     * @brief Submits a bullet to the list if it is alive and inside the camera view.
+     * Bullets are not drawn one by one, all their quads are written to the same render batch
+     *
+     * @param bullet The bullet to draw
+     * @return true if the bullet was submitted, false if it was culled
+     */
+    bool AddBullet(Bullet *bullet);
+
+    /**
+     * @brief Draws the submitted objects. Must be called inside BeginMode2D with the camera given to Begin
+     */
+    void Draw();
+
+    /**
+     * @brief Draws the debug information of the submitted objects
+     */
+    void DrawDebug();
+
+    /**
+     * @brief Checks if a world space rectangle, rotated around its center, is inside the camera view
+     *
+     * @param bounds The rectangle to check
+     * @return true if any part of the rectangle can be seen
+     */
+    bool IsVisible(Rectangle bounds);
+
+    int GetTotalCount() { return total; }
+    int GetVisibleCount() { return (int)(commands.size() + bullets.size()); }
+    int GetBulletCount() { return (int)bullets.size(); }
+    int GetCulledCount() { return culled; }
+    int GetBatchCount() { return batches; }
+};
+
+#endif // __DRAW_LIST_H__
@@ -0,0 +1,100 @@
+#ifndef __DYNAMIC_RESOLUTION_H__
+#define __DYNAMIC_RESOLUTION_H__
+
+#include "raylib.h"
+
+#include "utils/memory_stats.hpp"
+
+#define RESOLUTION_MIN_SCALE 0.5f          // of the screen size
+#define RESOLUTION_SCALE_STEP 0.125f       // scale changed at once
+#define RESOLUTION_SMOOTHING 0.1f          // weight of the last frame in the smoothed times
+#define RESOLUTION_DEFAULT_FPS 60          // frames per second aimed at when the fps are not limited
+#define RESOLUTION_MISS_FRACTION 1.1f      // of the target frame time, slower frames missed it
+#define RESOLUTION_DEGRADE_TIME 0.25f      // seconds missing the target before lowering the scale
+#define RESOLUTION_RESTORE_TIME 2.0f       // seconds meeting the target before raising the scale
+#define RESOLUTION_MAX_RESTORE_TIME 30.0f  // seconds, the restore time doubles every time a raised scale is too slow
+
+/**
+ * @brief Draws the world to a render target smaller than the screen when the gpu can't keep up,
+ * and stretches it to the screen. The UI is drawn on top at the screen resolution.
+ * raylib has no gpu timers, the gpu time is taken as the time spent in EndDrawing (swapping the buffers
+ * waits for the gpu). When the frames miss their target and most of them is spent there, the scale goes down
+ * a step, and it goes up a step after a while meeting the target. A fixed scale can be set instead
+ */
+class DynamicResolution
+{
+private:
+    RenderTexture2D target; // loaded while the scale is lower than 1
+    float scale;
+    float fixedScale;       // 0 when the scale is automatic
+    float smoothedCpuTime;  // seconds
+    float smoothedGpuTime;  // seconds
+    float targetTime;       // seconds
+    float overTime;         // seconds the frames have been missing the target
+    float underTime;        // seconds the frames have been meeting the target
+    float restoreTime;      // seconds meeting the target before raising the scale
+    bool raised;            // the scale was raised and hasn't been lowered since
+    bool drawing;           // the world is being drawn to the render target
+    int changes;
+
+    void SetScale(float scale);
+
+public:
+    DynamicResolution();
+    ~DynamicResolution();
+
+    /**
+     * @brief Adds the times of a frame of the game being played and changes the scale if needed
+     *
+     * @param cpuTime The seconds spent updating and drawing the frame
+     * @param gpuTime The seconds spent in EndDrawing, swapping the buffers and waiting for the target fps
+     * @param targetFPS The fps the game is limited to, 0 for no limit
+     * @return true if the scale changed
+     */
+    bool Update(float cpuTime, float gpuTime, int targetFPS);
+
+    /**
+     * @brief Starts drawing the world, to the render target if the scale is lower than 1.
+     * Objects must be drawn with a camera scaled by GetScale()
+     *
+     * @param background The color the render target is cleared with
+     */
+    void Begin(Color background);
+
+    /**
+     * @brief Ends drawing the world and stretches the render target to the screen, if it was used
+     */
+    void End();
+
+    /**
+     * @brief Sets a fixed scale instead of the automatic one
+     *
+     * @param scale The scale, between RESOLUTION_MIN_SCALE and 1, 0 for automatic
+     */
+    void SetFixedScale(float scale);
+    float GetFixedScale() { return fixedScale; }
+
+    /**
+     * @brief Gets the size of the render target relative to the screen
+     */
+    float GetScale() { return fixedScale > 0 ? fixedScale : scale; }
+
+    /**
+     * @brief Adds the memory of the render target to a report
+     */
+    void GetMemoryUsage(MemoryReport *report);
+
+    /**
+     * @brief Unloads the render target, it is loaded again when needed
+     */
+    void Unload();
+
+    int GetWidth() { return target.texture.width; }
+    int GetHeight() { return target.texture.height; }
+    int GetChangeCount() { return changes; }
+    float GetCpuTime() { return smoothedCpuTime; }
+    float GetGpuTime() { return smoothedGpuTime; }
+    float GetTargetTime() { return targetTime; }
+};
+
+#endif // __DYNAMIC_RESOLUTION_H__
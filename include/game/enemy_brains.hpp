@@ -0,0 +1,216 @@
+#ifndef __ENEMY_BRAINS_H__
+#define __ENEMY_BRAINS_H__
+
+#include "raylib.h"
+#include <vector>
+
+#include "utils/rng.hpp"
+
+#define BEHAVIOR_MAX_TRANSITIONS 3
+#define BEHAVIOR_AIM_THRESHOLD 3.0f // degrees, divided by the enemy precision
+#define BEHAVIOR_MAX_ELAPSED 0.5f   // seconds, longer gaps between decisions are not caught up
+
+class Enemy;
+
+/**
+ * @brief How an enemy steers every frame while it is in a behavior state
+ */
+enum BehaviorSteering
+{
+    STEER_NONE,      // keeps accelerating forward and turning as the state says
+    STEER_AIM,       // turns to face the player, by the angle measured at the last decision
+    STEER_FLOW,      // follows the flow field to the player, keeping away from the other enemies
+    STEER_DIRECTION, // accelerates along the direction picked when entering the state
+};
+
+/**
+ * @brief Turning of an enemy while it is in a behavior state
+ */
+enum BehaviorTurn
+{
+    TURN_NONE,
+    TURN_LEFT,
+    TURN_RIGHT,
+    TURN_RANDOM, // left or right, picked when entering the state
+};
+
+/**
+ * @brief What makes an enemy leave a behavior state
+ */
+enum BehaviorTrigger
+{
+    TRIGGER_NONE,
+    TRIGGER_TIMEOUT,       // the time picked when entering the state has passed
+    TRIGGER_CHANCE,        // random, param is the chances per second
+    TRIGGER_TARGET_CHANCE, // random while the player can be attacked, param is the chances per second scaled by the enemy aggressiveness
+    TRIGGER_AIMED,         // the enemy is facing the player
+};
+
+/**
+ * @brief Actions run once when an enemy enters a behavior state
+ */
+enum BehaviorAction
+{
+    ACTION_SHOOT = 1 << 0,            // shoots once
+    ACTION_RANDOM_DIRECTION = 1 << 1, // picks a random direction for STEER_DIRECTION
+};
+
+typedef struct BehaviorTransition
+{
+    BehaviorTrigger trigger;
+    float param;
+    int next; // index of the next state in the table of the enemy
+} BehaviorTransition;
+
+/**
+ * @brief A state of an enemy behavior table. The table of each enemy type is plain data,
+ * see the enemy definitions in enemy.cpp
+ */
+typedef struct BehaviorState
+{
+    const char *name;
+    bool accelerate;
+    BehaviorTurn turn;
+    BehaviorSteering steering;
+    int enterActions; // BehaviorAction flags
+    float minTime;    // seconds, the time for TRIGGER_TIMEOUT is picked between these
+    float maxTime;
+    BehaviorTransition transitions[BEHAVIOR_MAX_TRANSITIONS]; // checked in order, the first one triggered is taken
+} BehaviorState;
+
+/**
+ * @brief What the decisions of an enemy ask it to do until the next decision, read by Enemy::Update
+ */
+typedef struct EnemyControls
+{
+    bool accelerate;
+    int turn; // -1 left, 0 none, 1 right
+    BehaviorSteering steering;
+    Vector2 direction; // for STEER_DIRECTION
+    float aimAngle;    // degrees left to turn to face the player, for STEER_AIM
+    bool shoot;        // a shot was requested, cleared when the enemy shoots
+} EnemyControls;
+
+/**
+ * @brief Information about the player shared by all the decisions of a frame
+ */
+typedef struct BehaviorContext
+{
+    Vector2 target;  // player position
+    bool targetable; // the player is alive and has started playing
+} BehaviorContext;
+
+/**
+ * @brief The decision data of an enemy, saved in game snapshots
+ */
+typedef struct EnemyBrainRecord
+{
+    int state;
+    double stateEndTime;
+    double lastThinkTime;
+    float precision;
+    float aggressiveness;
+    EnemyControls controls;
+    RngState rng;
+} EnemyBrainRecord;
+
+/**
+ * @brief Runs the behavior tables of all the enemies. The decision data is kept as one array per field,
+ * indexed by the slot each enemy gets when it is created, and the due enemies are grouped by state
+ * so each state evaluates its transitions for all its enemies in one loop
+ */
+class EnemyBrains
+{
+private:
+    // one entry per enemy
+    std::vector<Enemy *> owners;
+    std::vector<const BehaviorState *> tables;
+    std::vector<int> states;
+    std::vector<double> stateEndTimes;
+    std::vector<double> lastThinkTimes;
+    std::vector<Vector2> positions;
+    std::vector<Vector2> forwards;
+    std::vector<float> precisions;
+    std::vector<float> aggressiveness;
+    std::vector<bool> alive;
+    std::vector<EnemyControls> controls;
+    std::vector<Rng> rngs; // each enemy rolls its own numbers
+
+    // scratch lists of the last Evaluate
+    std::vector<int> due;
+    std::vector<float> elapsed;
+    std::vector<int> nextStates;
+    int transitionCount;
+
+    void Enter(int slot, int state, double time, Vector2 target);
+    float GetAimAngle(int slot, Vector2 target);
+
+public:
+    EnemyBrains();
+    ~EnemyBrains();
+
+    /**
+     * @brief Adds an enemy and enters the initial state of its table
+     *
+     * @param owner The enemy, told its new slot when slots are moved. Can be null (benchmarks)
+     * @param table The behavior states of the enemy
+     * @param initialState The index of the initial state in the table
+     * @param precision How closely the enemy has to face the player to be aimed
+     * @param aggressiveness Scale of the TRIGGER_TARGET_CHANCE chances
+     * @param rng The generator of the enemy decisions
+     * @param time The game time in seconds
+     * @return The slot of the enemy
+     */
+    int Add(Enemy *owner, const BehaviorState *table, int initialState, float precision, float aggressiveness, Rng rng, double time);
+
+    /**
+     * @brief Removes an enemy, the last enemy is moved to its slot
+     *
+     * @param slot The slot of the enemy
+     */
+    void Remove(int slot);
+
+    /**
+     * @brief Removes all the enemies
+     */
+    void Clear();
+
+    /**
+     * @brief Updates the position of an enemy, done by the enemy every frame
+     */
+    void SetPose(int slot, Vector2 position, Vector2 forward, bool isAlive);
+
+    /**
+     * @brief Runs the decisions of the given enemies
+     *
+     * @param time The game time in seconds
+     * @param slots The slots of the enemies that think this frame
+     * @param context The player information
+     */
+    void Evaluate(double time, const std::vector<int> &slots, BehaviorContext context);
+
+    /**
+     * @brief Gets the decision data of an enemy, to save it
+     */
+    void GetRecord(int slot, EnemyBrainRecord *record);
+
+    /**
+     * @brief Replaces the decision data of an enemy with saved data
+     */
+    void SetRecord(int slot, EnemyBrainRecord record);
+
+    int GetCount() { return (int)owners.size(); }
+    Vector2 GetPosition(int slot) { return positions[slot]; }
+    bool IsAlive(int slot) { return alive[slot]; }
+    double GetLastThinkTime(int slot) { return lastThinkTimes[slot]; }
+    EnemyControls *GetControls(int slot) { return &controls[slot]; }
+    const char *GetStateName(int slot) { return tables[slot][states[slot]].name; }
+    int GetTransitionCount() { return transitionCount; }
+};
+
+/**
+ * @brief Gets the behavior data of the enemies of the game
+ */
+EnemyBrains *GetGameEnemyBrains();
+
+#endif // __ENEMY_BRAINS_H__
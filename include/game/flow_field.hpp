@@ -0,0 +1,102 @@
+#ifndef __FLOW_FIELD_H__
+#define __FLOW_FIELD_H__
+
+#include "raylib.h"
+#include <vector>
+
+#define FLOW_FIELD_CELL_SIZE 64          // pixels
+#define FLOW_FIELD_STRAIGHT_COST 10      // cost of moving to a side cell
+#define FLOW_FIELD_DIAGONAL_COST 14      // cost of moving to a corner cell
+#define FLOW_FIELD_OBSTACLE_COST 80      // extra cost of entering a cell covered by an asteroid
+#define FLOW_FIELD_SEPARATION_DISTANCE 80.0f // pixels, agents closer than this to the others push away from them
+
+/**
+ * @brief Cell of the flow field
+ */
+typedef struct FlowCell
+{
+    int cost;         // cost of reaching the target from this cell
+    bool obstacle;    // covered by an asteroid
+    Vector2 dir;      // unit direction to the next cell on the way to the target
+    Vector2 agentSum; // sum of the positions of the agents in this cell and the ones around it
+    int agentCount;   // number of agents in this cell and the ones around it
+} FlowCell;
+
+/**
+ * @brief Coarse grid over the world with the direction to follow from each cell to reach a target,
+ * computed once for all the agents that chase it. Cells covered by obstacles are expensive,
+ * so agents go around them, and the world wraps around so paths can cross the edges.
+ * It also bins the agents to push them away from each other, so swarms don't pile up on the same point.
+ * Sampling the direction or the separation of a position is O(1)
+ */
+class FlowField
+{
+private:
+    Rectangle worldBox;
+    Vector2 target;
+    int columns;
+    int rows;
+    int targetCell;
+    std::vector<FlowCell> cells;
+    std::vector<Vector2> agents;
+    std::vector<std::pair<int, int>> queue; // (cost, cell) heap of the cells to visit
+
+    int GetCell(Vector2 position);
+
+public:
+    FlowField();
+    ~FlowField();
+
+    /**
+     * @brief Clears the field
+     *
+     * @param worldBox The world rectangle, the field wraps around its edges
+     * @param target The position the agents go to
+     */
+    void Begin(Rectangle worldBox, Vector2 target);
+
+    /**
+     * @brief Marks the cells covered by an obstacle as expensive
+     *
+     * @param bounds The bounding box of the obstacle
+     */
+    void AddObstacle(Rectangle bounds);
+
+    /**
+     * @brief Adds an agent that is separated from the others
+     *
+     * @param position The position of the agent
+     */
+    void AddAgent(Vector2 position);
+
+    /**
+     * @brief Computes the cost and direction of every cell from the target and bins the agents
+     */
+    void Finish();
+
+    /**
+     * @brief Gets the direction to follow from a position to reach the target
+     *
+     * @param position The position
+     * @return A unit vector, straight to the target in the cell of the target
+     */
+    Vector2 GetDirection(Vector2 position);
+
+    /**
+     * @brief Gets the direction away from the agents close to a position
+     *
+     * @param position The position of an agent added to the field
+     * @return A vector up to unit length, longer the closer the other agents are, or zero if there are none
+     */
+    Vector2 GetSeparation(Vector2 position);
+
+    int GetCellCount() { return columns * rows; }
+    int GetAgentCount() { return (int)agents.size(); }
+};
+
+/**
+ * @brief Gets the flow field toward the player, rebuilt by the game every frame
+ */
+FlowField *GetGameFlowField();
+
+#endif // __FLOW_FIELD_H__
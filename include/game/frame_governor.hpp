@@ -0,0 +1,82 @@
+#ifndef __FRAME_GOVERNOR_H__
+#define __FRAME_GOVERNOR_H__
+
+#define GOVERNOR_WINDOW 30               // frames averaged
+#define GOVERNOR_TARGET_FRACTION 0.75f   // of the target frame time, the rest is left to the driver and the compositor
+#define GOVERNOR_DEFAULT_FPS 60          // frames per second aimed at when the fps are not limited
+#define GOVERNOR_DEGRADE_TIME 0.5f       // seconds over the target before shedding work
+#define GOVERNOR_RESTORE_FRACTION 0.6f   // of the target, the smoothed time has to be under it to restore work
+#define GOVERNOR_RESTORE_TIME 3.0f       // seconds under the restore time before restoring work
+#define GOVERNOR_MAX_LEVEL 3
+
+/**
+ * @brief What the game does at a level of the governor, the first level is the full game
+ */
+typedef struct GovernorSettings
+{
+    float entityBudget;    // scales the spawn chances and the max counts of asteroids and enemies
+    int soundBudget;       // sounds started per frame, -1 for no limit
+    bool explosions;       // exploding asteroids are animated instead of removed from view
+    bool objectDebug;      // hitboxes and labels of the objects in the debug overlay
+} GovernorSettings;
+
+/**
+ * @brief Keeps the frame time under a target on slow machines by shedding work.
+ * The busy time of the frames (updating and drawing, without the wait for vsync) is averaged over a window.
+ * When it stays over the target the governor goes up a level, fewer objects spawn and cosmetic work is skipped.
+ * It only goes back down after a longer time well under the target, so it doesn't flip between levels
+ */
+class FrameGovernor
+{
+private:
+    float samples[GOVERNOR_WINDOW]; // busy seconds of the last frames
+    int sampleCount;
+    int nextSample;
+    float smoothedTime; // seconds
+    float targetTime;   // seconds
+    float overTime;     // seconds the smoothed time has been over the target
+    float underTime;    // seconds the smoothed time has been under the restore time
+    int level;
+    int changes;
+    bool enabled;
+
+    void SetLevel(int level);
+
+public:
+    FrameGovernor();
+    ~FrameGovernor();
+
+    /**
+     * @brief Adds the busy time of a frame and changes the level if needed.
+     * Only frames of the game being played are given, menus and pauses don't tell how heavy the world is
+     *
+     * @param busyTime The seconds spent updating and drawing the frame
+     * @param frameTime The seconds since the last frame
+     * @param targetFPS The fps the game is limited to, 0 for no limit
+     * @return true if the level changed
+     */
+    bool Update(float busyTime, float frameTime, int targetFPS);
+
+    /**
+     * @brief Goes back to the full game and forgets the measured frames
+     */
+    void Reset();
+
+    /**
+     * @brief Turns the governor on or off, it stays at the first level while off
+     */
+    void SetEnabled(bool enabled);
+    bool IsEnabled() { return enabled; }
+
+    /**
+     * @brief Gets what the game does at the current level
+     */
+    GovernorSettings GetSettings();
+
+    int GetLevel() { return level; }
+    int GetChangeCount() { return changes; }
+    float GetSmoothedTime() { return smoothedTime; }
+    float GetTargetTime() { return targetTime; }
+};
+
+#endif // __FRAME_GOVERNOR_H__
@@ -2,7 +2,11 @@
 #define __GAME_H__
 
 #include "ui/components/common/ui_object.hpp"
-#include "game/objects/shooter.hpp"
+#include "game/draw_list.hpp"
+#include "game/world.hpp"
+#include "game/game_snapshot.hpp"
+#include "game/frame_governor.hpp"
+#include "game/dynamic_resolution.hpp"
 
 #ifdef WINDOWS_HOT_RELOAD
 #define CORE_API extern "C" __declspec(dllexport)
@@ -22,6 +26,14 @@
  */
 CORE_API bool InitGame();
 
+/**
+ * @brief Reads the command line before the game is initialized.
+ * --trace <file> captures a Chrome trace of the whole session (F8 starts and stops captures while playing),
+ * --no-governor keeps the full game on slow machines instead of shedding work
+ *
+ */
+CORE_API void ParseGameArgs(int argc, char **argv);
+
 /**
  * @brief Main game loop
  *
@@ -57,45 +69,54 @@ enum ScreenID
     NUM_SCREENS
 };
 
-enum Difficulty
+/**
+ * @brief Pages of the right side of the debug overlay, changed with F4
+ */
+enum DebugPage
 {
-    EASY,
-    MEDIUM,
-    HARD,
-    NUM_DIFFICULTIES
+    DEBUG_PAGE_COUNTERS,
+    DEBUG_PAGE_MEMORY,
+    NUM_DEBUG_PAGES
 };
 
 /**
- * @brief The game difficulty settings (number of max asteroids, enemies, spawn chances, enemies attributes, etc)
- *
+ * @brief Tracks how much the game is working, so it can be throttled when nothing is changing
+ * (paused or minimized) or when the window is not focused
  */
-typedef struct DifficultySettings
+typedef struct IdleState
 {
-    Difficulty difficulty;
-    int maxAsteroids;
-    int maxShooters;
-    int maxStalkers;
-    int maxEnemies;
-    int maxPulsers;
-    float spawnRate; // seconds
-    float powerupSpawnChance;
-    float asteroidsSpawnChance;
-    float enemiesSpawnChance;
-    float asteroidSpeedMultiplier;
-    float scoreMultiplier;
-    EnemyAttributes enemiesAttributes;
-} DifficultySettings;
+    bool waitingEvents;  // frames are only produced when an input event arrives
+    bool skipNextUpdate; // the frame time after waiting for events is not a valid simulation step
+    int targetFPS;       // the target fps currently applied, may be lower than the game fps
+    double frameStart;
+    double sampleStart;
+    double busyTime;   // seconds spent updating and drawing since sampleStart
+    float busyPercent; // percent of the last sample spent updating and drawing
+} IdleState;
 
 /**
  * @brief The game state 
- * This stores global game information such as the current screen, the player, the game objects, etc
+ * This stores global game information such as the current screen, the world being played, the UI, etc
  */
 typedef struct GameState
 {
     ScreenID currentScreen;
     ScreenID previousScreen;
-    Player *player;
-    std::vector<GameObject *> gameObjects;
+    World world;                       // the simulation shown on screen, current world of the main thread
+    DrawList drawList;                 // objects inside the camera view, rebuilt every frame
+    uint64_t fixedSeed;                // seed of the next games, 0 picks a new one for each game
+    SnapshotRing rewind;               // last snapshots of the game, only captured in debug builds
+    double lastRewindTime;             // game time of the last rewind snapshot
+    size_t snapshotSize;               // bytes of the last snapshot once written
+    double snapshotCaptureTime;        // seconds taken by the last capture
+    double snapshotRestoreTime;        // seconds taken by the last restore
+    RenderTexture2D worldCache;        // last drawn world frame, reused while the game is paused
+    bool worldCacheValid;
+    IdleState idle;
+    FrameGovernor governor;            // sheds work when the frames are too slow for the machine
+    DynamicResolution resolution;      // size the world is drawn at, lowered when the gpu can't keep up
+    DebugPage debugPage;
+    double lastMemoryCheck;            // time of the last memory budget check
     Texture2D *spaceBackground = nullptr;
     UIObject *screens[NUM_SCREENS];
     int fps;
@@ -103,13 +124,6 @@ typedef struct GameState
     bool hasEnteredGame;
     Vector2 originalWindowSize;
     Vector2 windowSize;
-    bool powerupSpawned;
-    float spawnTimer;
-    int asteroidsCount;
-    int shootersCount;
-    int stalkersCount;
-    int pulsersCount;
-    DifficultySettings diffSettings;
 } GameState;
 
 extern GameState gameState;
@@ -117,11 +131,25 @@ extern GameState gameState;
 // creates a new game with the given number of asteroids and enemies
 void CreateNewGame(size_t numAsteroids, size_t numEnemies);
 
+/**
+ * @brief Adds the memory of the resources, the world, the background and the render targets to a report
+ *
+ * @param report The report
+ */
+void GetGameMemoryUsage(MemoryReport *report);
+
 /**
  * @brief Pauses the game
  */
 void PauseGame();
 
+/**
+ * @brief Checks if the world simulation is frozen (in the pause menu or in a menu opened from it)
+ *
+ * @return true if the game objects are not being updated
+ */
+bool IsGamePaused();
+
 /**
  * @brief Resumes the game
  */
@@ -133,35 +161,51 @@ void ResumeGame();
 void RestartGame();
 
 /**
- * @brief Tries to spawn an object of the given type according to the spawn chances
- * and only if the maximum number of objects of that type hasn't been reached
+ * @brief Sets the seed of the next games, so they can be played again
  *
- * @param type The type of the object to spawn
+ * @param seed The seed, 0 picks a new seed for each game
  */
-void TryToSpawnObject(GameObjectType type);
+void SetGameSeed(uint64_t seed);
 
 /**
- * @brief Updates the difficulty settings (number of max asteroids, enemies, spawn chances, enemies attributes, etc)
- * according to the given difficulty
- *
- * @param diff The difficulty to update the settings to
+ * @brief Gets the seed of the current game
  */
-void UpdateDifficultySettings(Difficulty diff);
+uint64_t GetGameSeed();
 
+/**
+ * @brief Captures the whole simulation (world, player, objects, timers, enemy brains and random streams)
+ *
+ * @param snapshot The snapshot to capture into, cleared first
+ */
+void CaptureGame(GameSnapshot *snapshot);
 
-// --------------------------------------------------------------------------------------------- //
-// ------------------------------------ MAIN GAME FUNCTIONS ------------------------------------ //
-// --------------------------------------------------------------------------------------------- //
+/**
+ * @brief Replaces the simulation with the one captured in a snapshot
+ *
+ * @param snapshot The snapshot
+ */
+void RestoreGame(const GameSnapshot *snapshot);
 
 /**
- * @brief Checks collisions between game objects and handles them
+ * @brief Captures the game and writes it to a file
+ *
+ * @param fileName The file
+ * @return true if the file was written
  */
-void HandleCollisions();
+bool SaveGameSnapshot(const char *fileName);
 
 /**
- * @brief Updates the game objects removing the ones that are marked for deletion
+ * @brief Reads a snapshot written by SaveGameSnapshot and restores it
+ *
+ * @param fileName The file
+ * @return false if the file couldn't be read or is not a snapshot of this version, the game is not changed then
  */
-void UpdateGameObjects();
+bool LoadGameSnapshot(const char *fileName);
+
+
+// --------------------------------------------------------------------------------------------- //
+// ------------------------------------ MAIN GAME FUNCTIONS ------------------------------------ //
+// --------------------------------------------------------------------------------------------- //
 
 /**
  * @brief The main game update function
@@ -173,11 +217,50 @@ void UpdateGame();
  */
 void DrawFrame();
 
+/**
+ * @brief Draws the background and the game objects inside the camera view
+ *
+ * @param scale The size of the render target relative to the screen, the world is drawn smaller into it
+ */
+void DrawWorld(float scale = 1.0f);
+
 /**
  * @brief Draws debug information about the game and its objects
  */
 void DrawDebug();
 
+/**
+ * @brief Draws the hot path counters as a table, a page of the debug overlay
+ */
+void DrawCountersDebug(int x, int y);
+
+/**
+ * @brief Draws the memory of each category and its budget as a table, a page of the debug overlay
+ */
+void DrawMemoryDebug(int x, int y);
+
+/**
+ * @brief Gives the busy time of a frame of the game being played to the frame governor
+ * and applies its settings to the world and the sounds of the next frame
+ *
+ * @param busyTime The seconds spent updating and drawing the frame
+ */
+void UpdateFrameGovernor(double busyTime);
+
+/**
+ * @brief Gives the cpu and gpu times of a frame of the game being played to the dynamic resolution
+ *
+ * @param cpuTime The seconds spent updating and drawing the frame
+ * @param gpuTime The seconds spent in EndDrawing
+ */
+void UpdateDynamicResolution(double cpuTime, double gpuTime);
+
+/**
+ * @brief Throttles the game when there is nothing to update or draw: waits for input events
+ * while paused or minimized and lowers the frame rate while the window is not focused
+ */
+void UpdateIdleMode();
+
 // --------------------------------------------------------------------------------------------- //
 // --------------------------------------------------------------------------------------------- //
 
@@ -209,5 +292,6 @@ void ResizeCallback(Vector2 prevWindowSize);
  * @brief Changes the game FPS
  */
 void ChangeFPS(); // rotates between 15, 30, 60, 120 and unlimited in PLATFORM_DESKTOP
+void ChangeResolutionScale(); // rotates between automatic, 100%, 75% and 50% of the screen resolution
 
 #endif // __GAME_H__
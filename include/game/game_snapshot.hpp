@@ -0,0 +1,242 @@
+#ifndef __GAME_SNAPSHOT_H__
+#define __GAME_SNAPSHOT_H__
+
+#include "raylib.h"
+#include <stdint.h>
+#include <vector>
+
+#include "game/timer_wheel.hpp"
+#include "game/enemy_brains.hpp"
+#include "game/contact_cache.hpp"
+#include "utils/rng.hpp"
+#include "utils/score_registry.hpp"
+
+#define SNAPSHOT_MAGIC 0x534e4d4d // "MMNS" in the file
+#define SNAPSHOT_VERSION 3
+#define SNAPSHOT_REWIND_INTERVAL 0.5f // seconds of game time between rewind snapshots
+#define SNAPSHOT_REWIND_SLOTS 20      // rewind snapshots kept, 10 seconds back
+#define SNAPSHOT_FILE "snapshot.bin"  // file of the debug save (F6) and load (F9) keys
+
+/**
+ * @brief The state shared by all the game objects
+ */
+typedef struct ObjectRecord
+{
+    int type;   // GameObjectType
+    int kind;   // EnemyType, AsteroidVariant or PowerUpType
+    int detail; // index of the record of its type (players, enemies, asteroids, powerups), -1 if it has none
+    Rectangle bounds;
+    Vector2 origin;
+    float rotation;
+    Vector2 forwardDir;
+    Vector2 previousVelocity;
+    Vector2 velocity;
+    float previousAngularVelocity;
+    float angularVelocity;
+    float restTime;
+    bool sleeping;
+    int hitboxFirst; // in the hitbox points of the snapshot
+    int hitboxCount;
+    float timersLeft[NUM_TIMER_EVENTS]; // seconds left of the pending timers, negative if not pending
+} ObjectRecord;
+
+typedef struct BulletRecord
+{
+    ObjectRecord object;
+    bool isPlayerBullet;
+    bool isAlive;
+} BulletRecord;
+
+typedef struct CharacterRecord
+{
+    int lives;
+    int state;
+    Vector2 accelDir;
+    float lastShootTime;
+    float lastDeathTime;
+    float timeAccelerating;
+    bool exploded;
+    float maxSpeed;
+    float acceleration;
+    float deceleration;
+    float turnSpeed;
+    float shootCooldown;
+    int bulletsPerShot;
+    float bulletsSpeed;
+    float bulletsSpread;
+    float pitchAndVolumeScale;
+    int bulletFirst; // in the bullets of the snapshot
+    int bulletCount;
+} CharacterRecord;
+
+typedef struct PlayerRecord
+{
+    CharacterRecord character;
+    Vector2 initialOrigin;
+    Camera2D camera;
+    bool invincible;
+    bool hasMoved;
+    bool usingBoost;
+    float boostTime;
+    float lastBoostUsedTime;
+    bool boostRecharging;
+    float changingShipTime;
+    bool changingShip;
+    bool shipChanged;
+    bool directionalShip;
+    float directionalShipMeter;
+    bool hidden;
+    int powerupFirst; // in the objects of the snapshot, after the world objects
+    int powerupCount;
+    int powerupsCount[NUM_POWER_UP_TYPES];
+} PlayerRecord;
+
+typedef struct EnemyRecord
+{
+    CharacterRecord character;
+    float precision;
+    EnemyBrainRecord brain;
+} EnemyRecord;
+
+typedef struct AsteroidRecord
+{
+    int state;
+    float size;
+    float lastExplosionTime;
+    int sprite; // SpriteTextureID
+} AsteroidRecord;
+
+typedef struct PowerUpRecord
+{
+    bool pickedUp;
+    bool drawable;
+    bool shaking;
+    float lastShakeTime;
+    float expireTime;
+    bool expired;
+    float useEndTime;
+    bool used;
+    RngState rng;
+} PowerUpRecord;
+
+/**
+ * @brief A pair of the contact cache. Objects get new ids when restored, so the pair is saved by their records
+ */
+typedef struct ContactRecord
+{
+    int a; // in the objects of the snapshot, the axes and normals of the contact point from it
+    int b;
+    Contact contact; // lastFrame is the frames since the pair was last tested
+} ContactRecord;
+
+/**
+ * @brief The state of the world that doesn't belong to any object
+ */
+typedef struct WorldRecord
+{
+    double gameTime;
+    uint64_t seed;
+    int difficulty; // the difficulty settings are derived from it
+    float spawnTimer;
+    bool powerupSpawned;
+    int asteroidsCount;
+    int shootersCount;
+    int stalkersCount;
+    int pulsersCount;
+    int objectCount;  // world objects, the first records of the objects
+    int playerObject; // index of the player in the objects
+    int orphanFirst;  // bullets left behind by dead enemies, in the bullets of the snapshot
+    int orphanCount;
+    RngState rngs[NUM_RNG_STREAMS];
+    float scores[NUM_SCORE_TYPES];
+    float totalScore;
+} WorldRecord;
+
+/**
+ * @brief The whole simulation as plain arrays of records, written to a file with one copy per array.
+ * Objects add their records with GameObject::Capture and read them back with GameObject::Restore
+ */
+typedef struct GameSnapshot
+{
+    WorldRecord world;
+    std::vector<ObjectRecord> objects;
+    std::vector<Vector2> hitboxPoints;
+    std::vector<BulletRecord> bullets;
+    std::vector<PlayerRecord> players;
+    std::vector<EnemyRecord> enemies;
+    std::vector<AsteroidRecord> asteroids;
+    std::vector<PowerUpRecord> powerups;
+    std::vector<ContactRecord> contacts;
+} GameSnapshot;
+
+/**
+ * @brief Empties the arrays of a snapshot keeping their memory, so snapshots can be captured again without allocating
+ */
+void ClearGameSnapshot(GameSnapshot *snapshot);
+
+/**
+ * @brief Gets the size of a snapshot once written
+ *
+ * @return The size in bytes
+ */
+size_t GetGameSnapshotSize(const GameSnapshot *snapshot);
+
+/**
+ * @brief Writes a snapshot as binary data
+ *
+ * @param snapshot The snapshot
+ * @param data The buffer the snapshot is written to, replacing its contents
+ */
+void WriteGameSnapshot(const GameSnapshot *snapshot, std::vector<unsigned char> *data);
+
+/**
+ * @brief Reads a snapshot written by WriteGameSnapshot
+ *
+ * @param data The binary data
+ * @param size The size of the data in bytes
+ * @param snapshot The snapshot read
+ * @return false if the data is not a snapshot of this version or is truncated
+ */
+bool ReadGameSnapshot(const unsigned char *data, size_t size, GameSnapshot *snapshot);
+
+/**
+ * @brief Keeps the last snapshots of the game to go back in time. The snapshots are reused in a circle,
+ * so after the first round no memory is allocated
+ */
+class SnapshotRing
+{
+private:
+    std::vector<GameSnapshot> slots;
+    int head; // slot of the next snapshot
+    int count;
+
+public:
+    SnapshotRing();
+    ~SnapshotRing();
+
+    /**
+     * @brief Removes all the snapshots and sets how many are kept
+     *
+     * @param capacity The number of snapshots kept
+     */
+    void Reset(int capacity);
+
+    /**
+     * @brief Gets the slot for a new snapshot, replacing the oldest one when the ring is full
+     *
+     * @return The cleared snapshot to capture into
+     */
+    GameSnapshot *Push();
+
+    /**
+     * @brief Removes the newest snapshot
+     *
+     * @return The snapshot, valid until the next Push, or null if there are none
+     */
+    GameSnapshot *Pop();
+
+    int GetCount() { return count; }
+    int GetCapacity() { return (int)slots.size(); }
+};
+
+#endif // __GAME_SNAPSHOT_H__
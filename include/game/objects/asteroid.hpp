@@ -29,6 +29,7 @@ private:
     Sound explosionSound;    // The sound played when the asteroid explodes
     float size;              // The size of the asteroid bounds
     float lastExplosionTime; // The time when the asteroid last exploded
+    SpriteTextureID sprite;  // The sprite picked for the asteroid, its hitbox has the same shape
 
 public:
     /**
@@ -36,14 +37,14 @@ public:
      * rotation, velocity, and angular velocity for the asteroid.
      * @param variant The variant of the asteroid.
      */
-    Asteroid(float velocityMultiplier) : Asteroid((AsteroidVariant)GetRandomValue(0, 1), velocityMultiplier) {}
+    Asteroid(float velocityMultiplier) : Asteroid((AsteroidVariant)GetGameRng(RNG_ASTEROIDS)->GetInt(0, 1), velocityMultiplier) {}
     
     /**
      * @brief Constructs an Asteroid object with the given origin. This generates a random variant, size,
      * rotation, velocity, and angular velocity for the asteroid.
      * @param origin The origin position of the asteroid.
      */
-    Asteroid(Vector2 origin) : Asteroid(origin, GetRandomValue(0, 1) == 0 ? SMALL : LARGE, 1) {}
+    Asteroid(Vector2 origin) : Asteroid(origin, GetGameRng(RNG_ASTEROIDS)->GetInt(0, 1) == 0 ? SMALL : LARGE, 1) {}
 
     /**
      * @brief Constructs an Asteroid object with the given origin and velocity multiplier. This generates a random variant,
@@ -51,7 +52,7 @@ public:
      * @param origin The origin position of the asteroid.
      * @param velocityMultiplier The multiplier to apply to the velocity of the asteroid.
      */
-    Asteroid(Vector2 origin, float velocityMultiplier) : Asteroid(origin, GetRandomValue(0, 1) == 0 ? SMALL : LARGE, velocityMultiplier) {}
+    Asteroid(Vector2 origin, float velocityMultiplier) : Asteroid(origin, GetGameRng(RNG_ASTEROIDS)->GetInt(0, 1) == 0 ? SMALL : LARGE, velocityMultiplier) {}
 
     /**
      * @brief Constructs an Asteroid object with the given variant and velocity multiplier. This generates a random size,
@@ -95,6 +96,39 @@ public:
      */
     void Destroy();
 
+    /**
+     * @brief Finishes the destruction once the explosion animation is over.
+     *
+     * @param event The event of the timer that fired.
+     */
+    void OnTimer(TimerEvent event);
+
+    /**
+     * @brief Adds the asteroid to a game snapshot.
+     *
+     * @param snapshot The snapshot.
+     * @return The index of the object record.
+     */
+    int Capture(GameSnapshot *snapshot);
+
+    /**
+     * @brief Sets the asteroid to the state saved in a game snapshot.
+     *
+     * @param snapshot The snapshot.
+     * @param record The object record.
+     */
+    void Restore(const GameSnapshot *snapshot, const ObjectRecord *record);
+
+    /**
+     * @brief Asteroids fall asleep when they are floating at rest.
+     */
+    bool CanSleep() { return state == FLOATING; }
+
+    /**
+     * @brief Asteroids wrap around once they are half outside of the world.
+     */
+    float GetWrapMargin() { return size; }
+
     /**
      * @brief Handles collision with other game objects.
      *
@@ -108,7 +142,7 @@ public:
      *
      * @param velocity The velocity to set.
      */
-    void SetVelocity(Vector2 velocity) { this->velocity = velocity; }
+    void SetVelocity(Vector2 velocity) { GameObject::SetVelocity(velocity); }
 
     /**
      * @brief Sets the rotation of the asteroid.
@@ -122,7 +156,7 @@ public:
      *
      * @param angularVelocity The angular velocity to set.
      */
-    void SetAngularVelocity(float angularVelocity) { this->angularVelocity = angularVelocity; }
+    void SetAngularVelocity(float angularVelocity) { GameObject::SetAngularVelocity(angularVelocity); }
 
     /**
      * @brief Gets the velocity of the asteroid.
@@ -7,6 +7,8 @@
 #define BULLET_SPEED 250
 #define BULLET_SPREAD 10.0f // degrees
 
+struct BulletRecord;
+
 class Bullet : public GameObject
 {
 private:
@@ -35,6 +37,22 @@ public:
      */
     void Destroy() { isAlive = false; }
     bool IsOutOfBounds();
+
+    /**
+     * @brief Adds the bullet to the bullets of a game snapshot.
+     *
+     * @param snapshot The snapshot.
+     */
+    void CaptureBullet(GameSnapshot *snapshot);
+
+    /**
+     * @brief Sets the bullet to the state saved in a game snapshot.
+     *
+     * @param snapshot The snapshot.
+     * @param record The bullet record.
+     */
+    void RestoreBullet(const GameSnapshot *snapshot, const BulletRecord *record);
+
     bool IsPlayerBullet() { return isPlayerBullet; }
     bool IsAlive() { return isAlive; }
 };
@@ -20,6 +20,8 @@
 #define THRUST_MAX_PAN 0.75f // max is left channel
 #define THRUST_PITCH_DECAYING_TIME 4.0f
 
+struct CharacterRecord;
+
 // we declare the enum as a bit mask so we can combine turning states with other states
 enum CharacterState
 {
@@ -77,6 +79,16 @@ protected:
      */
     virtual void SetDefaultHitBox();
 
+    /**
+     * @brief Fills a snapshot record with the state and stats of the character, adding its bullets to the snapshot.
+     */
+    void CaptureCharacter(GameSnapshot *snapshot, CharacterRecord *record);
+
+    /**
+     * @brief Sets the state, stats and bullets of the character from a snapshot record.
+     */
+    void RestoreCharacter(const GameSnapshot *snapshot, const CharacterRecord *record);
+
 public:
     /**
      * @brief Construct a new Character object with the given origin.
@@ -100,7 +112,7 @@ public:
      */
     virtual void Draw();
     virtual void DrawDebug();
-    virtual bool CheckCollision(GameObject *other, Vector2 *pushVector);
+    virtual bool CheckCollision(GameObject *other, Vector2 *pushVector, ContactCache *cache = nullptr, Vector2 otherOffset = {0, 0});
     virtual void HandleCollision(GameObject *other, Vector2 *pushVector);
     virtual void Shoot();
     /**
@@ -112,9 +124,21 @@ public:
     virtual bool Kill();
     virtual void Respawn();
 
+    /**
+     * @brief Finishes dying once the dying animation is over.
+     *
+     * @param event The event of the timer that fired.
+     */
+    virtual void OnTimer(TimerEvent event);
+
     virtual void PauseSounds();
     virtual void ResumeSounds();
 
+    /**
+     * @brief Characters wrap around once a quarter of their size is outside of the world.
+     */
+    virtual float GetWrapMargin() { return CHARACTER_SIZE / 2; }
+
     void AddLife();
 
     /**
@@ -138,7 +162,7 @@ public:
     bool IsDying() { return state & DYING; }
     bool IsDead() { return state & DEAD; }
     bool IsAlive() { return state & ~(DEAD | DYING); }
-    bool CanShoot() { return GetTime() - lastShootTime > shootCooldown; }
+    bool CanShoot() { return GetGameTime() - lastShootTime > shootCooldown; }
     int GetLives() { return lives; }
 
     /**
@@ -148,5 +172,13 @@ public:
      * @return A pointer to the vector of bullets.
      */
     std::vector<Bullet> *GetBullets() { return &bullets; }
+
+    /**
+     * @brief Moves the live bullets of the character to the given buffer, leaving the character without bullets.
+     * This is used to free dead characters while their bullets are still flying.
+     *
+     * @param destination The buffer that takes ownership of the bullets.
+     */
+    void TransferBullets(std::vector<Bullet> *destination);
 };
 #endif // __CHARACTER_H__
\ No newline at end of file
@@ -3,9 +3,22 @@
 
 #include "game/objects/character.hpp"
 #include "game/objects/player.hpp"
+#include "game/enemy_brains.hpp"
 #include "utils/utils.hpp"
 
 #define ENEMY_SHOOT_COOLDOWN CHARACTER_SHOOT_COOLDOWN * 2.5f // seconds
+#define ENEMY_SEPARATION_WEIGHT 1.5f                         // how much flow steering keeps away from other enemies compared to chasing
+
+#define SHOOTER_ACCELERATE_MIN_TIME 1.0f // seconds
+#define SHOOTER_ACCELERATE_MAX_TIME 2.5f // seconds
+#define SHOOTER_ROTATE_MIN_TIME 0.5f     // seconds
+#define SHOOTER_ROTATE_MAX_TIME 1.5f     // seconds
+#define SHOOTER_ACCELERATE_RATE 0.6f     // chances per second of starting to accelerate
+#define SHOOTER_TURN_RATE 0.6f           // chances per second of starting to turn
+#define SHOOTER_AIM_MAX_TIME 5.0f        // seconds before giving up on aiming at the player
+#define STALKER_TURN_SPEED 90.0f         // degrees per second
+#define PULSER_SHOOT_COOLDOWN 6.0f       // seconds
+#define PULSER_CHANGE_DIR_COOLDOWN 5.0f  // seconds
 
 typedef struct EnemyAttributes
 {
@@ -25,11 +38,50 @@ enum EnemyType
     NUM_ENEMY_TYPES
 };
 
+enum ShotPattern
+{
+    SHOT_FORWARD, // bullets spread around the forward direction
+    SHOT_RADIAL,  // bullets all around the enemy, as many as the attributes say
+};
+
+/**
+ * @brief Everything that makes an enemy type different, as plain data.
+ * New enemy types only need a new definition, see the tables in enemy.cpp
+ */
+typedef struct EnemyDefinition
+{
+    EnemyType type;
+    const char *name;
+    SpriteTextureID sprite;
+    bool thrustFrames; // the sprite has a second frame shown while accelerating
+    const Vector2 *hitbox;
+    int hitboxCount;
+    float hitboxScale;
+    float turnSpeed;   // degrees per second, 0 to keep the character turn speed
+    bool silentThrust;
+    ShotPattern shot;
+    float bulletSpeedScale;
+    float shootPeriod; // seconds between periodic shots, 0 to only shoot when the behavior says
+    const BehaviorState *states;
+    int stateCount;
+    int initialState;
+} EnemyDefinition;
+
+/**
+ * @brief Gets the definition of an enemy type
+ */
+const EnemyDefinition *GetEnemyDefinition(EnemyType type);
+
+/**
+ * @brief An enemy driven by the behavior table of its definition. The decisions are made by EnemyBrains,
+ * the enemy reads them every frame to steer and shoot
+ */
 class Enemy : public Character
 {
 private:
-    EnemyType enemyType;
-       
+    const EnemyDefinition *definition;
+    int brainSlot;
+
 protected:
     Player *player;
     float precision;
@@ -37,12 +89,32 @@ protected:
 
 public:
     Enemy(Player *player, EnemyAttributes attributes, EnemyType type)
-        : Enemy(RandomVecOutsideScreen(CHARACTER_SIZE), player, attributes, type){};
-    Enemy(Vector2 origin, Player *player, EnemyAttributes attributes, EnemyType type);
+        : Enemy(RandomVecOutsideScreen(CHARACTER_SIZE, GetWorldBounds(), GetGameRng(RNG_SPAWN)), player, attributes, GetEnemyDefinition(type)){};
+    Enemy(Player *player, EnemyAttributes attributes, const EnemyDefinition *definition)
+        : Enemy(RandomVecOutsideScreen(CHARACTER_SIZE, GetWorldBounds(), GetGameRng(RNG_SPAWN)), player, attributes, definition){};
+    Enemy(Vector2 origin, Player *player, EnemyAttributes attributes, const EnemyDefinition *definition);
     ~Enemy();
 
     virtual void Update();
     virtual void DrawDebug();
+    virtual void Shoot();
+
+    /**
+     * @brief Shoots periodically if the definition says so.
+     *
+     * @param event The event of the timer that fired.
+     */
+    virtual void OnTimer(TimerEvent event);
+
+    /**
+     * @brief Adds the enemy, its bullets and its decision data to a game snapshot.
+     */
+    virtual int Capture(GameSnapshot *snapshot);
+
+    /**
+     * @brief Sets the enemy, its bullets and its decision data to the state saved in a game snapshot.
+     */
+    virtual void Restore(const GameSnapshot *snapshot, const ObjectRecord *record);
 
     virtual void HandleCollision(GameObject *other, Vector2 *pushVector);
     virtual Rectangle GetFrameRec();
@@ -50,7 +122,14 @@ public:
     bool IsLookingAtPlayer();
     bool IsLookingAt(Vector2 position);
 
-    EnemyType GetEnemyType() { return enemyType; };
+    /**
+     * @brief Called by EnemyBrains when the enemy data is moved to another slot
+     */
+    void SetBrainSlot(int slot) { brainSlot = slot; }
+    int GetBrainSlot() { return brainSlot; }
+
+    EnemyType GetEnemyType() { return definition->type; };
+    const EnemyDefinition *GetDefinition() { return definition; }
 };
 
-#endif // __ENEMY_H__
\ No newline at end of file
+#endif // __ENEMY_H__
@@ -8,6 +8,16 @@
 #include <math.h>
 
 #include "utils/resource_manager.hpp"
+#include "game/timer_wheel.hpp"
+#include "utils/rng.hpp"
+
+#define SLEEP_LINEAR_VELOCITY 5.0f  // pixels per second
+#define SLEEP_ANGULAR_VELOCITY 5.0f // degrees per second
+#define SLEEP_TIME 0.5f             // seconds
+
+class ContactCache;
+struct GameSnapshot;
+struct ObjectRecord;
 
 /**
  * @brief Enumeration of different types of game objects.
@@ -41,6 +51,44 @@ protected:
     float angularVelocity;         /**< Angular velocity of the object degrees/s */
     GameObjectType type;           /**< Type of the object */
     Texture2D *texture;            /**< Texture of the object */
+    unsigned int id;               /**< Unique id of the object in its world, used as handle by the contact cache */
+    bool sleeping;                 /**< Whether the object is at rest and skipped by update and collisions */
+    float restTime;                /**< Time the object has been moving slower than the sleep thresholds */
+    TimerHandle timers[NUM_TIMER_EVENTS]; /**< Pending timer of each event, 0 if there is none */
+
+    /**
+     * @brief Schedules a timer on the game timer wheel, replacing the pending timer of the same event if there is one.
+     * @param event The event passed to OnTimer when the timer fires.
+     * @param delay The time until the timer fires, in seconds of game time.
+     */
+    void StartTimer(TimerEvent event, float delay);
+
+    /**
+     * @brief Cancels the pending timer of an event, if there is one.
+     * @param event The event of the timer.
+     */
+    void StopTimer(TimerEvent event);
+
+    /**
+     * @brief Checks if the timer of an event has been started and has not fired yet.
+     * @param event The event of the timer.
+     * @return True if the timer is pending, false otherwise.
+     */
+    bool IsTimerPending(TimerEvent event);
+
+    /**
+     * @brief Fills a snapshot record with the state shared by all the objects, adding the hitbox points to the snapshot.
+     * @param snapshot The snapshot.
+     * @param record The record to fill.
+     */
+    void CaptureObject(GameSnapshot *snapshot, ObjectRecord *record);
+
+    /**
+     * @brief Sets the state shared by all the objects from a snapshot record, restarting the pending timers.
+     * @param snapshot The snapshot.
+     * @param record The record.
+     */
+    void RestoreObject(const GameSnapshot *snapshot, const ObjectRecord *record);
 
 public:
     /**
@@ -85,6 +133,26 @@ public:
      */
     virtual void HandleCollision(GameObject *other, Vector2 *pushVector);
 
+    /**
+     * @brief Called by the game timer wheel when a timer started with StartTimer fires.
+     * @param event The event of the timer.
+     */
+    virtual void OnTimer(TimerEvent event);
+
+    /**
+     * @brief Adds the records of the object to a game snapshot.
+     * @param snapshot The snapshot.
+     * @return The index of the object record.
+     */
+    virtual int Capture(GameSnapshot *snapshot);
+
+    /**
+     * @brief Sets the object to the state saved in a game snapshot.
+     * @param snapshot The snapshot.
+     * @param record The object record, of an object of the same type and kind.
+     */
+    virtual void Restore(const GameSnapshot *snapshot, const ObjectRecord *record);
+
     /**
      * @brief Pause any sounds associated with the game object.
      */
@@ -99,9 +167,52 @@ public:
      * @brief Check collision with another game object.
      * @param other The other game object to check collision with.
      * @param pushVector Output parameter for the push vector to resolve the collision.
+     * @param cache Optional cache with the last separating axis of the pair, updated with the result.
+     * @param otherOffset Offset added to the other object, used to test against its wrapped around copy.
      * @return True if collision occurs, false otherwise.
      */
-    bool CheckCollision(GameObject *other, Vector2 *pushVector);
+    bool CheckCollision(GameObject *other, Vector2 *pushVector, ContactCache *cache = nullptr, Vector2 otherOffset = {0, 0});
+
+    /**
+     * @brief Checks if the object can fall asleep when it is at rest, overridden by the objects that can.
+     * @return True if the object can sleep, false otherwise.
+     */
+    virtual bool CanSleep() { return false; }
+
+    /**
+     * @brief Puts the object to sleep after it has been at rest for SLEEP_TIME.
+     * @param deltaTime The time since the last call, in seconds.
+     */
+    void UpdateSleep(float deltaTime);
+
+    /**
+     * @brief Wakes the object up so it is updated and collides again.
+     */
+    void WakeUp()
+    {
+        this->sleeping = false;
+        this->restTime = 0;
+    }
+
+    /**
+     * @brief Check if the object is asleep.
+     * @return True if the object is asleep, false otherwise.
+     */
+    bool IsSleeping() { return sleeping; }
+
+    /**
+     * @brief Gets how far past the world edges the object goes before wrapping around to the other side.
+     * The object teleports when its origin is half this margin outside of the world,
+     * so its wrap period is the world size plus this margin.
+     * @return The margin in pixels, 0 if the object does not wrap around.
+     */
+    virtual float GetWrapMargin() { return 0; }
+
+    /**
+     * @brief Teleports the object to the other side of the world if it went off the edges.
+     * @param worldBox The world rectangle.
+     */
+    void WrapAround(Rectangle worldBox);
 
     /**
      * @brief Push the other game object in direction of the push vector.
@@ -168,7 +279,7 @@ public:
      * @brief Get the hitbox points of the game object.
      * @return The hitbox points.
      */
-    std::vector<Vector2> GetHitbox() { return hitbox; }
+    const std::vector<Vector2> &GetHitbox() { return hitbox; }
 
     /**
      * @brief Get the type of the game object.
@@ -176,6 +287,18 @@ public:
      */
     GameObjectType GetType() { return type; }
 
+    /**
+     * @brief Get the unique id of the game object.
+     * @return The id.
+     */
+    unsigned int GetId() { return id; }
+
+    /**
+     * @brief Get the texture of the game object.
+     * @return The texture.
+     */
+    Texture2D *GetTexture() { return texture; }
+
     /**
      * @brief Set the bounding rectangle of the game object.
      * @param bounds The bounding rectangle to set.
@@ -198,13 +321,21 @@ public:
      * @brief Set the velocity of the game object.
      * @param velocity The velocity to set.
      */
-    void SetVelocity(Vector2 velocity) { this->velocity = velocity; }
+    void SetVelocity(Vector2 velocity)
+    {
+        this->velocity = velocity;
+        WakeUp();
+    }
 
     /**
      * @brief Set the angular velocity of the game object.
      * @param angularVelocity The angular velocity to set.
      */
-    void SetAngularVelocity(float angularVelocity) { this->angularVelocity = angularVelocity; }
+    void SetAngularVelocity(float angularVelocity)
+    {
+        this->angularVelocity = angularVelocity;
+        WakeUp();
+    }
 
     /**
      * @brief Set the forward direction of the game object.
@@ -219,4 +350,21 @@ public:
     void SetHitbox(std::vector<Vector2> hitbox) { this->hitbox = hitbox; }
 };
 
+/**
+ * @brief Gets the id of a new object from the world it is created in, so the same seed gives the same ids
+ * (the contact cache is keyed by them). Objects created outside of any world number on their own
+ */
+unsigned int NewObjectId();
+
+/**
+ * @brief Gets the seconds simulated by the current step of the world. Unlike GetFrameTime
+ * it is set by the world, so worlds without a window can be stepped at any rate
+ */
+float GetWorldFrameTime();
+
+/**
+ * @brief Gets the edges of the world the objects wrap around, centered on the origin
+ */
+Rectangle GetWorldBounds();
+
 #endif // __GAME_OBJECT_H__
\ No newline at end of file
@@ -19,6 +19,20 @@
 #define BOOST_BAR_FADE_TIME 0.5f                             // seconds
 #define MAX_UPGRADES_PER_TYPE 5
 
+/**
+ * @brief What the player does in a step, read from the keyboard and mouse or given by whatever drives the world
+ */
+typedef struct PlayerInput
+{
+    bool accelerate;   // for the ship
+    int turn;          // -1 left, 0 none, 1 right, for the ship
+    Vector2 moveDir;   // -1 to 1 on each axis, for the directional ship
+    Vector2 aimTarget; // world position the directional ship faces
+    bool boost;
+    bool shoot;
+    bool toggleShip; // changes between the ship and the directional ship, once per request
+} PlayerInput;
+
 class Player : public Character
 {
 private:
@@ -39,9 +53,11 @@ private:
     bool usingBoost;
     float boostTime;
     float lastBoostUsedTime;
+    bool boostRecharging; // set by the recharge timer, BOOST_RECHARGE_COOLDOWN after the boost stops being used
 
     float changingShipTime;
     bool changingShip; // changing from ship to directional ship or vice versa
+    bool shipChanged;  // the ship has been swapped halfway through the change
     bool directionalShip;
     float directionalShipMeter;
 
@@ -64,6 +80,9 @@ private:
     Sound *changeToDirShipSound;
     Sound *changeToShipSound;
 
+    PlayerInput input;
+    bool externalInput; // the input is given with SetInput instead of read from the keyboard and mouse
+
 protected:
     /**
      * @brief Sets the default hitbox for the player.
@@ -87,7 +106,18 @@ public:
     void Draw();
     void DrawDebug();
     void HandleInput();
-    bool CheckCollision(GameObject *other, Vector2 *pushVector);
+
+    /**
+     * @brief Reads the keyboard and mouse as player input.
+     */
+    PlayerInput ReadInput();
+
+    /**
+     * @brief Drives the player with the given input from now on instead of the keyboard and mouse.
+     * The input is kept for the next steps until it is set again.
+     */
+    void SetInput(PlayerInput input);
+    bool CheckCollision(GameObject *other, Vector2 *pushVector, ContactCache *cache = nullptr, Vector2 otherOffset = {0, 0});
     void HandleCollision(GameObject *other, Vector2 *pushVector);
     void HandleBulletCollision(Bullet *bullet, GameObject *other, Vector2 *pushVector);
 
@@ -117,11 +147,30 @@ public:
      * @brief Resets player state to initial state.
      */
     void Respawn();
+    /**
+     * @brief Finishes dying, respawns the player and starts recharging the boost when their timers fire.
+     *
+     * @param event The event of the timer that fired.
+     */
+    void OnTimer(TimerEvent event);
     /**
      * @brief Completely resets the player with its lives, powerups, bullets, and state.
      */
     void Reset();
 
+    /**
+     * @brief Adds the player, its bullets and the powerups it carries to a game snapshot.
+     *
+     * @return The index of the object record.
+     */
+    int Capture(GameSnapshot *snapshot);
+
+    /**
+     * @brief Sets the player, its bullets and the powerups it carries to the state saved in a game snapshot.
+     * The player should be Reset first so it doesn't keep its current powerups.
+     */
+    void Restore(const GameSnapshot *snapshot, const ObjectRecord *record);
+
     void Show() { hidden = false; }
     void Hide() { hidden = true; }
 
@@ -154,6 +203,8 @@ public:
      */
     size_t GetPowerupCount(PowerUpType type) { return powerupsCount[type]; }
     float GetDirectionalShipMeter() { return directionalShipMeter; }  
+    bool IsDirectionalShip() { return directionalShip; }
+    float GetBoostTime() { return boostTime; }
 };
 
 #endif // __PLAYER_H__
\ No newline at end of file
@@ -41,19 +41,22 @@ private:
 
     // used when the powerup is not collected by the player
     bool shaking;
-    float shakingTime;
     float lastShakeTime;
+    Rng rng; // shake jitter
 
     /**
-     * @brief Time to live of the powerup.
-     * When this reaches 0, the powerup is destroyed.
+     * @brief Game time when the powerup expires if it is not picked up.
+     * The expiry timer sets expired and the powerup is destroyed.
      */
-    float timeToLive;
+    float expireTime;
+    bool expired;
 
     /**
-     * @brief Time the powerup can be used by the player.
+     * @brief Game time when the player stops being able to use the powerup, INFINITY for permanent powerups.
+     * The use timer sets used when it is reached.
      */
-    float effectiveUseTime;
+    float useEndTime;
+    bool used;
 
     Sound *spawnSound;
     Sound *pickupSound;
@@ -64,21 +67,22 @@ public:
      * @brief Construct a new PowerUp object with a random type. The origin is randomly generated inside the screen.
      *
      */
-    PowerUp() : PowerUp(RandomVecInsideScreen(POWER_UP_SIZE), (PowerUpType)GetRandomValue(0, NUM_POWER_UP_TYPES - 1)) {}
+    PowerUp() : PowerUp(RandomVecInsideScreen(POWER_UP_SIZE, GetWorldBounds(), GetGameRng(RNG_SPAWN)), (PowerUpType)GetGameRng(RNG_POWER_UPS)->GetInt(0, NUM_POWER_UP_TYPES - 1)) {}
 
     /**
      * @brief Construct a new PowerUp object. The origin is randomly generated inside the screen.
      *
      */
-    PowerUp(PowerUpType type) : PowerUp(RandomVecInsideScreen(POWER_UP_SIZE), type) {}
+    PowerUp(PowerUpType type) : PowerUp(RandomVecInsideScreen(POWER_UP_SIZE, GetWorldBounds(), GetGameRng(RNG_SPAWN)), type) {}
 
     /**
      * @brief Construct a new PowerUp object.
      *
      * @param origin The origin of the powerup.
      * @param type The type of the powerup.
+     * @param restored If it is created from a snapshot, the spawn sound is not played then.
      */
-    PowerUp(Vector2 origin, PowerUpType type);
+    PowerUp(Vector2 origin, PowerUpType type, bool restored = false);
     virtual ~PowerUp();
 
     virtual void Update();
@@ -111,12 +115,35 @@ public:
      */
     void ResetUseTime();
 
+    /**
+     * @brief Expires the powerup, stops shaking and ends its use when their timers fire.
+     *
+     * @param event The event of the timer that fired.
+     */
+    void OnTimer(TimerEvent event);
+
+    /**
+     * @brief Adds the powerup to a game snapshot.
+     *
+     * @param snapshot The snapshot.
+     * @return The index of the object record.
+     */
+    int Capture(GameSnapshot *snapshot);
+
+    /**
+     * @brief Sets the powerup to the state saved in a game snapshot.
+     *
+     * @param snapshot The snapshot.
+     * @param record The object record.
+     */
+    void Restore(const GameSnapshot *snapshot, const ObjectRecord *record);
+
     PowerUpType GetType() { return powerupType; }
-    float GetTimeToLive() { return timeToLive; }
-    float GetEffectiveUseTime() { return effectiveUseTime; }
+    float GetTimeToLive() { return pickedUp || expired ? 0.0f : fmaxf(expireTime - GetGameTime(), 0.0f); }
+    float GetEffectiveUseTime() { return pickedUp && !used ? fmaxf(useEndTime - GetGameTime(), 0.0f) : 0.0f; }
     bool IsPickedUp() { return pickedUp; }
-    bool IsExpired() { return timeToLive <= 0.0f && !pickedUp; }
-    bool CanBeApplied() { return effectiveUseTime > 0.0f; }
+    bool IsExpired() { return expired && !pickedUp; }
+    bool CanBeApplied() { return pickedUp && !used; }
 
     /**
      * @brief Gets the name of the powerup.
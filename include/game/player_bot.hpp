@@ -0,0 +1,51 @@
+#ifndef __PLAYER_BOT_H__
+#define __PLAYER_BOT_H__
+
+#include "raylib.h"
+#include <stdint.h>
+
+#include "game/objects/player.hpp"
+#include "utils/rng.hpp"
+
+class World;
+
+#define BOT_REACTION_TIME 0.15f  // seconds between decisions, the input is held in between
+#define BOT_LOOKAHEAD_TIME 0.6f  // seconds the threats are extrapolated to see if they come close
+#define BOT_DANGER_DISTANCE 70.0f // pixels between the edges of the player and a threat that make it dodge
+#define BOT_CHASE_DISTANCE 350.0f // pixels, targets farther than this are approached
+#define BOT_POWER_UP_DISTANCE 300.0f // pixels, power ups closer than this are picked up when nothing threatens
+#define BOT_AIM_TOLERANCE 6.0f   // degrees off the target the bot still shoots
+#define BOT_AIM_ERROR 4.0f       // degrees, the aim of every decision is off by up to this
+
+/**
+ * @brief A scripted player for headless games: it dodges what is about to hit it, otherwise picks up close power ups
+ * or turns to the closest enemy (or asteroid) leading its shots. It only uses the ship, never the directional ship.
+ * Its aim is slightly off by a random amount, so its games vary like a person's would
+ */
+class PlayerBot
+{
+private:
+    Rng rng;
+    double nextDecisionTime;
+    PlayerInput input;
+
+public:
+    PlayerBot();
+    ~PlayerBot();
+
+    /**
+     * @brief Prepares the bot for a new game
+     *
+     * @param seed The seed of the random aim errors
+     */
+    void Reset(uint64_t seed);
+
+    /**
+     * @brief Decides what the player of a world does in this step
+     *
+     * @return The input for Player::SetInput
+     */
+    PlayerInput Think(World *world);
+};
+
+#endif // __PLAYER_BOT_H__
@@ -0,0 +1,86 @@
+#ifndef __POINT_GRID_H__
+#define __POINT_GRID_H__
+
+#include "raylib.h"
+#include <vector>
+
+#include "utils/simd.hpp"
+
+/**
+ * @brief A uniform grid of points (e.g. bullets) rebuilt every frame.
+ * Points are sorted by cell, row by row, and stored as separate x and y arrays,
+ * so the points of the cells covered by a rectangle in the same row are contiguous
+ * and can be tested by the SIMD kernels without gathering them first
+ */
+class PointGrid
+{
+private:
+    Rectangle area;
+    float cellSize;
+    int columns;
+    int rows;
+
+    std::vector<Vector2> pending; // points added since Begin
+    std::vector<int> pendingIds;
+    std::vector<int> pendingCells;
+
+    std::vector<int> cellStart; // index of the first point of each cell, one extra for the end
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<int> ids;
+    std::vector<unsigned char> inside; // scratch buffer for the query results
+
+    int tested; // points tested against polygons since Begin
+
+    int GetCell(Vector2 point);
+
+public:
+    PointGrid();
+    ~PointGrid();
+
+    /**
+     * @brief Clears the grid
+     *
+     * @param area The area covered by the grid, points outside of it are stored in the border cells
+     * @param cellSize The size of the cells
+     */
+    void Begin(Rectangle area, float cellSize);
+
+    /**
+     * @brief Adds a point to the grid
+     *
+     * @param point The point
+     * @param id The id returned by the queries for this point (e.g. the bullet index)
+     */
+    void Add(Vector2 point, int id);
+
+    /**
+     * @brief Sorts the points added since Begin by cell. Must be called before querying the grid
+     */
+    void Finish();
+
+    /**
+     * @brief Finds the points inside a convex polygon
+     *
+     * @param bounds The bounding rectangle of the polygon, only the points of the cells it covers are tested
+     * @param planes The half-planes of the polygon, see MakeConvexHalfPlanes
+     * @param planeCount The number of half-planes
+     * @param hits Where to append the ids of the points inside the polygon
+     */
+    void QueryConvex(Rectangle bounds, const HalfPlane *planes, size_t planeCount, std::vector<int> *hits);
+
+    /**
+     * @brief Finds the points inside any polygon (slower path for non convex polygons)
+     *
+     * @param bounds The bounding rectangle of the polygon, only the points of the cells it covers are tested
+     * @param polygon The vertices of the polygon
+     * @param count The number of vertices
+     * @param hits Where to append the ids of the points inside the polygon
+     */
+    void QueryPolygon(Rectangle bounds, const Vector2 *polygon, size_t count, std::vector<int> *hits);
+
+    int GetPointCount() { return (int)ids.size(); }
+    int GetTestedCount() { return tested; }
+};
+
+#endif // __POINT_GRID_H__
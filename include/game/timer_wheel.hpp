@@ -0,0 +1,153 @@
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <stdint.h>
+#include <vector>
+
+#define TIMER_WHEEL_TICK 0.01 // seconds
+#define TIMER_WHEEL_LEVELS 3
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS) // per level, the last level covers ~45 minutes
+
+class GameObject;
+
+/**
+ * @brief Events the game objects schedule, passed back to GameObject::OnTimer when they fire
+ */
+enum TimerEvent
+{
+    TIMER_ASTEROID_DESTROYED,     // explosion animation finished
+    TIMER_CHARACTER_DEAD,         // dying animation finished
+    TIMER_PLAYER_RESPAWN,         // respawn after dying
+    TIMER_PLAYER_BOOST_RECHARGE,  // boost starts recharging
+    TIMER_ENEMY_SHOOT,            // enemies with a shoot period shoot periodically
+    TIMER_POWER_UP_EXPIRED,       // powerup was not picked up in time
+    TIMER_POWER_UP_SHAKE_END,     // powerup stops shaking
+    TIMER_POWER_UP_USE_END,       // picked up powerup effect ends
+    NUM_TIMER_EVENTS
+};
+
+/**
+ * @brief Handle of a scheduled timer, 0 is never a valid handle.
+ * Handles of fired or cancelled timers are never valid again, even if their slot is reused
+ */
+typedef uint32_t TimerHandle;
+
+/**
+ * @brief A pending timer
+ */
+typedef struct TimerEntry
+{
+    GameObject *owner;
+    TimerEvent event;
+    uint64_t dueTick;
+    uint16_t generation; // incremented when the entry is freed, invalidates old handles
+    bool active;
+    int level; // slot the entry is linked in, -1 if it is not linked (being fired)
+    int slot;
+    int previous; // entries of the same slot form a doubly linked list, -1 at the ends
+    int next;
+} TimerEntry;
+
+/**
+ * @brief A timer detached from its slot to be fired, with the generation it had then.
+ * If the entry was cancelled and reused by a callback of the same slot, the generations don't match
+ */
+typedef struct FiringTimer
+{
+    int index;
+    uint16_t generation;
+} FiringTimer;
+
+/**
+ * @brief Hierarchical timer wheel: each level has TIMER_WHEEL_SLOTS slots, the first one a tick each
+ * and every next level TIMER_WHEEL_SLOTS times longer. Timers are moved down a level when their slot comes up,
+ * so advancing the wheel only costs the timers that fire or move, not the timers waiting.
+ * Scheduling and cancelling are O(1)
+ */
+class TimerWheel
+{
+private:
+    std::vector<TimerEntry> entries;
+    std::vector<int> freeEntries;
+    int slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS]; // first entry of each slot, -1 if empty
+    uint64_t currentTick;
+    int activeCount;
+    int firedCount; // timers fired in the last call to Advance
+
+    std::vector<FiringTimer> firing; // scratch list of the entries of the slot being fired
+
+    void Link(int index);
+    void Unlink(int index);
+    void Free(int index);
+    void Cascade(int level);
+    int GetIndex(TimerHandle handle);
+
+public:
+    TimerWheel();
+    ~TimerWheel();
+
+    /**
+     * @brief Cancels all the timers and restarts the wheel at the given time
+     *
+     * @param time The current time in seconds
+     */
+    void Reset(double time);
+
+    /**
+     * @brief Schedules a timer, fired at least one tick later
+     *
+     * @param owner The object GameObject::OnTimer is called on
+     * @param event The event passed to GameObject::OnTimer
+     * @param delay The time until the timer fires, in seconds
+     * @return The handle of the timer
+     */
+    TimerHandle Schedule(GameObject *owner, TimerEvent event, float delay);
+
+    /**
+     * @brief Cancels a timer. Does nothing if it already fired or was cancelled
+     *
+     * @param handle The handle of the timer
+     */
+    void Cancel(TimerHandle handle);
+
+    /**
+     * @brief Checks if a timer has not fired nor been cancelled yet
+     *
+     * @param handle The handle of the timer
+     */
+    bool IsPending(TimerHandle handle);
+
+    /**
+     * @brief Gets the time until a timer fires
+     *
+     * @param handle The handle of the timer
+     * @return The time in seconds, rounded to ticks, or a negative value if the timer is not pending
+     */
+    float GetTimeLeft(TimerHandle handle);
+
+    /**
+     * @brief Fires all the timers due up to the given time, in order
+     *
+     * @param time The current time in seconds
+     */
+    void Advance(double time);
+
+    int GetActiveCount() { return activeCount; }
+    int GetFiredCount() { return firedCount; }
+};
+
+/**
+ * @brief Gets the game clock, the time the world simulation has been running for.
+ * Unlike GetTime it stops while the game is paused
+ *
+ * @return The game time in seconds
+ */
+double GetGameTime();
+
+/**
+ * @brief Gets the timer wheel of the game, advanced with the game clock
+ */
+TimerWheel *GetGameTimers();
+
+#endif // __TIMER_WHEEL_H__
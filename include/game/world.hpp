@@ -0,0 +1,207 @@
+#ifndef __WORLD_H__
+#define __WORLD_H__
+
+#include "raylib.h"
+#include <stdint.h>
+#include <vector>
+
+#include "game/objects/player.hpp"
+#include "game/objects/enemy.hpp"
+#include "game/point_grid.hpp"
+#include "game/contact_cache.hpp"
+#include "game/contact_solver.hpp"
+#include "game/broadphase.hpp"
+#include "game/timer_wheel.hpp"
+#include "game/enemy_brains.hpp"
+#include "game/ai_scheduler.hpp"
+#include "game/flow_field.hpp"
+#include "game/game_snapshot.hpp"
+#include "utils/rng.hpp"
+#include "utils/score_registry.hpp"
+#include "utils/memory_stats.hpp"
+
+#define WORLD_DEFAULT_WIDTH 1280  // pixels, used until the world is given the window size
+#define WORLD_DEFAULT_HEIGHT 720  // pixels
+#define BULLET_GRID_CELL_SIZE 128 // pixels
+#define MAX_HULL_PLANES 16
+#define INITIAL_ASTEROIDS 5 // objects of a new game
+#define INITIAL_ENEMIES 1
+
+enum Difficulty
+{
+    EASY,
+    MEDIUM,
+    HARD,
+    NUM_DIFFICULTIES
+};
+
+/**
+ * @brief The game difficulty settings (number of max asteroids, enemies, spawn chances, enemies attributes, etc)
+ *
+ */
+typedef struct DifficultySettings
+{
+    Difficulty difficulty;
+    int maxAsteroids;
+    int maxShooters;
+    int maxStalkers;
+    int maxEnemies;
+    int maxPulsers;
+    float spawnRate; // seconds
+    float powerupSpawnChance;
+    float asteroidsSpawnChance;
+    float enemiesSpawnChance;
+    float asteroidSpeedMultiplier;
+    float scoreMultiplier;
+    EnemyAttributes enemiesAttributes;
+} DifficultySettings;
+
+/**
+ * @brief One running simulation: the player, the objects and everything they share (clock, timers,
+ * random streams, scores, enemy brains, collision caches). Worlds don't share any state, so several
+ * of them can be stepped at the same time in different threads, each thread making its world current.
+ * Textures and sounds are shared and only read
+ */
+class World
+{
+public:
+    Player *player;
+    std::vector<GameObject *> gameObjects;
+    std::vector<Bullet> orphanBullets; // bullets left behind by dead enemies, owned by the world
+    Rectangle bounds;                  // the objects wrap around its edges, centered on the origin
+    double gameTime;                   // seconds the world has been simulated for
+    float frameTime;                   // seconds simulated by the current step
+    uint64_t seed;                     // the same seed plays the same game
+    unsigned int nextObjectId;         // id given to the next object created in the world
+    Rng rngs[NUM_RNG_STREAMS];         // random streams of the subsystems, seeded from the seed
+    ScoreRegistry scores;
+    TimerWheel timers;                 // cooldowns, expiries and respawns of the objects, on the world clock
+    EnemyBrains enemyBrains;           // behavior states of the enemies, evaluated in batches
+    AIScheduler aiScheduler;           // enemy decisions, spread over the frames
+    FlowField flowField;               // directions to the player around the asteroids, rebuilt every step
+    PointGrid bulletGrid;              // player bullets binned by position, rebuilt every step
+    int bulletPairs;                   // bullet/hull pairs a brute force check would test
+    ContactCache contactCache;         // separating axes and contacts of the object pairs, kept between steps
+    ContactSolver contactSolver;       // contacts between asteroids and enemies, solved together every step
+    Broadphase broadphase;             // pairs of objects close to each other, rebuilt every step
+    bool powerupSpawned;
+    float spawnTimer;
+    int asteroidsCount;
+    int shootersCount;
+    int stalkersCount;
+    int pulsersCount;
+    DifficultySettings diffSettings;
+    float entityBudget;                // 0 to 1, scales the spawn chances and max counts, lowered by the frame governor
+
+    World();
+    ~World();
+
+    // the world owns its objects, a copy would delete them twice
+    World(const World &) = delete;
+    World &operator=(const World &) = delete;
+
+    /**
+     * @brief Starts a new game, replacing the objects of the previous one. The player is kept
+     *
+     * @param numAsteroids The asteroids at the start
+     * @param numEnemies The shooters at the start
+     * @param seed The seed of the game
+     */
+    void Create(size_t numAsteroids, size_t numEnemies, uint64_t seed);
+
+    /**
+     * @brief Advances the simulation
+     *
+     * @param frameTime The seconds simulated
+     * @param updatePlayer If the player is updated (the game is being played or is over)
+     * @param spawn If new objects are spawned and the score and difficulty increase (the game is being played)
+     */
+    void Step(float frameTime, bool updatePlayer, bool spawn);
+
+    /**
+     * @brief Checks if the game is over, the player died with no lives left
+     */
+    bool IsOver() { return player->IsDead() && player->GetLives() <= 0; }
+
+    /**
+     * @brief Updates the difficulty settings (number of max asteroids, enemies, spawn chances, enemies attributes, etc)
+     * according to the given difficulty
+     *
+     * @param diff The difficulty to update the settings to
+     */
+    void UpdateDifficultySettings(Difficulty diff);
+
+    /**
+     * @brief Gets a max count of the difficulty settings scaled by the entity budget, at least 1 if it wasn't 0
+     *
+     * @param maxCount The max count of the difficulty settings
+     */
+    int GetBudgetedMax(int maxCount);
+
+    /**
+     * @brief Tries to spawn an object of the given type according to the spawn chances
+     * and only if the maximum number of objects of that type hasn't been reached.
+     * The chances and maximums of the asteroids and enemies are scaled by the entity budget
+     *
+     * @param type The type of the object to spawn
+     */
+    void TryToSpawnObject(GameObjectType type);
+
+    /**
+     * @brief Captures the whole simulation (objects, timers, enemy brains, random streams and scores)
+     *
+     * @param snapshot The snapshot to capture into, cleared first
+     */
+    void Capture(GameSnapshot *snapshot);
+
+    /**
+     * @brief Replaces the simulation with the one captured in a snapshot
+     */
+    void Restore(const GameSnapshot *snapshot);
+
+    /**
+     * @brief Deletes the player and all the objects
+     */
+    void Clear();
+
+    /**
+     * @brief Adds the memory of the objects and bullets of the world to a report
+     *
+     * @param report The report
+     */
+    void GetMemoryUsage(MemoryReport *report);
+
+private:
+    void DeleteObjects();
+    void UpdateObjects(bool updatePlayer);
+    void HandleCollisions();
+};
+
+/**
+ * @brief Gets the world of the calling thread, the one the game objects use
+ */
+World *GetCurrentWorld();
+
+/**
+ * @brief Sets the world of the calling thread
+ */
+void SetCurrentWorld(World *world);
+
+/**
+ * @brief Makes a world current until the end of the scope, then restores the previous one
+ */
+class WorldScope
+{
+private:
+    World *previous;
+
+public:
+    WorldScope(World *world)
+    {
+        this->previous = GetCurrentWorld();
+        SetCurrentWorld(world);
+    }
+    ~WorldScope() { SetCurrentWorld(previous); }
+};
+
+#endif // __WORLD_H__
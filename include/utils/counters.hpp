@@ -0,0 +1,54 @@
+#ifndef __COUNTERS_H__
+#define __COUNTERS_H__
+
+#include <stdint.h>
+
+/**
+ * @brief The counters of the hot paths. A counter is added here and named in counters.cpp,
+ * there is nothing to register at runtime
+ */
+enum CounterID
+{
+    COUNTER_COLLISION_PAIRS, // pairs of objects close to each other found by the broadphase
+    COUNTER_AABB_REJECTS,    // pairs whose bounding boxes don't overlap
+    COUNTER_SAT_TESTS,       // pairs tested with the separating axis theorem
+    COUNTER_COLLISION_HITS,  // pairs that collided
+    COUNTER_BULLET_TESTS,    // player bullets tested against hulls
+    COUNTER_DRAW_BATCHES,    // texture or blend mode changes of the draw list, each one is a draw call
+    COUNTER_SPRITES,         // objects and bullets drawn
+    COUNTER_SPAWN_ROLLS,
+    COUNTER_SPAWNS,
+    COUNTER_SOUNDS_PLAYED,   // sounds started by the objects
+    COUNTER_SOUNDS_SKIPPED,  // sounds over the budget of the frame governor
+    COUNTER_REMOVALS,        // objects removed from the world
+    COUNTER_ALLOCATIONS,     // heap allocations, only counted by the game executable (see main.cpp)
+    NUM_COUNTERS
+};
+
+/**
+ * @brief Adds to a counter. Each thread adds to its own copy of the counters, without locks or shared cache lines
+ *
+ * @param id The counter
+ * @param amount What is added
+ */
+void AddCounter(CounterID id, uint64_t amount = 1);
+
+const char *GetCounterName(CounterID id);
+
+/**
+ * @brief Gets everything added to a counter by all the threads since the process started
+ */
+uint64_t GetCounterTotal(CounterID id);
+
+/**
+ * @brief Closes the frame of the counters, called once per frame by the main thread.
+ * The values of the frame are also recorded by the flight recorder
+ */
+void EndCountersFrame();
+
+/**
+ * @brief Gets what was added to a counter during the last closed frame
+ */
+uint64_t GetCounterFrameValue(CounterID id);
+
+#endif // __COUNTERS_H__
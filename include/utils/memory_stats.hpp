@@ -0,0 +1,90 @@
+#ifndef __MEMORY_STATS_H__
+#define __MEMORY_STATS_H__
+
+#include "raylib.h"
+#include <stddef.h>
+
+#define MEMORY_MB (1024 * 1024) // bytes
+#define SOUND_ALIAS_BYTES 1024 // approximate, the audio buffer raylib allocates for an alias, the samples are shared
+
+/**
+ * @brief What the memory of the game is used for
+ */
+enum MemoryCategory
+{
+    MEMORY_TEXTURES,       // sprite and ui textures
+    MEMORY_BACKGROUND,     // the stars background of the current game
+    MEMORY_RENDER_TARGETS, // the world cache drawn behind the menus and the scaled world
+    MEMORY_SOUNDS,         // decoded samples of the sounds
+    MEMORY_SOUND_ALIASES,  // one per sound of each character and asteroid alive
+    MEMORY_FONT,           // glyph atlas and glyph images
+    MEMORY_ENTITIES,       // the player, asteroids, enemies and power ups, with their hitboxes
+    MEMORY_BULLETS,        // the bullet vectors of the characters and the world
+    NUM_MEMORY_CATEGORIES
+};
+
+typedef struct MemoryUsage
+{
+    size_t cpu; // bytes
+    size_t gpu; // bytes
+} MemoryUsage;
+
+/**
+ * @brief Bytes of every category, filled by whoever owns the memory
+ */
+typedef struct MemoryReport
+{
+    MemoryUsage categories[NUM_MEMORY_CATEGORIES];
+} MemoryReport;
+
+const char *GetMemoryCategoryName(MemoryCategory category);
+
+/**
+ * @brief Adds bytes to a category of a report
+ */
+void AddMemoryUsage(MemoryReport *report, MemoryCategory category, size_t cpu, size_t gpu);
+
+/**
+ * @brief Gets the cpu and gpu bytes of all the categories of a report
+ */
+MemoryUsage GetTotalMemoryUsage(const MemoryReport *report);
+
+/**
+ * @brief Gets the gpu bytes of a texture, with its mipmaps
+ */
+size_t GetTextureBytes(Texture2D texture);
+
+/**
+ * @brief Gets the bytes of the decoded samples of a sound
+ */
+size_t GetSoundBytes(Sound sound);
+
+/**
+ * @brief Sets the limit of a category, the defaults keep the web build well inside its 128 MB heap
+ *
+ * @param category The category
+ * @param budget The cpu and gpu bytes allowed, 0 for no limit
+ */
+void SetMemoryBudget(MemoryCategory category, MemoryUsage budget);
+MemoryUsage GetMemoryBudget(MemoryCategory category);
+
+/**
+ * @brief Turns the budget checks on or off, off by default except on web
+ */
+void EnableMemoryBudgets(bool enable);
+bool AreMemoryBudgetsEnabled();
+
+/**
+ * @brief Compares a report with the budgets and warns once about each category that goes over its budget,
+ * again only after it was back under it
+ *
+ * @return The categories over their budget, 0 if the budgets are disabled
+ */
+int CheckMemoryBudgets(const MemoryReport *report);
+
+/**
+ * @brief Checks if a category of a report is over its budget
+ */
+bool IsOverMemoryBudget(const MemoryReport *report, MemoryCategory category);
+
+#endif // __MEMORY_STATS_H__
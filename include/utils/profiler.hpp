@@ -0,0 +1,116 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RECORDER_CAPACITY 32768      // events kept in the ring, the oldest are overwritten
+#define RECORDER_WINDOW 5.0          // seconds before a spike written to its trace
+#define RECORDER_SPIKE_TIME 0.050    // seconds of frame work that make a frame a spike
+#define RECORDER_DUMP_COOLDOWN 10.0  // seconds after a dump before the next spike is dumped
+#define RECORDER_MAX_DUMPS 16        // per run, so a slow machine doesn't fill the disk
+#define RECORDER_MAX_THREADS 64      // threads that can be named
+#define TRACE_CAPTURE_BUFFER (1 << 20) // bytes buffered before a capture writes to its file
+
+enum RecorderEventType
+{
+    RECORDER_ZONE,    // something that took time, like a phase of the frame
+    RECORDER_INSTANT, // something that happened, like a spawn
+    RECORDER_COUNTER, // a value sampled once per frame, like the entity count
+};
+
+typedef struct RecorderEvent
+{
+    const char *name; // a string literal, only the pointer is kept
+    int64_t start;    // ns since the recorder started
+    int64_t duration; // ns, zones only
+    int64_t value;    // counters only
+    int thread;       // small id of the thread that recorded it
+    RecorderEventType type;
+} RecorderEvent;
+
+/**
+ * @brief Starts or stops recording. It starts stopped so headless runs don't pay for it,
+ * the game turns it on at startup
+ */
+void EnableFlightRecorder(bool enable);
+bool IsFlightRecorderEnabled();
+
+/**
+ * @brief Gets the clock of the recorder
+ *
+ * @return ns since the recorder started
+ */
+int64_t GetRecorderTime();
+
+void RecordZone(const char *name, int64_t start, int64_t end);
+void RecordInstant(const char *name);
+void RecordCounter(const char *name, int64_t value);
+
+/**
+ * @brief Names the calling thread in the traces, threads without a name show their id
+ *
+ * @param name A string literal, only the pointer is kept
+ */
+void NameRecorderThread(const char *name);
+
+/**
+ * @brief Marks the start of the work of a frame
+ */
+void BeginRecorderFrame();
+
+/**
+ * @brief Marks the end of the work of a frame, before waiting for the next one. If the frame took longer than
+ * RECORDER_SPIKE_TIME, the last RECORDER_WINDOW seconds are written to hitch_<frame>.json as a Chrome trace
+ * (open it in chrome://tracing or ui.perfetto.dev)
+ *
+ * @return Whether a trace was written
+ */
+bool EndRecorderFrame();
+
+/**
+ * @brief Starts writing every recorded event to a Chrome trace, for sessions longer than the ring.
+ * The events are copied from the ring at the end of each frame into a buffered file, frames longer than the
+ * ring (like loading) lose their oldest events. Turns the recorder on if it was off
+ *
+ * @param fileName The trace file, overwritten
+ * @return Whether the file could be opened, false if a capture is already running
+ */
+bool StartTraceCapture(const char *fileName);
+
+/**
+ * @brief Writes the events left and closes the trace
+ */
+void StopTraceCapture();
+
+bool IsCapturingTrace();
+
+/**
+ * @brief Records the time from its creation to the end of its scope as a zone
+ */
+class RecorderZone
+{
+private:
+    const char *name;
+    int64_t start;
+
+public:
+    RecorderZone(const char *name)
+    {
+        this->name = name;
+        this->start = IsFlightRecorderEnabled() ? GetRecorderTime() : -1;
+    }
+    ~RecorderZone()
+    {
+        if (start >= 0)
+        {
+            RecordZone(name, start, GetRecorderTime());
+        }
+    }
+};
+
+#define RECORDER_CONCAT_(a, b) a##b
+#define RECORDER_CONCAT(a, b) RECORDER_CONCAT_(a, b)
+#define RECORDER_ZONE(name) RecorderZone RECORDER_CONCAT(recorderZone, __LINE__)(name)
+
+#endif // __PROFILER_H__
@@ -2,6 +2,7 @@
 #define __RESOURCE_MANAGER_H__
 
 #include "raylib.h"
+#include "utils/memory_stats.hpp"
 #include <vector>
 
 /**
@@ -81,6 +82,8 @@ private:
     static std::vector<Sound> sounds;
     static std::vector<Music> music;
     static Font font;
+    static int soundAliases; // created and not unloaded yet
+    static int soundBudget;  // sounds that can still start, -1 for no limit
 
     /**
      * @brief Transparent texture
@@ -99,6 +102,13 @@ public:
      * @return true if all resources were loaded successfully, false otherwise
      */
     static bool LoadResources();
+
+    /**
+     * @brief Fills the resources with empty textures and sounds, for worlds simulated without a window or audio device.
+     * Nothing is drawn or played, raylib ignores the empty sounds.
+     * Must be called before starting the threads that step the worlds, the resources are only read after that
+     */
+    static void LoadHeadlessResources();
     static void UnloadResources();
 
     static Image *GetIcon();
@@ -140,6 +150,35 @@ public:
      */
     static Sound CreateSoundAlias(SoundID id);
 
+    /**
+     * @brief Plays a sound and counts it. The sounds of headless runs are empty, they don't play nor count.
+     * Sounds over the sound budget are skipped
+     *
+     * @param sound The sound or sound alias
+     */
+    static void PlaySound(Sound sound);
+
+    /**
+     * @brief Limits the sounds started until the next call, called every frame by the frame governor
+     *
+     * @param sounds The sounds that can start, -1 for no limit
+     */
+    static void SetSoundBudget(int sounds);
+
+    /**
+     * @brief Unloads a sound created with CreateSoundAlias()
+     *
+     * @param alias The sound alias, empty aliases of headless runs are ignored
+     */
+    static void UnloadSoundAlias(Sound alias);
+
+    /**
+     * @brief Adds the memory of the loaded textures, sounds, sound aliases and font to a report
+     *
+     * @param report The report
+     */
+    static void GetMemoryUsage(MemoryReport *report);
+
     static Font *GetFont();
 
     /**
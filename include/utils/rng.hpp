@@ -0,0 +1,95 @@
+#ifndef __RNG_H__
+#define __RNG_H__
+
+#include <stdint.h>
+
+#define RNG_DEFAULT_SEED 0x853c49e6748fea9bULL
+
+/**
+ * @brief Subsystems of the game with their own random stream. Numbers taken by one subsystem
+ * never change the numbers of the others, so adding a roll somewhere doesn't change the whole game
+ */
+enum RngStream
+{
+    RNG_SPAWN,     // spawn rolls and spawn positions
+    RNG_ASTEROIDS, // asteroid variants, sprites, velocities and spins
+    RNG_ENEMIES,   // enemy headings and the seeds of the enemy decision generators
+    RNG_POWER_UPS, // powerup types and the seeds of the powerup generators
+    RNG_COSMETIC,  // things that don't change the simulation, like the stars background
+    NUM_RNG_STREAMS
+};
+
+/**
+ * @brief The whole state of a generator, saved and restored to replay the same numbers
+ */
+typedef struct RngState
+{
+    uint64_t state;
+    uint64_t increment; // odd, selects the stream
+} RngState;
+
+/**
+ * @brief PCG32 random number generator. Each generator is a small value owned by whoever uses it,
+ * no state is shared between generators so entities updated in parallel can each use their own
+ */
+class Rng
+{
+private:
+    RngState s;
+
+public:
+    Rng() { Seed(RNG_DEFAULT_SEED, 0); }
+    Rng(uint64_t seed, uint64_t stream) { Seed(seed, stream); }
+
+    /**
+     * @brief Restarts the generator. Generators with the same seed and different streams give independent numbers
+     *
+     * @param seed The starting point of the sequence
+     * @param stream The sequence
+     */
+    void Seed(uint64_t seed, uint64_t stream);
+
+    /**
+     * @brief Gets the next 32 random bits
+     */
+    uint32_t Next()
+    {
+        const uint64_t old = s.state;
+        s.state = old * 6364136223846793005ULL + s.increment;
+        const uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        const uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+    }
+
+    /**
+     * @brief Gets a random integer between min and max, both included. Same range as raylib's GetRandomValue
+     */
+    int GetInt(int min, int max);
+
+    /**
+     * @brief Gets a random float in [0, 1)
+     */
+    float GetFloat() { return (Next() >> 8) * (1.0f / 16777216.0f); }
+
+    /**
+     * @brief Gets a random float in [min, max)
+     */
+    float GetFloat(float min, float max) { return min + (max - min) * GetFloat(); }
+
+    /**
+     * @brief Creates a new generator seeded from this one, for an entity that needs its own numbers
+     *
+     * @param stream The sequence of the new generator
+     */
+    Rng Split(uint64_t stream);
+
+    RngState GetState() { return s; }
+    void SetState(RngState state) { s = state; }
+};
+
+/**
+ * @brief Gets the generator of a subsystem of the game, seeded when a new game is created
+ */
+Rng *GetGameRng(RngStream stream);
+
+#endif // __RNG_H__
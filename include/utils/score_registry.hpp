@@ -4,8 +4,6 @@
 #include "raylib.h"
 #include "game/objects/power_up.hpp"
 
-#include <map>
-
 enum ScoreType{
     SHIELD_POWERUP_COLLECTED = SHIELD,
     TEMPORARY_SHIELD_POWERUP_COLLECTED = TEMPORARY_SHIELD,
@@ -24,6 +22,21 @@ enum ScoreType{
     NUM_SCORE_TYPES
 };
 
+/**
+ * @brief The scores of a game, each world has its own
+ */
+typedef struct ScoreRegistry
+{
+    float scores[NUM_SCORE_TYPES]; // raw scores (count of each ScoreType)
+    float totalScore;
+    float highScore; // kept when the registry is reset
+} ScoreRegistry;
+
+/**
+ * @brief Gets the score registry of the current world, the one all the functions below use
+ */
+ScoreRegistry *GetGameScores();
+
 void InitScoreRegistry();
 void AddScore(ScoreType type, float multiplier);
 
@@ -64,6 +77,22 @@ const char *GetScoreName(ScoreType type);
  */
 const char *GetGenericScoreName(ScoreType type);
 
+/**
+ * @brief Copies the raw scores and the total score, to restore them later with LoadScoreRegistry
+ *
+ * @param scores The raw score of each ScoreType
+ * @param total The total score
+ */
+void SaveScoreRegistry(float scores[NUM_SCORE_TYPES], float *total);
+
+/**
+ * @brief Sets the raw scores and the total score saved with SaveScoreRegistry. The high score is kept
+ *
+ * @param scores The raw score of each ScoreType
+ * @param total The total score
+ */
+void LoadScoreRegistry(const float scores[NUM_SCORE_TYPES], float total);
+
 /**
  * @brief Resets the score registry but keeps the high score intact
  * 
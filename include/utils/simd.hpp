@@ -0,0 +1,119 @@
+#ifndef __SIMD_H__
+#define __SIMD_H__
+
+#include "raylib.h"
+#include <stddef.h>
+
+/**
+ * @brief Instruction sets the point kernels can run with.
+ * The best one supported by the cpu is selected the first time a kernel is used
+ */
+enum SimdBackend
+{
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_WASM128,
+    NUM_SIMD_BACKENDS
+};
+
+/**
+ * @brief Rotation + uniform scale around a pivot followed by a translation:
+ * p' = pivot + translation + scale * R(angle) * (p - pivot)
+ */
+typedef struct PointTransform
+{
+    Vector2 pivot;
+    float cos; // cos(angle) * scale
+    float sin; // sin(angle) * scale
+    Vector2 translation;
+} PointTransform;
+
+/**
+ * @brief A half-plane of a convex polygon, a point is inside it if normal.x * x + normal.y * y <= distance
+ */
+typedef struct HalfPlane
+{
+    float normalX;
+    float normalY;
+    float distance;
+} HalfPlane;
+
+/**
+ * @brief Creates a point transform
+ *
+ * @param pivot The point to rotate and scale around
+ * @param angle The rotation angle in degrees
+ * @param scale The scale factor
+ * @param translation The translation applied after rotating and scaling
+ * @return The point transform
+ */
+PointTransform MakePointTransform(Vector2 pivot, float angle, float scale, Vector2 translation);
+
+/**
+ * @brief Translates an array of points
+ *
+ * @param points The points to translate
+ * @param count The number of points
+ * @param translation The translation to apply
+ */
+void TranslatePoints(Vector2 *points, size_t count, Vector2 translation);
+
+/**
+ * @brief Transforms an array of points. Source and destination can be the same array
+ *
+ * @param src The points to transform
+ * @param dst Where to store the transformed points
+ * @param count The number of points
+ * @param transform The transform to apply
+ */
+void TransformPoints(const Vector2 *src, Vector2 *dst, size_t count, PointTransform transform);
+
+/**
+ * @brief Computes the half-planes of a convex polygon (in any winding order, closed or not)
+ *
+ * @param polygon The vertices of the polygon
+ * @param count The number of vertices
+ * @param planes Where to store the half-planes, one per edge
+ * @param maxPlanes The capacity of planes
+ * @return The number of half-planes, 0 if the polygon is not convex or has too many edges
+ */
+size_t MakeConvexHalfPlanes(const Vector2 *polygon, size_t count, HalfPlane *planes, size_t maxPlanes);
+
+/**
+ * @brief Tests a batch of points (given as separate x and y arrays) against a convex polygon
+ *
+ * @param xs The x coordinates of the points
+ * @param ys The y coordinates of the points
+ * @param count The number of points
+ * @param planes The half-planes of the polygon, see MakeConvexHalfPlanes
+ * @param planeCount The number of half-planes
+ * @param inside Where to store the result for each point: 1 if inside the polygon, 0 otherwise
+ */
+void PointsInConvexPolygon(const float *xs, const float *ys, size_t count, const HalfPlane *planes, size_t planeCount, unsigned char *inside);
+
+/**
+ * @brief Gets the backend used by the kernels
+ */
+SimdBackend GetSimdBackend();
+
+/**
+ * @brief Forces the kernels to use the given backend (used to compare them).
+ * Not thread safe, it must not be called while other threads are running kernels
+ *
+ * @param backend The backend to use
+ * @return false if the backend is not supported by this build or cpu
+ */
+bool SetSimdBackend(SimdBackend backend);
+
+/**
+ * @brief Checks if the given backend is supported by this build and cpu
+ */
+bool IsSimdBackendSupported(SimdBackend backend);
+
+/**
+ * @brief Gets the name of the given backend
+ */
+const char *GetSimdBackendName(SimdBackend backend);
+
+#endif // __SIMD_H__
@@ -3,16 +3,17 @@
 
 #include "ui/components/common/button.hpp"
 #include "ui/components/common/ui_object.hpp"
+#include "utils/rng.hpp"
 #include <vector>
 
 Rectangle CreateCenteredButtonRec(Button **mainMenuButtons, int numButtons);
 
-std::vector<Vector2> getAxes(std::vector<Vector2> hitbox);
-Vector2 Project(Vector2 axis, std::vector<Vector2> hitbox);
+std::vector<Vector2> getAxes(const std::vector<Vector2> &hitbox);
+Vector2 Project(Vector2 axis, const std::vector<Vector2> &hitbox);
 bool Overlaps(Vector2 a, Vector2 b, float *overlap);
-Vector2 RandomVecOutsideScreen(float margin);
-Vector2 RandomVecInsideScreen(float margin);
-Texture2D *GenerateStarsBackground(int width, int height, int numStars, int minRadius, int maxRadius);
+Vector2 RandomVecOutsideScreen(float margin, Rectangle world, Rng *rng);
+Vector2 RandomVecInsideScreen(float margin, Rectangle world, Rng *rng);
+Texture2D *GenerateStarsBackground(int width, int height, int numStars, int minRadius, int maxRadius, Rng *rng);
 Rectangle ResizeRectWithAspectRatio(Rectangle rect, float newWidth, float newHeight);
 
 
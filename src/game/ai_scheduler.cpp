@@ -0,0 +1,73 @@
+#include "game/ai_scheduler.hpp"
+#include "game/objects/character.hpp"
+
+#include "raymath.h"
+
+AIScheduler::AIScheduler()
+{
+    this->cursor = 0;
+    this->budget = AI_THINK_BUDGET;
+    this->thinkCount = 0;
+    this->dueCount = 0;
+}
+
+AIScheduler::~AIScheduler()
+{
+}
+
+void AIScheduler::Run(EnemyBrains *brains, double time, Camera2D camera, BehaviorContext context)
+{
+    thinkCount = 0;
+    dueCount = 0;
+    due.clear();
+    const size_t count = brains->GetCount();
+    if (count == 0)
+    {
+        return;
+    }
+
+    const Vector2 topLeft = GetScreenToWorld2D({0, 0}, camera);
+    const Vector2 bottomRight = GetScreenToWorld2D({(float)GetScreenWidth(), (float)GetScreenHeight()}, camera);
+    const float margin = CHARACTER_SIZE / 2; // enemies partly inside the view are visible
+    const Rectangle view = {topLeft.x - margin, topLeft.y - margin, bottomRight.x - topLeft.x + margin * 2, bottomRight.y - topLeft.y + margin * 2};
+
+    // enemies come and go, the cursor only has to keep the visiting order fair
+    cursor %= count;
+    size_t nextCursor = cursor;
+
+    for (size_t n = 0; n < count; n++)
+    {
+        const int slot = (cursor + n) % count;
+        if (!brains->IsAlive(slot))
+        {
+            continue;
+        }
+
+        const Vector2 position = brains->GetPosition(slot);
+        float interval = AI_THINK_INTERVAL_FAR;
+        if (Vector2DistanceSqr(position, context.target) < AI_NEAR_DISTANCE * AI_NEAR_DISTANCE)
+        {
+            interval = AI_THINK_INTERVAL_NEAR;
+        }
+        else if (CheckCollisionPointRec(position, view))
+        {
+            interval = AI_THINK_INTERVAL_VISIBLE;
+        }
+
+        if (time - brains->GetLastThinkTime(slot) < interval)
+        {
+            continue;
+        }
+
+        dueCount++;
+        if (thinkCount < budget)
+        {
+            due.push_back(slot);
+            thinkCount++;
+            nextCursor = slot + 1;
+        }
+    }
+
+    cursor = nextCursor;
+    brains->Evaluate(time, due, context);
+}
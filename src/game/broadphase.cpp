@@ -0,0 +1,135 @@
+#include "game/broadphase.hpp"
+
+#include <algorithm>
+
+Broadphase::Broadphase()
+{
+    this->worldBox = {0, 0, 0, 0};
+    this->objectCount = 0;
+    this->ghostCount = 0;
+}
+
+Broadphase::~Broadphase()
+{
+}
+
+void Broadphase::Begin(Rectangle worldBox)
+{
+    this->worldBox = worldBox;
+    this->objectCount = 0;
+    this->ghostCount = 0;
+    proxies.clear();
+    pairs.clear();
+}
+
+void Broadphase::AddProxy(GameObject *object, Vector2 offset)
+{
+    Rectangle bounds = object->GetBounds();
+    bounds.x += offset.x;
+    bounds.y += offset.y;
+    proxies.push_back({object, bounds, offset, objectCount});
+}
+
+void Broadphase::Add(GameObject *object)
+{
+    AddProxy(object, {0, 0});
+
+    // the ghosts are where the object will be after wrapping around
+    const float margin = object->GetWrapMargin();
+    if (margin > 0)
+    {
+        const Rectangle bounds = object->GetBounds();
+        const Vector2 period = {worldBox.width + margin, worldBox.height + margin};
+
+        float ghostX = 0;
+        float ghostY = 0;
+        if (bounds.x + bounds.width > worldBox.x + worldBox.width)
+        {
+            ghostX = -period.x;
+        }
+        else if (bounds.x < worldBox.x)
+        {
+            ghostX = period.x;
+        }
+        if (bounds.y + bounds.height > worldBox.y + worldBox.height)
+        {
+            ghostY = -period.y;
+        }
+        else if (bounds.y < worldBox.y)
+        {
+            ghostY = period.y;
+        }
+
+        if (ghostX != 0)
+        {
+            AddProxy(object, {ghostX, 0});
+            ghostCount++;
+        }
+        if (ghostY != 0)
+        {
+            AddProxy(object, {0, ghostY});
+            ghostCount++;
+        }
+        if (ghostX != 0 && ghostY != 0) // corners
+        {
+            AddProxy(object, {ghostX, ghostY});
+            ghostCount++;
+        }
+    }
+
+    objectCount++;
+}
+
+const std::vector<BroadphasePair> &Broadphase::FindPairs()
+{
+    pairs.clear();
+
+    std::sort(proxies.begin(), proxies.end(), [](const BroadphaseProxy &a, const BroadphaseProxy &b)
+              { return a.bounds.x < b.bounds.x; });
+
+    for (size_t i = 0; i < proxies.size(); i++)
+    {
+        const BroadphaseProxy *p1 = &proxies[i];
+        const bool ghost1 = p1->offset.x != 0 || p1->offset.y != 0;
+
+        // proxies are sorted by their left edge, so the ones after this one's right edge can't overlap it
+        for (size_t j = i + 1; j < proxies.size() && proxies[j].bounds.x <= p1->bounds.x + p1->bounds.width; j++)
+        {
+            const BroadphaseProxy *p2 = &proxies[j];
+            const bool ghost2 = p2->offset.x != 0 || p2->offset.y != 0;
+
+            // two ghosts overlap only where the objects themselves already do
+            if (p1->object == p2->object || (ghost1 && ghost2))
+            {
+                continue;
+            }
+            if (p1->bounds.y > p2->bounds.y + p2->bounds.height || p2->bounds.y > p1->bounds.y + p1->bounds.height)
+            {
+                continue;
+            }
+
+            const BroadphaseProxy *first = p1->order < p2->order ? p1 : p2;
+            const BroadphaseProxy *second = p1->order < p2->order ? p2 : p1;
+            pairs.push_back({first->object, second->object, Vector2Subtract(second->offset, first->offset), first->order, second->order});
+        }
+    }
+
+    // back to the order the objects were added in, and only one pair per object pair,
+    // the direct one if the objects overlap both directly and across the edges
+    std::sort(pairs.begin(), pairs.end(), [](const BroadphasePair &a, const BroadphasePair &b)
+              {
+                  if (a.orderA != b.orderA)
+                  {
+                      return a.orderA < b.orderA;
+                  }
+                  if (a.orderB != b.orderB)
+                  {
+                      return a.orderB < b.orderB;
+                  }
+                  return Vector2LengthSqr(a.offset) < Vector2LengthSqr(b.offset); });
+    pairs.erase(std::unique(pairs.begin(), pairs.end(), [](const BroadphasePair &a, const BroadphasePair &b)
+                            { return a.orderA == b.orderA && a.orderB == b.orderB; }),
+                pairs.end());
+
+    return pairs;
+}
@@ -0,0 +1,91 @@
+#include "game/contact_cache.hpp"
+
+ContactCache::ContactCache()
+{
+    this->frame = 0;
+    this->hits = 0;
+    this->misses = 0;
+    this->axesTested = 0;
+    this->lastHits = 0;
+    this->lastMisses = 0;
+    this->lastAxesTested = 0;
+}
+
+ContactCache::~ContactCache()
+{
+}
+
+uint64_t ContactCache::GetKey(unsigned int a, unsigned int b)
+{
+    if (a > b)
+    {
+        return ((uint64_t)b << 32) | a;
+    }
+    return ((uint64_t)a << 32) | b;
+}
+
+void ContactCache::BeginFrame()
+{
+    // pairs not tested in the last frame belong to deleted objects or to objects that are not collidable anymore
+    const unsigned int lastFrame = frame;
+    std::erase_if(contacts, [lastFrame](const auto &pair)
+                  { return pair.second.lastFrame != lastFrame; });
+
+    frame++;
+    lastHits = hits;
+    lastMisses = misses;
+    lastAxesTested = axesTested;
+    hits = 0;
+    misses = 0;
+    axesTested = 0;
+}
+
+void ContactCache::Clear()
+{
+    contacts.clear();
+}
+
+Contact *ContactCache::GetContact(unsigned int a, unsigned int b, bool *created)
+{
+    auto [it, inserted] = contacts.try_emplace(GetKey(a, b));
+    if (inserted)
+    {
+        it->second = {false, {0, 0}, {0, 0}, 0, 0, 0, frame};
+    }
+    it->second.lastFrame = frame;
+    *created = inserted;
+    return &it->second;
+}
+
+void ContactCache::ForEach(const std::function<void(unsigned int a, unsigned int b, Contact contact)> &func)
+{
+    for (const auto &[key, contact] : contacts)
+    {
+        Contact relative = contact;
+        relative.lastFrame = frame - contact.lastFrame;
+        func((unsigned int)(key >> 32), (unsigned int)key, relative);
+    }
+}
+
+void ContactCache::Add(unsigned int a, unsigned int b, Contact contact)
+{
+    // the pair is stored from the lowest id, the directions are flipped if the ids came the other way
+    if (a > b)
+    {
+        contact.separatingAxis = {-contact.separatingAxis.x, -contact.separatingAxis.y};
+        contact.normal = {-contact.normal.x, -contact.normal.y};
+    }
+    contact.lastFrame = frame - contact.lastFrame;
+    contacts[GetKey(a, b)] = contact;
+}
+
+void ContactCache::Evict(unsigned int a, unsigned int b)
+{
+    contacts.erase(GetKey(a, b));
+}
+
+float ContactCache::GetHitRate()
+{
+    const int lookups = lastHits + lastMisses;
+    return lookups > 0 ? 100.0f * lastHits / lookups : 0.0f;
+}
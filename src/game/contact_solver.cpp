@@ -0,0 +1,101 @@
+#include "game/contact_solver.hpp"
+
+#include "raymath.h"
+#include <math.h>
+
+ContactSolver::ContactSolver()
+{
+    this->lastContactCount = 0;
+}
+
+ContactSolver::~ContactSolver()
+{
+}
+
+void ContactSolver::Clear()
+{
+    contacts.clear();
+}
+
+void ContactSolver::AddContact(GameObject *a, GameObject *b, Vector2 pushVector, ContactCache *cache)
+{
+    const float depth = Vector2Length(pushVector);
+    if (depth <= 0)
+    {
+        return;
+    }
+
+    a->WakeUp();
+    b->WakeUp();
+
+    bool created = false;
+    const Contact *cached = cache->GetContact(a->GetId(), b->GetId(), &created);
+
+    SolverContact contact = {0};
+    contact.a = a;
+    contact.b = b;
+    contact.normal = Vector2Scale(pushVector, 1 / depth);
+    contact.depth = depth;
+    contact.normalImpulse = created ? 0 : cached->normalImpulse;
+    contacts.push_back(contact);
+}
+
+void ContactSolver::Solve(ContactCache *cache)
+{
+    // prepare the contacts and apply last frame impulses
+    for (size_t i = 0; i < contacts.size(); i++)
+    {
+        SolverContact *c = &contacts[i];
+        const float normalVelocity = Vector2DotProduct(Vector2Subtract(c->b->GetVelocity(), c->a->GetVelocity()), c->normal);
+
+        c->velocityBias = 0;
+        if (normalVelocity < -SOLVER_RESTITUTION_THRESHOLD)
+        {
+            c->velocityBias = -SOLVER_RESTITUTION * normalVelocity;
+
+            // impacts also take away some spin, like the old push response did
+            c->a->SetAngularVelocity(c->a->GetAngularVelocity() * SOLVER_RESTITUTION);
+            c->b->SetAngularVelocity(c->b->GetAngularVelocity() * SOLVER_RESTITUTION);
+        }
+
+        const Vector2 impulse = Vector2Scale(c->normal, c->normalImpulse);
+        c->a->SetVelocity(Vector2Subtract(c->a->GetVelocity(), impulse));
+        c->b->SetVelocity(Vector2Add(c->b->GetVelocity(), impulse));
+    }
+
+    // sequential impulses, clamping the accumulated impulse instead of each step
+    for (int iteration = 0; iteration < SOLVER_ITERATIONS; iteration++)
+    {
+        for (size_t i = 0; i < contacts.size(); i++)
+        {
+            SolverContact *c = &contacts[i];
+            const float normalVelocity = Vector2DotProduct(Vector2Subtract(c->b->GetVelocity(), c->a->GetVelocity()), c->normal);
+
+            // both bodies have the same mass, each one takes half of the velocity change
+            float lambda = (c->velocityBias - normalVelocity) / 2;
+            const float previousImpulse = c->normalImpulse;
+            c->normalImpulse = fmaxf(previousImpulse + lambda, 0);
+            lambda = c->normalImpulse - previousImpulse;
+
+            const Vector2 impulse = Vector2Scale(c->normal, lambda);
+            c->a->SetVelocity(Vector2Subtract(c->a->GetVelocity(), impulse));
+            c->b->SetVelocity(Vector2Add(c->b->GetVelocity(), impulse));
+        }
+    }
+
+    // remove the overlap left, split between both bodies
+    for (size_t i = 0; i < contacts.size(); i++)
+    {
+        SolverContact *c = &contacts[i];
+        const float correction = fmaxf(c->depth - SOLVER_POSITION_SLOP, 0) * SOLVER_POSITION_CORRECTION / 2;
+        c->a->Translate(Vector2Scale(c->normal, -correction));
+        c->b->Translate(Vector2Scale(c->normal, correction));
+
+        // only resting contacts are warm started, reapplying the impulse of a bounce would add energy
+        bool created = false;
+        cache->GetContact(c->a->GetId(), c->b->GetId(), &created)->normalImpulse = c->velocityBias > 0 ? 0 : c->normalImpulse;
+    }
+
+    lastContactCount = contacts.size();
+    contacts.clear();
+}
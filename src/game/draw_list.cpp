@@ -0,0 +1,197 @@
+#include "game/draw_list.hpp"
+
+#include <algorithm>
+#include "rlgl.h"
+
+DrawList::DrawList()
+{
+    this->view = {0, 0, 0, 0};
+    this->total = 0;
+    this->culled = 0;
+    this->batches = 0;
+}
+
+DrawList::~DrawList()
+{
+}
+
+void DrawList::Begin(Camera2D camera)
+{
+    commands.clear();
+    bullets.clear();
+    total = 0;
+    culled = 0;
+    batches = 0;
+
+    Vector2 topLeft = GetScreenToWorld2D({0, 0}, camera);
+    Vector2 bottomRight = GetScreenToWorld2D({(float)GetScreenWidth(), (float)GetScreenHeight()}, camera);
+    view = {topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y};
+}
+
+bool DrawList::Add(GameObject *object, DrawLayer layer, bool cull, int blendMode)
+{
+    total++;
+    if (cull && !IsVisible(object->GetBounds()))
+    {
+        culled++;
+        return false;
+    }
+
+    Texture2D *texture = object->GetTexture();
+    commands.push_back({object, layer, blendMode, texture != nullptr ? texture->id : 0, commands.size()});
+    return true;
+}
+
+bool DrawList::AddBullet(Bullet *bullet)
+{
+    if (!bullet->IsAlive())
+    {
+        return false;
+    }
+    total++;
+    if (!IsVisible(bullet->GetBounds()))
+    {
+        culled++;
+        return false;
+    }
+
+    bullets.push_back(bullet);
+    return true;
+}
+
+void DrawList::Draw()
+{
+    std::sort(commands.begin(), commands.end(), [](const DrawCommand &a, const DrawCommand &b)
+              {
+                  if (a.layer != b.layer)
+                  {
+                      return a.layer < b.layer;
+                  }
+                  if (a.blendMode != b.blendMode)
+                  {
+                      return a.blendMode < b.blendMode;
+                  }
+                  if (a.textureId != b.textureId)
+                  {
+                      return a.textureId < b.textureId;
+                  }
+                  return a.order < b.order; });
+
+    int currentBlendMode = BLEND_ALPHA;
+    unsigned int currentTexture = 0;
+    bool bulletsDrawn = false;
+    for (size_t i = 0; i < commands.size(); i++)
+    {
+        if (!bulletsDrawn && commands[i].layer > DRAW_LAYER_BULLETS)
+        {
+            if (currentBlendMode != BLEND_ALPHA)
+            {
+                currentBlendMode = BLEND_ALPHA;
+                EndBlendMode();
+            }
+            DrawBullets();
+            bulletsDrawn = true;
+        }
+        if (commands[i].blendMode != currentBlendMode)
+        {
+            currentBlendMode = commands[i].blendMode;
+            BeginBlendMode(currentBlendMode);
+        }
+        if (i == 0 || commands[i].textureId != currentTexture || commands[i].blendMode != commands[i - 1].blendMode)
+        {
+            currentTexture = commands[i].textureId;
+            batches++;
+        }
+        commands[i].object->Draw();
+    }
+
+    if (currentBlendMode != BLEND_ALPHA)
+    {
+        EndBlendMode();
+    }
+    if (!bulletsDrawn)
+    {
+        DrawBullets();
+    }
+}
+
+void DrawList::DrawBullets()
+{
+    if (bullets.empty())
+    {
+        return;
+    }
+
+    // there are only a couple of bullet textures, sorting by them leaves one quad batch per texture
+    std::sort(bullets.begin(), bullets.end(), [](Bullet *a, Bullet *b)
+              { return a->GetTexture()->id < b->GetTexture()->id; });
+
+    unsigned int currentTexture = 0;
+    for (size_t i = 0; i < bullets.size(); i++)
+    {
+        Bullet *bullet = bullets[i];
+        const unsigned int textureId = bullet->GetTexture()->id;
+        if (i == 0 || textureId != currentTexture)
+        {
+            if (i > 0)
+            {
+                rlEnd();
+            }
+            currentTexture = textureId;
+            batches++;
+            rlSetTexture(textureId);
+            rlBegin(RL_QUADS);
+            rlColor4ub(WHITE.r, WHITE.g, WHITE.b, WHITE.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+        }
+
+        // flushes the batch if it is full, keeping the current texture and mode
+        rlCheckRenderBatchLimit(4);
+
+        // same quad as Bullet::Draw, rotated around the middle of its back side.
+        // The bullet rotation is its forward direction + 90 degrees, so its cos and sin
+        // can be taken from the forward direction without any trigonometric call
+        const Vector2 origin = bullet->GetOrigin();
+        const Vector2 forward = bullet->GetForwardDir();
+        const Rectangle bounds = bullet->GetBounds();
+        const Vector2 side = {-forward.y * bounds.width / 2, forward.x * bounds.width / 2};
+        const Vector2 length = {-forward.x * bounds.height, -forward.y * bounds.height};
+
+        const Vector2 topLeft = Vector2Subtract(origin, side);
+        const Vector2 topRight = Vector2Add(origin, side);
+        const Vector2 bottomLeft = Vector2Add(topLeft, length);
+        const Vector2 bottomRight = Vector2Add(topRight, length);
+
+        rlTexCoord2f(0.0f, 0.0f);
+        rlVertex2f(topLeft.x, topLeft.y);
+        rlTexCoord2f(0.0f, 1.0f);
+        rlVertex2f(bottomLeft.x, bottomLeft.y);
+        rlTexCoord2f(1.0f, 1.0f);
+        rlVertex2f(bottomRight.x, bottomRight.y);
+        rlTexCoord2f(1.0f, 0.0f);
+        rlVertex2f(topRight.x, topRight.y);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void DrawList::DrawDebug()
+{
+    for (size_t i = 0; i < commands.size(); i++)
+    {
+        commands[i].object->DrawDebug();
+    }
+    for (size_t i = 0; i < bullets.size(); i++)
+    {
+        bullets[i]->DrawDebug();
+    }
+}
+
+bool DrawList::IsVisible(Rectangle bounds)
+{
+    // a rectangle rotated around its center never leaves the circle of radius = half diagonal,
+    // the largest side is used to also cover objects drawn from a pivot outside their center (bullets)
+    const Vector2 center = {bounds.x + bounds.width / 2, bounds.y + bounds.height / 2};
+    const float radius = fmaxf(bounds.width, bounds.height);
+    return CheckCollisionCircleRec(center, radius, view);
+}
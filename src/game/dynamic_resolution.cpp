@@ -0,0 +1,154 @@
+#include "game/dynamic_resolution.hpp"
+#include "utils/profiler.hpp"
+
+#include <math.h>
+
+DynamicResolution::DynamicResolution()
+{
+    this->target = {0};
+    this->scale = 1.0f;
+    this->fixedScale = 0;
+    this->smoothedCpuTime = 0;
+    this->smoothedGpuTime = 0;
+    this->targetTime = 1.0f / RESOLUTION_DEFAULT_FPS;
+    this->overTime = 0;
+    this->underTime = 0;
+    this->restoreTime = RESOLUTION_RESTORE_TIME;
+    this->raised = false;
+    this->drawing = false;
+    this->changes = 0;
+}
+
+DynamicResolution::~DynamicResolution()
+{
+}
+
+void DynamicResolution::SetScale(float scale)
+{
+    scale = fminf(fmaxf(scale, RESOLUTION_MIN_SCALE), 1.0f);
+    if (scale == this->scale)
+    {
+        return;
+    }
+
+    // a raised scale that turns out too slow is tried again later each time, so the scale doesn't keep bouncing
+    if (scale < this->scale)
+    {
+        restoreTime = raised ? fminf(restoreTime * 2, RESOLUTION_MAX_RESTORE_TIME) : restoreTime;
+        raised = false;
+    }
+    else
+    {
+        raised = true;
+    }
+    TraceLog(LOG_INFO, "RESOLUTION: Scale %.0f%% -> %.0f%%, cpu %.1f ms, gpu %.1f ms for a target of %.1f ms", this->scale * 100,
+             scale * 100, smoothedCpuTime * 1000, smoothedGpuTime * 1000, targetTime * 1000);
+    this->scale = scale;
+    changes++;
+    overTime = 0;
+    underTime = 0;
+    RecordCounter("resolution scale", (int64_t)(scale * 100));
+}
+
+bool DynamicResolution::Update(float cpuTime, float gpuTime, int targetFPS)
+{
+    targetTime = 1.0f / (targetFPS > 0 ? targetFPS : RESOLUTION_DEFAULT_FPS);
+    smoothedCpuTime += (cpuTime - smoothedCpuTime) * RESOLUTION_SMOOTHING;
+    smoothedGpuTime += (gpuTime - smoothedGpuTime) * RESOLUTION_SMOOTHING;
+    if (fixedScale > 0)
+    {
+        return false;
+    }
+
+    // when the target is met, the time in EndDrawing also has the wait for the target fps and says nothing about the gpu.
+    // When it's missed there is no wait, and if the gpu takes most of the frame a smaller target helps
+    const float frameTime = smoothedCpuTime + smoothedGpuTime;
+    const bool missing = frameTime > targetTime * RESOLUTION_MISS_FRACTION;
+    const float frameDelta = cpuTime + gpuTime;
+    overTime = missing && smoothedGpuTime > smoothedCpuTime ? overTime + frameDelta : 0;
+    underTime = !missing ? underTime + frameDelta : 0;
+
+    // the backoff is only forgotten once the full resolution has held for the longest wait, raising it to 100%
+    // doesn't prove the machine can keep it
+    if (scale == 1.0f && underTime >= RESOLUTION_MAX_RESTORE_TIME)
+    {
+        restoreTime = RESOLUTION_RESTORE_TIME;
+        raised = false;
+    }
+
+    const float previousScale = scale;
+    if (overTime >= RESOLUTION_DEGRADE_TIME)
+    {
+        SetScale(scale - RESOLUTION_SCALE_STEP);
+    }
+    else if (underTime >= restoreTime)
+    {
+        SetScale(scale + RESOLUTION_SCALE_STEP);
+    }
+    return scale != previousScale;
+}
+
+void DynamicResolution::SetFixedScale(float scale)
+{
+    fixedScale = scale > 0 ? fminf(fmaxf(scale, RESOLUTION_MIN_SCALE), 1.0f) : 0;
+    overTime = 0;
+    underTime = 0;
+}
+
+void DynamicResolution::Begin(Color background)
+{
+    const float current = GetScale();
+    if (current >= 1.0f)
+    {
+        // the world is drawn straight to the screen, the target is freed until the scale goes down again
+        Unload();
+        return;
+    }
+
+    const int width = (int)fmaxf(GetScreenWidth() * current, 1);
+    const int height = (int)fmaxf(GetScreenHeight() * current, 1);
+    if (target.texture.width != width || target.texture.height != height)
+    {
+        Unload();
+        target = LoadRenderTexture(width, height);
+        SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+
+    BeginTextureMode(target);
+    ClearBackground(background);
+    drawing = true;
+}
+
+void DynamicResolution::End()
+{
+    if (!drawing)
+    {
+        return;
+    }
+    EndTextureMode();
+    drawing = false;
+
+    // render textures are flipped vertically
+    const Texture2D *texture = &target.texture;
+    DrawTexturePro(*texture, {0, 0, (float)texture->width, -(float)texture->height},
+                   {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()}, {0, 0}, 0, WHITE);
+}
+
+void DynamicResolution::GetMemoryUsage(MemoryReport *report)
+{
+    if (target.id != 0)
+    {
+        // color texture and a 32 bit depth buffer
+        const Texture2D *texture = &target.texture;
+        AddMemoryUsage(report, MEMORY_RENDER_TARGETS, 0, GetTextureBytes(*texture) + (size_t)texture->width * texture->height * 4);
+    }
+}
+
+void DynamicResolution::Unload()
+{
+    if (target.id != 0)
+    {
+        UnloadRenderTexture(target);
+        target = {0};
+    }
+}
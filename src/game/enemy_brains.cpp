@@ -0,0 +1,267 @@
+#include "game/enemy_brains.hpp"
+#include "game/objects/enemy.hpp"
+
+#include "raymath.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+EnemyBrains::EnemyBrains()
+{
+    this->transitionCount = 0;
+}
+
+EnemyBrains::~EnemyBrains()
+{
+}
+
+int EnemyBrains::Add(Enemy *owner, const BehaviorState *table, int initialState, float precision, float aggressiveness, Rng rng, double time)
+{
+    const int slot = owners.size();
+    owners.push_back(owner);
+    tables.push_back(table);
+    states.push_back(initialState);
+    stateEndTimes.push_back(time);
+    lastThinkTimes.push_back(time - BEHAVIOR_MAX_ELAPSED); // new enemies are due right away
+    positions.push_back({0, 0});
+    forwards.push_back({0, -1});
+    precisions.push_back(precision > 0 ? precision : 1);
+    this->aggressiveness.push_back(aggressiveness);
+    alive.push_back(true);
+    controls.push_back({0});
+    rngs.push_back(rng);
+
+    Enter(slot, initialState, time, {0, 0});
+    return slot;
+}
+
+void EnemyBrains::Remove(int slot)
+{
+    const int last = owners.size() - 1;
+    if (slot < 0 || slot > last)
+    {
+        return;
+    }
+
+    if (slot != last)
+    {
+        owners[slot] = owners[last];
+        tables[slot] = tables[last];
+        states[slot] = states[last];
+        stateEndTimes[slot] = stateEndTimes[last];
+        lastThinkTimes[slot] = lastThinkTimes[last];
+        positions[slot] = positions[last];
+        forwards[slot] = forwards[last];
+        precisions[slot] = precisions[last];
+        aggressiveness[slot] = aggressiveness[last];
+        alive[slot] = alive[last];
+        controls[slot] = controls[last];
+        rngs[slot] = rngs[last];
+        if (owners[slot] != nullptr)
+        {
+            owners[slot]->SetBrainSlot(slot);
+        }
+    }
+
+    owners.pop_back();
+    tables.pop_back();
+    states.pop_back();
+    stateEndTimes.pop_back();
+    lastThinkTimes.pop_back();
+    positions.pop_back();
+    forwards.pop_back();
+    precisions.pop_back();
+    aggressiveness.pop_back();
+    alive.pop_back();
+    controls.pop_back();
+    rngs.pop_back();
+}
+
+void EnemyBrains::Clear()
+{
+    while (!owners.empty())
+    {
+        Remove(owners.size() - 1);
+    }
+}
+
+void EnemyBrains::SetPose(int slot, Vector2 position, Vector2 forward, bool isAlive)
+{
+    positions[slot] = position;
+    forwards[slot] = forward;
+    alive[slot] = isAlive;
+}
+
+void EnemyBrains::GetRecord(int slot, EnemyBrainRecord *record)
+{
+    memset(record, 0, sizeof(*record));
+    record->state = states[slot];
+    record->stateEndTime = stateEndTimes[slot];
+    record->lastThinkTime = lastThinkTimes[slot];
+    record->precision = precisions[slot];
+    record->aggressiveness = aggressiveness[slot];
+    record->controls.accelerate = controls[slot].accelerate; // field by field, a struct copy would bring its padding
+    record->controls.turn = controls[slot].turn;
+    record->controls.steering = controls[slot].steering;
+    record->controls.direction = controls[slot].direction;
+    record->controls.aimAngle = controls[slot].aimAngle;
+    record->controls.shoot = controls[slot].shoot;
+    record->rng = rngs[slot].GetState();
+}
+
+void EnemyBrains::SetRecord(int slot, EnemyBrainRecord record)
+{
+    states[slot] = record.state;
+    stateEndTimes[slot] = record.stateEndTime;
+    lastThinkTimes[slot] = record.lastThinkTime;
+    precisions[slot] = record.precision;
+    aggressiveness[slot] = record.aggressiveness;
+    controls[slot] = record.controls;
+    rngs[slot].SetState(record.rng);
+}
+
+float EnemyBrains::GetAimAngle(int slot, Vector2 target)
+{
+    return Vector2Angle(forwards[slot], Vector2Subtract(target, positions[slot])) * RAD2DEG;
+}
+
+void EnemyBrains::Enter(int slot, int state, double time, Vector2 target)
+{
+    const BehaviorState *behavior = &tables[slot][state];
+    states[slot] = state;
+    stateEndTimes[slot] = time + behavior->minTime + (behavior->maxTime - behavior->minTime) * rngs[slot].GetFloat();
+
+    EnemyControls *control = &controls[slot];
+    control->accelerate = behavior->accelerate;
+    control->steering = behavior->steering;
+    switch (behavior->turn)
+    {
+    case TURN_LEFT:
+        control->turn = -1;
+        break;
+    case TURN_RIGHT:
+        control->turn = 1;
+        break;
+    case TURN_RANDOM:
+        control->turn = rngs[slot].GetInt(0, 1) ? -1 : 1;
+        break;
+    default:
+        control->turn = 0;
+        break;
+    }
+
+    if (behavior->enterActions & ACTION_SHOOT)
+    {
+        control->shoot = true;
+    }
+    if (behavior->enterActions & ACTION_RANDOM_DIRECTION)
+    {
+        control->direction = Vector2Normalize({(float)rngs[slot].GetInt(-100, 100), (float)rngs[slot].GetInt(-100, 100)});
+    }
+    control->aimAngle = behavior->steering == STEER_AIM ? GetAimAngle(slot, target) : 0;
+}
+
+void EnemyBrains::Evaluate(double time, const std::vector<int> &slots, BehaviorContext context)
+{
+    transitionCount = 0;
+
+    due.clear();
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        if (alive[slots[i]])
+        {
+            due.push_back(slots[i]);
+        }
+    }
+
+    // group the enemies by state, so each state is evaluated for all its enemies at once
+    std::sort(due.begin(), due.end(), [this](int a, int b)
+              { return &tables[a][states[a]] < &tables[b][states[b]]; });
+
+    elapsed.resize(due.size());
+    nextStates.assign(due.size(), -1);
+    for (size_t i = 0; i < due.size(); i++)
+    {
+        elapsed[i] = fminf(time - lastThinkTimes[due[i]], BEHAVIOR_MAX_ELAPSED);
+        lastThinkTimes[due[i]] = time;
+    }
+
+    size_t begin = 0;
+    while (begin < due.size())
+    {
+        const BehaviorState *behavior = &tables[due[begin]][states[due[begin]]];
+        size_t end = begin + 1;
+        while (end < due.size() && &tables[due[end]][states[due[end]]] == behavior)
+        {
+            end++;
+        }
+
+        // the transition is the same for the whole group, only the enemy data changes inside the loops.
+        // chances are per second so they don't depend on how often the enemies think
+        for (int t = 0; t < BEHAVIOR_MAX_TRANSITIONS; t++)
+        {
+            const BehaviorTransition *transition = &behavior->transitions[t];
+            switch (transition->trigger)
+            {
+            case TRIGGER_TIMEOUT:
+                for (size_t i = begin; i < end; i++)
+                {
+                    if (nextStates[i] < 0 && time >= stateEndTimes[due[i]])
+                    {
+                        nextStates[i] = transition->next;
+                    }
+                }
+                break;
+            case TRIGGER_CHANCE:
+                for (size_t i = begin; i < end; i++)
+                {
+                    if (nextStates[i] < 0 && rngs[due[i]].GetFloat() < 1.0f - expf(-transition->param * elapsed[i]))
+                    {
+                        nextStates[i] = transition->next;
+                    }
+                }
+                break;
+            case TRIGGER_TARGET_CHANCE:
+                if (!context.targetable)
+                {
+                    break;
+                }
+                for (size_t i = begin; i < end; i++)
+                {
+                    if (nextStates[i] < 0 && rngs[due[i]].GetFloat() < 1.0f - expf(-transition->param * aggressiveness[due[i]] * elapsed[i]))
+                    {
+                        nextStates[i] = transition->next;
+                    }
+                }
+                break;
+            case TRIGGER_AIMED:
+                for (size_t i = begin; i < end; i++)
+                {
+                    if (nextStates[i] < 0 && fabsf(GetAimAngle(due[i], context.target)) < BEHAVIOR_AIM_THRESHOLD / precisions[due[i]])
+                    {
+                        nextStates[i] = transition->next;
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        for (size_t i = begin; i < end; i++)
+        {
+            if (nextStates[i] >= 0)
+            {
+                Enter(due[i], nextStates[i], time, context.target);
+                transitionCount++;
+            }
+            else if (behavior->steering == STEER_AIM)
+            {
+                // the player moves, aiming enemies measure the angle again at every decision
+                controls[due[i]].aimAngle = GetAimAngle(due[i], context.target);
+            }
+        }
+
+        begin = end;
+    }
+}
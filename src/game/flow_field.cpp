@@ -0,0 +1,196 @@
+#include "game/flow_field.hpp"
+
+#include "raymath.h"
+#include <math.h>
+#include <limits.h>
+#include <algorithm>
+#include <functional>
+
+FlowField::FlowField()
+{
+    this->worldBox = {0, 0, 0, 0};
+    this->target = {0, 0};
+    this->columns = 0;
+    this->rows = 0;
+    this->targetCell = -1;
+}
+
+FlowField::~FlowField()
+{
+}
+
+int FlowField::GetCell(Vector2 position)
+{
+    if (columns == 0 || rows == 0)
+    {
+        return -1;
+    }
+
+    // positions past the edges are wrapped around, like the objects
+    int column = (int)floorf((position.x - worldBox.x) / FLOW_FIELD_CELL_SIZE) % columns;
+    int row = (int)floorf((position.y - worldBox.y) / FLOW_FIELD_CELL_SIZE) % rows;
+    column = column < 0 ? column + columns : column;
+    row = row < 0 ? row + rows : row;
+    return row * columns + column;
+}
+
+void FlowField::Begin(Rectangle worldBox, Vector2 target)
+{
+    this->worldBox = worldBox;
+    this->target = target;
+    this->columns = (int)ceilf(worldBox.width / FLOW_FIELD_CELL_SIZE);
+    this->rows = (int)ceilf(worldBox.height / FLOW_FIELD_CELL_SIZE);
+
+    cells.assign(columns * rows, {0});
+    agents.clear();
+    targetCell = GetCell(target);
+}
+
+void FlowField::AddObstacle(Rectangle bounds)
+{
+    if (cells.empty())
+    {
+        return;
+    }
+
+    const int firstColumn = (int)floorf((bounds.x - worldBox.x) / FLOW_FIELD_CELL_SIZE);
+    const int lastColumn = (int)floorf((bounds.x + bounds.width - worldBox.x) / FLOW_FIELD_CELL_SIZE);
+    const int firstRow = (int)floorf((bounds.y - worldBox.y) / FLOW_FIELD_CELL_SIZE);
+    const int lastRow = (int)floorf((bounds.y + bounds.height - worldBox.y) / FLOW_FIELD_CELL_SIZE);
+
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+        for (int column = firstColumn; column <= lastColumn; column++)
+        {
+            const int wrappedColumn = ((column % columns) + columns) % columns;
+            const int wrappedRow = ((row % rows) + rows) % rows;
+            cells[wrappedRow * columns + wrappedColumn].obstacle = true;
+        }
+    }
+}
+
+void FlowField::AddAgent(Vector2 position)
+{
+    agents.push_back(position);
+}
+
+void FlowField::Finish()
+{
+    if (cells.empty() || targetCell < 0)
+    {
+        return;
+    }
+
+    static const int neighborX[] = {1, -1, 0, 0, 1, 1, -1, -1};
+    static const int neighborY[] = {0, 0, 1, -1, 1, -1, 1, -1};
+    static const int neighborCost[] = {FLOW_FIELD_STRAIGHT_COST, FLOW_FIELD_STRAIGHT_COST, FLOW_FIELD_STRAIGHT_COST, FLOW_FIELD_STRAIGHT_COST,
+                                       FLOW_FIELD_DIAGONAL_COST, FLOW_FIELD_DIAGONAL_COST, FLOW_FIELD_DIAGONAL_COST, FLOW_FIELD_DIAGONAL_COST};
+
+    // dijkstra from the target, the grid is small enough for a plain binary heap
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        cells[i].cost = INT_MAX;
+    }
+    cells[targetCell].cost = 0;
+    queue.clear();
+    queue.push_back({0, targetCell});
+
+    while (!queue.empty())
+    {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<std::pair<int, int>>());
+        const std::pair<int, int> current = queue.back();
+        queue.pop_back();
+        if (current.first > cells[current.second].cost)
+        {
+            continue; // already visited with a lower cost
+        }
+
+        const int column = current.second % columns;
+        const int row = current.second / columns;
+        for (int n = 0; n < 8; n++)
+        {
+            const int neighbor = ((row + neighborY[n] + rows) % rows) * columns + (column + neighborX[n] + columns) % columns;
+
+            // the path from the neighbor enters the current cell, which is what costs more if it is covered
+            const int cost = current.first + neighborCost[n] + (cells[current.second].obstacle ? FLOW_FIELD_OBSTACLE_COST : 0);
+            if (cost < cells[neighbor].cost)
+            {
+                cells[neighbor].cost = cost;
+                queue.push_back({cost, neighbor});
+                std::push_heap(queue.begin(), queue.end(), std::greater<std::pair<int, int>>());
+            }
+        }
+    }
+
+    // each cell points to its cheapest neighbor
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            FlowCell *cell = &cells[row * columns + column];
+            int bestCost = cell->cost;
+            cell->dir = {0, 0};
+            for (int n = 0; n < 8; n++)
+            {
+                const int neighbor = ((row + neighborY[n] + rows) % rows) * columns + (column + neighborX[n] + columns) % columns;
+                if (cells[neighbor].cost < bestCost)
+                {
+                    bestCost = cells[neighbor].cost;
+                    cell->dir = Vector2Normalize({(float)neighborX[n], (float)neighborY[n]});
+                }
+            }
+        }
+    }
+
+    // bin the agents, each cell sums the agents of the 3x3 block around it so a single lookup finds the close ones.
+    // blocks don't wrap around, the positions on the other side would pull the average across the world
+    for (size_t i = 0; i < agents.size(); i++)
+    {
+        const int cell = GetCell(agents[i]);
+        const int column = cell % columns;
+        const int row = cell / columns;
+        for (int y = std::max(row - 1, 0); y <= std::min(row + 1, rows - 1); y++)
+        {
+            for (int x = std::max(column - 1, 0); x <= std::min(column + 1, columns - 1); x++)
+            {
+                FlowCell *around = &cells[y * columns + x];
+                around->agentSum = Vector2Add(around->agentSum, agents[i]);
+                around->agentCount++;
+            }
+        }
+    }
+}
+
+Vector2 FlowField::GetDirection(Vector2 position)
+{
+    const int cell = GetCell(position);
+    if (cell < 0 || cell == targetCell || (cells[cell].dir.x == 0 && cells[cell].dir.y == 0))
+    {
+        return Vector2Normalize(Vector2Subtract(target, position));
+    }
+    return cells[cell].dir;
+}
+
+Vector2 FlowField::GetSeparation(Vector2 position)
+{
+    const int cell = GetCell(position);
+    if (cell < 0 || cells[cell].agentCount <= 1)
+    {
+        return {0, 0};
+    }
+
+    // the block sums include the agent itself
+    const FlowCell *block = &cells[cell];
+    const Vector2 others = Vector2Scale(Vector2Subtract(block->agentSum, position), 1.0f / (block->agentCount - 1));
+    const Vector2 away = Vector2Subtract(position, others);
+    const float distance = Vector2Length(away);
+    if (distance >= FLOW_FIELD_SEPARATION_DISTANCE)
+    {
+        return {0, 0};
+    }
+    if (distance <= 0)
+    {
+        return {1, 0}; // on top of each other, any direction separates them
+    }
+    return Vector2Scale(away, (FLOW_FIELD_SEPARATION_DISTANCE - distance) / (FLOW_FIELD_SEPARATION_DISTANCE * distance));
+}
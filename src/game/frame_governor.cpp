@@ -0,0 +1,111 @@
+#include "game/frame_governor.hpp"
+#include "utils/profiler.hpp"
+
+#include "raylib.h"
+
+// the work shed at each level, the entities go last because they change the game the most
+static const GovernorSettings governorLevels[] = {
+    {1.0f, -1, true, true},
+    {1.0f, 8, true, false},
+    {0.75f, 4, false, false},
+    {0.5f, 2, false, false},
+};
+static_assert(sizeof(governorLevels) / sizeof(governorLevels[0]) == GOVERNOR_MAX_LEVEL + 1, "every level has its settings");
+
+FrameGovernor::FrameGovernor()
+{
+    this->enabled = true;
+    this->targetTime = GOVERNOR_TARGET_FRACTION / GOVERNOR_DEFAULT_FPS;
+    Reset();
+}
+
+FrameGovernor::~FrameGovernor()
+{
+}
+
+void FrameGovernor::Reset()
+{
+    this->sampleCount = 0;
+    this->nextSample = 0;
+    this->smoothedTime = 0;
+    this->overTime = 0;
+    this->underTime = 0;
+    this->level = 0;
+    this->changes = 0;
+}
+
+void FrameGovernor::SetEnabled(bool enabled)
+{
+    this->enabled = enabled;
+    if (!enabled)
+    {
+        SetLevel(0);
+    }
+}
+
+void FrameGovernor::SetLevel(int level)
+{
+    if (level == this->level)
+    {
+        return;
+    }
+    TraceLog(LOG_INFO, "GOVERNOR: Level %d -> %d, busy %.1f ms for a target of %.1f ms", this->level, level,
+             smoothedTime * 1000, targetTime * 1000);
+    this->level = level;
+    changes++;
+    overTime = 0;
+    underTime = 0;
+
+    // the frames measured before the change don't tell anything about the new level
+    sampleCount = 0;
+    nextSample = 0;
+    RecordCounter("governor level", level);
+}
+
+bool FrameGovernor::Update(float busyTime, float frameTime, int targetFPS)
+{
+    if (!enabled)
+    {
+        return false;
+    }
+
+    targetTime = GOVERNOR_TARGET_FRACTION / (targetFPS > 0 ? targetFPS : GOVERNOR_DEFAULT_FPS);
+
+    samples[nextSample] = busyTime;
+    nextSample = (nextSample + 1) % GOVERNOR_WINDOW;
+    if (sampleCount < GOVERNOR_WINDOW)
+    {
+        sampleCount++;
+    }
+    float sum = 0;
+    for (int i = 0; i < sampleCount; i++)
+    {
+        sum += samples[i];
+    }
+    smoothedTime = sum / sampleCount;
+
+    // a full window is needed before deciding, a single slow frame is a hitch and not a slow machine
+    if (sampleCount < GOVERNOR_WINDOW)
+    {
+        return false;
+    }
+
+    overTime = smoothedTime > targetTime ? overTime + frameTime : 0;
+    underTime = smoothedTime < targetTime * GOVERNOR_RESTORE_FRACTION ? underTime + frameTime : 0;
+
+    const int previousLevel = level;
+    if (overTime >= GOVERNOR_DEGRADE_TIME && level < GOVERNOR_MAX_LEVEL)
+    {
+        SetLevel(level + 1);
+    }
+    else if (underTime >= GOVERNOR_RESTORE_TIME && level > 0)
+    {
+        SetLevel(level - 1);
+    }
+    return level != previousLevel;
+}
+
+GovernorSettings FrameGovernor::GetSettings()
+{
+    return governorLevels[level];
+}
@@ -1,6 +1,8 @@
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <algorithm>
+#include <chrono>
 
 #include "raylib.h"
 
@@ -12,11 +14,13 @@
 #include "utils/score_registry.hpp"
 #include "game/objects/player.hpp"
 #include "game/objects/asteroid.hpp"
-#include "game/objects/shooter.hpp"
-#include "game/objects/stalker.hpp"
-#include "game/objects/pulser.hpp"
+#include "game/objects/enemy.hpp"
 #include "game/objects/power_up.hpp"
 #include "utils/utils.hpp"
+#include "utils/simd.hpp"
+#include "utils/profiler.hpp"
+#include "utils/counters.hpp"
+#include "utils/memory_stats.hpp"
 
 
 // -------------- Debug Flags --------------
@@ -29,8 +33,14 @@ bool SHOW_DEBUG = false;
 
 #define BACKGROUND_COLOR GetColor(0x242424ff)
 
-#define INITIAL_ASTEROIDS 5
-#define INITIAL_ENEMIES 1
+#define UNFOCUSED_FPS 10      // frames per second
+#define IDLE_SAMPLE_TIME 1.0f // seconds
+#define TRACE_CAPTURE_FILE "trace_%d.json" // file of the trace capture key (F8), numbered per capture
+#define MEMORY_CHECK_INTERVAL 1.0            // seconds between memory budget checks
+
+static const char *traceCaptureFile = nullptr; // from the command line, captured from the start
+static int traceCaptures = 0;
+
 
 GameState gameState;
 
@@ -44,6 +54,7 @@ bool InitGame()
 
     gameState.fullscreen = false;
     gameState.windowSize = {(float)GetScreenWidth(), (float)GetScreenHeight()};
+    gameState.world.bounds = {-gameState.windowSize.x / 2, -gameState.windowSize.y / 2, gameState.windowSize.x, gameState.windowSize.y};
     gameState.originalWindowSize = gameState.windowSize;
     gameState.hasEnteredGame = false;
 
@@ -51,6 +62,16 @@ bool InitGame()
     SetTraceLogLevel(LOG_ALL);
 #endif // _DEBUG
 
+#ifndef PLATFORM_WEB
+    // always on, a hitch is written to a trace when it happens instead of having to reproduce it under a profiler
+    EnableFlightRecorder(true);
+    NameRecorderThread("main");
+    if (traceCaptureFile != nullptr && !IsCapturingTrace())
+    {
+        StartTraceCapture(traceCaptureFile);
+    }
+#endif // PLATFORM_WEB
+
     InitAudioDevice();
     SetMasterVolume(0);
 
@@ -64,99 +85,93 @@ bool InitGame()
 
     gameState.previousScreen = LOADING;
     gameState.currentScreen = LOADING;
-    gameState.powerupSpawned = false;
-    gameState.spawnTimer = 0.0f;
 
-    gameState.asteroidsCount = 0;
-    gameState.shootersCount = 0;
+    // the game objects created by the main thread belong to the world on screen
+    SetCurrentWorld(&gameState.world);
+    gameState.world.bounds = {-gameState.windowSize.x / 2, -gameState.windowSize.y / 2, gameState.windowSize.x, gameState.windowSize.y};
+
+    gameState.worldCache = {0};
+    gameState.worldCacheValid = false;
+    gameState.fixedSeed = 0;
+    gameState.rewind.Reset(SNAPSHOT_REWIND_SLOTS);
+    gameState.lastRewindTime = 0;
+    gameState.snapshotSize = 0;
+    gameState.snapshotCaptureTime = 0;
+    gameState.snapshotRestoreTime = 0;
+
+    gameState.debugPage = DEBUG_PAGE_COUNTERS;
+    gameState.lastMemoryCheck = 0;
 
-    gameState.player = new Player();
+    gameState.idle = {0};
+    gameState.idle.targetFPS = gameState.fps;
+    gameState.idle.sampleStart = GetTime();
 
-    CreateUIElements(gameState.player);
     CreateNewGame(INITIAL_ASTEROIDS, INITIAL_ENEMIES);
+    CreateUIElements(gameState.world.player);
 
     return true;
 }
 
-void UpdateDifficultySettings(Difficulty diff)
+void ParseGameArgs(int argc, char **argv)
 {
-    DifficultySettings *diffSettings = &gameState.diffSettings;
-
-    diffSettings->difficulty = diff;
-    diffSettings->maxAsteroids = fminf(powf(3, diff + 1), 18);                        // 3, 9, 18
-    diffSettings->maxShooters = powf(2, diff + 1);                                    // 2, 4, 8
-    diffSettings->maxStalkers = 1 + diff * 2;                                         // 1, 3, 5
-    diffSettings->maxPulsers = fmaxf(diff * 2 - 1, 0);                                // 0, 1, 3
-    diffSettings->maxEnemies = diffSettings->maxShooters + diffSettings->maxStalkers; // 3, 7, 13
-
-    diffSettings->spawnRate = 1.0f - (float)diff * 0.12f;                                             // 1.0, 0.88, 0.76
-    diffSettings->asteroidsSpawnChance = 0.35f + (float)(gameState.diffSettings.difficulty) * 0.15f;  // 0.35, 0.5, 0.65
-    diffSettings->enemiesSpawnChance = 0.2f + (float)(gameState.diffSettings.difficulty + 1) * 0.1f;  // 0.2, 0.3, 0.4
-    diffSettings->powerupSpawnChance = 0.15f + (float)(gameState.diffSettings.difficulty) * 0.2f;     // 0.15, 0.35, 0.55
-    diffSettings->asteroidSpeedMultiplier = 1.0f + (float)(gameState.diffSettings.difficulty) * 0.5f; // 1.0, 1.5, 2.0
-    diffSettings->scoreMultiplier = powf(1.2f, gameState.diffSettings.difficulty);
-
-    EnemyAttributes *enemiesAttr = &gameState.diffSettings.enemiesAttributes;
-
-    enemiesAttr->velocityMultiplier = 0.8f + (float)(gameState.diffSettings.difficulty) * 0.6f;       // 0.8, 1.4, 2.0
-    enemiesAttr->precision = 0.5f + (float)(gameState.diffSettings.difficulty) * 0.25f;               // 0.5, 0.75, 1.0
-    enemiesAttr->fireRateMultiplier = 0.5f + (float)(gameState.diffSettings.difficulty) * 0.25f;      // 0.5, 0.75, 1.0
-    enemiesAttr->bulletSpeedMultiplier = 0.9f + (float)(gameState.diffSettings.difficulty) * 0.2f;    // 0.9, 1.1, 1.3
-    enemiesAttr->probOfShootingAtPlayer = 0.35f + (float)(gameState.diffSettings.difficulty) * 0.25f; // 0.35, 0.6, 0.85
-    enemiesAttr->bulletsPerShot = 8 + 8 * gameState.diffSettings.difficulty;                          // 8, 16, 24
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            traceCaptureFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--memory-budget") == 0)
+        {
+            EnableMemoryBudgets(true);
+        }
+        else if (strcmp(argv[i], "--no-governor") == 0)
+        {
+            gameState.governor.SetEnabled(false);
+        }
+        else
+        {
+            TraceLog(LOG_WARNING, "Unknown argument %s", argv[i]);
+        }
+    }
 }
 
-void CreateNewGame(size_t numAsteroids, size_t numEnemies)
+void GetGameMemoryUsage(MemoryReport *report)
 {
-
-    gameState.asteroidsCount = 0;
-    gameState.shootersCount = 0;
-    gameState.stalkersCount = 0;
-    gameState.pulsersCount = 0;
-    gameState.powerupSpawned = false;
-
-    UpdateDifficultySettings(EASY); // difficulty starts at easy and is increased as the player scores more points
-
-    ResetScoreRegistry();
-
-    // unload previous background and create a new one
+    ResourceManager::GetMemoryUsage(report);
+    gameState.world.GetMemoryUsage(report);
     if (gameState.spaceBackground != nullptr)
     {
-        UnloadTexture(*gameState.spaceBackground);
+        AddMemoryUsage(report, MEMORY_BACKGROUND, 0, GetTextureBytes(*gameState.spaceBackground));
     }
-    gameState.spaceBackground = GenerateStarsBackground(4096, 4096, GetRandomValue(1000, 2000), 1, 2);
-
-    // reset player
-    if (gameState.player != nullptr)
+    if (gameState.worldCache.id != 0)
     {
-        gameState.player->Reset();
-    }
-    else
-    {
-        gameState.player = new Player();
+        // color texture and a 32 bit depth buffer
+        const Texture2D *cache = &gameState.worldCache.texture;
+        AddMemoryUsage(report, MEMORY_RENDER_TARGETS, 0, GetTextureBytes(*cache) + (size_t)cache->width * cache->height * 4);
     }
+    gameState.resolution.GetMemoryUsage(report);
+}
 
-    // delete all game objects
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
+void CreateNewGame(size_t numAsteroids, size_t numEnemies)
+{
+    RECORDER_ZONE("CreateNewGame");
+    uint64_t seed = gameState.fixedSeed;
+    if (seed == 0)
     {
-        delete gameState.gameObjects[i];
+        seed = (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
     }
-    gameState.gameObjects.clear();
+    gameState.world.Create(numAsteroids, numEnemies, seed);
 
-    // create new game objects
-    for (size_t i = 0; i < numAsteroids + numEnemies; i++)
+    // unload previous background and create a new one
+    if (gameState.spaceBackground != nullptr)
     {
-        if (i < numAsteroids)
-        {
-            gameState.gameObjects.push_back(new Asteroid(gameState.diffSettings.asteroidSpeedMultiplier));
-            gameState.asteroidsCount++;
-        }
-        else
-        {
-            gameState.gameObjects.push_back(new Shooter(gameState.player, gameState.diffSettings.enemiesAttributes));
-            gameState.shootersCount++;
-        }
+        UnloadTexture(*gameState.spaceBackground);
     }
+    gameState.spaceBackground = GenerateStarsBackground(4096, 4096, GetGameRng(RNG_COSMETIC)->GetInt(1000, 2000), 1, 2, GetGameRng(RNG_COSMETIC));
+
+    gameState.worldCacheValid = false;
+    gameState.rewind.Reset(SNAPSHOT_REWIND_SLOTS);
+    gameState.lastRewindTime = gameState.world.gameTime;
 }
 
 void ChangeScreen(ScreenID screen)
@@ -179,7 +194,7 @@ void ChangeScreen(ScreenID screen)
     {
         gameState.hasEnteredGame = false;
         gameState.previousScreen = MAIN_MENU;
-        gameState.player->Hide();
+        gameState.world.player->Hide();
         CreateNewGame(INITIAL_ASTEROIDS, INITIAL_ENEMIES);
     }
 
@@ -187,7 +202,7 @@ void ChangeScreen(ScreenID screen)
     if (screen == GAME && !gameState.hasEnteredGame)
     {
         gameState.hasEnteredGame = true;
-        gameState.player->Show();
+        gameState.world.player->Show();
     }
 
     // sets the master volume to 0 if the screen is not the game or game over
@@ -260,7 +275,8 @@ void ResizeCallback(Vector2 prevWindowSize)
         }
     }
 
-    gameState.player->UpdateCamera();
+    gameState.world.player->UpdateCamera();
+    gameState.worldCacheValid = false;
 }
 
 void ChangeFPS()
@@ -273,26 +289,98 @@ void ChangeFPS()
     static int fpsIndex = 2;
     fpsIndex = (fpsIndex + 1) % (sizeof(fps) / sizeof(int));
     gameState.fps = fps[fpsIndex];
+    gameState.idle.targetFPS = gameState.fps;
     SetTargetFPS(gameState.fps);
 }
 
 void PauseGame()
 {
     ChangeScreen(PAUSE_MENU);
-    gameState.player->PauseSounds();
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
+    gameState.world.player->PauseSounds();
+    for (size_t i = 0; i < gameState.world.gameObjects.size(); i++)
     {
-        gameState.gameObjects[i]->PauseSounds();
+        gameState.world.gameObjects[i]->PauseSounds();
     }
 }
 
+bool IsGamePaused()
+{
+    return gameState.currentScreen == PAUSE_MENU || (gameState.previousScreen == PAUSE_MENU && gameState.currentScreen != GAME);
+}
+
+void SetGameSeed(uint64_t seed)
+{
+    gameState.fixedSeed = seed;
+}
+
+uint64_t GetGameSeed()
+{
+    return gameState.world.seed;
+}
+
+void CaptureGame(GameSnapshot *snapshot)
+{
+    const double start = GetTime();
+    gameState.world.Capture(snapshot);
+    gameState.snapshotSize = GetGameSnapshotSize(snapshot);
+    gameState.snapshotCaptureTime = GetTime() - start;
+}
+
+void RestoreGame(const GameSnapshot *snapshot)
+{
+    const double start = GetTime();
+    gameState.world.Restore(snapshot);
+    gameState.worldCacheValid = false;
+    gameState.lastRewindTime = gameState.world.gameTime;
+    gameState.snapshotRestoreTime = GetTime() - start;
+}
+
+bool SaveGameSnapshot(const char *fileName)
+{
+    static GameSnapshot snapshot;
+    static std::vector<unsigned char> data;
+    CaptureGame(&snapshot);
+    WriteGameSnapshot(&snapshot, &data);
+    if (!SaveFileData(fileName, data.data(), data.size()))
+    {
+        TraceLog(LOG_WARNING, "SNAPSHOT: Failed to save %s", fileName);
+        return false;
+    }
+    TraceLog(LOG_INFO, "SNAPSHOT: Saved %s (%d bytes, captured in %.3f ms)", fileName, (int)data.size(), gameState.snapshotCaptureTime * 1000);
+    return true;
+}
+
+bool LoadGameSnapshot(const char *fileName)
+{
+    static GameSnapshot snapshot;
+    int size = 0;
+    unsigned char *data = LoadFileData(fileName, &size);
+    if (data == nullptr)
+    {
+        TraceLog(LOG_WARNING, "SNAPSHOT: Failed to load %s", fileName);
+        return false;
+    }
+    const bool valid = ReadGameSnapshot(data, size, &snapshot);
+    UnloadFileData(data);
+    if (!valid)
+    {
+        TraceLog(LOG_WARNING, "SNAPSHOT: %s is not a snapshot of this version", fileName);
+        return false;
+    }
+
+    RestoreGame(&snapshot);
+    gameState.snapshotSize = size;
+    TraceLog(LOG_INFO, "SNAPSHOT: Loaded %s (%d bytes, restored in %.3f ms)", fileName, size, gameState.snapshotRestoreTime * 1000);
+    return true;
+}
+
 void ResumeGame()
 {
     ChangeScreen(GAME);
-    gameState.player->ResumeSounds();
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
+    gameState.world.player->ResumeSounds();
+    for (size_t i = 0; i < gameState.world.gameObjects.size(); i++)
     {
-        gameState.gameObjects[i]->ResumeSounds();
+        gameState.world.gameObjects[i]->ResumeSounds();
     }
 }
 
@@ -302,38 +390,125 @@ void RestartGame()
     ChangeScreen(GAME);
 }
 
+void AddBulletsToDrawList(std::vector<Bullet> *bullets)
+{
+    for (size_t i = 0; i < bullets->size(); i++)
+    {
+        gameState.drawList.AddBullet(&(*bullets)[i]);
+    }
+}
+
+void DrawWorld(float scale)
+{
+    RECORDER_ZONE("DrawWorld");
+    // draw background centered
+    const Vector2 backgroundPosition = {(float)((int)(GetScreenWidth() - gameState.spaceBackground->width) / 2), (float)((int)(GetScreenHeight() - gameState.spaceBackground->height) / 2)};
+    DrawTextureEx(*gameState.spaceBackground, Vector2Scale(backgroundPosition, scale), 0, scale, WHITE);
+
+    // the view is the same at any scale, only the camera used to draw it is scaled
+    const Camera2D camera = gameState.world.player->GetCamera();
+    Camera2D scaledCamera = camera;
+    scaledCamera.offset = Vector2Scale(camera.offset, scale);
+    scaledCamera.zoom = camera.zoom * scale;
+    BeginMode2D(scaledCamera);
+
+    // only the objects inside the camera view are drawn, grouped by texture.
+    // Bullets are written as quads to a single render batch per bullet texture
+    gameState.drawList.Begin(camera);
+    const bool explosions = gameState.governor.GetSettings().explosions;
+    for (size_t i = 0; i < gameState.world.gameObjects.size(); i++)
+    {
+        GameObject *object = gameState.world.gameObjects[i];
+        if (!explosions && object->GetType() == ASTEROID && ((Asteroid *)object)->IsExploding())
+        {
+            continue;
+        }
+        gameState.drawList.Add(object, DRAW_LAYER_WORLD);
+        if (gameState.world.gameObjects[i]->GetType() == ENEMY)
+        {
+            AddBulletsToDrawList(((Enemy *)gameState.world.gameObjects[i])->GetBullets());
+        }
+    }
+    AddBulletsToDrawList(&gameState.world.orphanBullets);
+    AddBulletsToDrawList(gameState.world.player->GetBullets());
+
+    // the player also draws its bars, crosshair and powerups so it is never culled
+    gameState.drawList.Add(gameState.world.player, DRAW_LAYER_PLAYER, false);
+    gameState.drawList.Draw();
+    AddCounter(COUNTER_DRAW_BATCHES, gameState.drawList.GetBatchCount());
+    AddCounter(COUNTER_SPRITES, gameState.drawList.GetVisibleCount());
+
+    EndMode2D();
+}
+
 void DrawFrame()
 {
+    const int64_t drawStart = GetRecorderTime();
     BeginDrawing();
     ClearBackground(BACKGROUND_COLOR);
 
     if (gameState.currentScreen != EXITING && gameState.currentScreen != LOADING)
     {
-        // draw background centered
-        DrawTexture(*gameState.spaceBackground, (int)(GetScreenWidth() - gameState.spaceBackground->width) / 2, (int)(GetScreenHeight() - gameState.spaceBackground->height) / 2, WHITE);
+        if (IsGamePaused())
+        {
+            // the world doesn't change while paused, draw it once to a texture and reuse it behind the menus
+            if (!gameState.worldCacheValid)
+            {
+                if (gameState.worldCache.texture.width != GetScreenWidth() || gameState.worldCache.texture.height != GetScreenHeight())
+                {
+                    if (gameState.worldCache.id != 0)
+                    {
+                        UnloadRenderTexture(gameState.worldCache);
+                    }
+                    gameState.worldCache = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+                }
 
-        BeginMode2D(gameState.player->GetCamera());
+                BeginTextureMode(gameState.worldCache);
+                ClearBackground(BACKGROUND_COLOR);
+                DrawWorld();
+                EndTextureMode();
+                gameState.worldCacheValid = true;
+            }
 
-        for (size_t i = 0; i < gameState.gameObjects.size(); i++)
+            // render textures are flipped vertically
+            const Texture2D *cache = &gameState.worldCache.texture;
+            DrawTextureRec(*cache, {0, 0, (float)cache->width, -(float)cache->height}, {0, 0}, WHITE);
+        }
+        else
         {
-            gameState.gameObjects[i]->Draw();
+            // the world is drawn smaller when the gpu can't keep up, the ui stays at the screen resolution
+            gameState.worldCacheValid = false;
+            gameState.resolution.Begin(BACKGROUND_COLOR);
+            DrawWorld(fminf(gameState.resolution.GetScale(), 1.0f));
+            gameState.resolution.End();
         }
-        gameState.player->Draw();
-
-        EndMode2D();
     }
 
     if (gameState.screens[gameState.currentScreen] != nullptr)
     {
+        RECORDER_ZONE("UI Draw");
         gameState.screens[gameState.currentScreen]->Draw();
     }
 
     if (SHOW_DEBUG)
     {
+        RECORDER_ZONE("DrawDebug");
         DrawDebug();
     }
 
+    // the time spent in EndDrawing is mostly waiting (vsync, target fps or input events)
+    const double busyTime = GetTime() - gameState.idle.frameStart;
+    gameState.idle.busyTime += busyTime;
+    UpdateFrameGovernor(busyTime);
+    RecordZone("DrawFrame", drawStart, GetRecorderTime());
+    EndCountersFrame();
+    EndRecorderFrame();
+
+    const int64_t endDrawingStart = GetRecorderTime();
     EndDrawing();
+    const int64_t endDrawingEnd = GetRecorderTime();
+    RecordZone("EndDrawing", endDrawingStart, endDrawingEnd);
+    UpdateDynamicResolution(busyTime, (endDrawingEnd - endDrawingStart) / 1e9);
 }
 
 // for debug purposes
@@ -346,15 +521,12 @@ void DrawDebug()
         gameState.screens[LOADING]->DrawDebug();
         return;
     }
-    if (gameState.currentScreen == GAME || gameState.currentScreen == GAME_OVER)
+    if ((gameState.currentScreen == GAME || gameState.currentScreen == GAME_OVER) && gameState.governor.GetSettings().objectDebug)
     {
-        BeginMode2D(gameState.player->GetCamera());
+        BeginMode2D(gameState.world.player->GetCamera());
 
-        gameState.player->DrawDebug();
-        for (size_t i = 0; i < gameState.gameObjects.size(); i++)
-        {
-            gameState.gameObjects[i]->DrawDebug();
-        }
+        // same culling as the draw list, hitboxes and labels of objects outside the view are skipped
+        gameState.drawList.DrawDebug();
 
         EndMode2D();
     }
@@ -372,39 +544,143 @@ void DrawDebug()
 
     DrawText(TextFormat("Powerup to spawn: %s", PowerUp::GetPowerUpName(powerupToSpawn)), 400, GetScreenHeight() - 40, 20, WHITE);
 
-    DrawText(TextFormat("Asteroids: %d", gameState.asteroidsCount), 10, GetScreenHeight() - 40, 20, WHITE);
-    DrawText(TextFormat("Shooters: %d", gameState.shootersCount), 10, GetScreenHeight() - 60, 20, WHITE);
-    DrawText(TextFormat("Stalkers: %d", gameState.stalkersCount), 10, GetScreenHeight() - 80, 20, WHITE);
-    DrawText(TextFormat("Pulsers: %d", gameState.pulsersCount), 10, GetScreenHeight() - 100, 20, WHITE);
-
-    DrawText(TextFormat("Spawn timer: %.2f", gameState.spawnTimer), 10, GetScreenHeight() - 120, 20, WHITE);
-    DrawText(TextFormat("Spawn rate: %.2f", gameState.diffSettings.spawnRate), 10, GetScreenHeight() - 140, 20, WHITE);
-    DrawText(TextFormat("Asteroids spawn chance: %.2f", gameState.diffSettings.asteroidsSpawnChance), 10, GetScreenHeight() - 160, 20, WHITE);
-    DrawText(TextFormat("Enemies spawn chance: %.2f", gameState.diffSettings.enemiesSpawnChance), 10, GetScreenHeight() - 180, 20, WHITE);
-    DrawText(TextFormat("Powerup spawn chance: %.2f", gameState.diffSettings.powerupSpawnChance), 10, GetScreenHeight() - 200, 20, WHITE);
-    DrawText(TextFormat("Asteroid speed multiplier: %.2f", gameState.diffSettings.asteroidSpeedMultiplier), 10, GetScreenHeight() - 220, 20, WHITE);
-    DrawText(TextFormat("Score multiplier: %.2f", gameState.diffSettings.scoreMultiplier), 10, GetScreenHeight() - 240, 20, WHITE);
-    DrawText(TextFormat("Enemies velocity multiplier: %.2f", gameState.diffSettings.enemiesAttributes.velocityMultiplier), 10, GetScreenHeight() - 260, 20, WHITE);
-    DrawText(TextFormat("Enemies precision: %.2f", gameState.diffSettings.enemiesAttributes.precision), 10, GetScreenHeight() - 280, 20, WHITE);
-    DrawText(TextFormat("Enemies fire rate multiplier: %.2f", gameState.diffSettings.enemiesAttributes.fireRateMultiplier), 10, GetScreenHeight() - 300, 20, WHITE);
-    DrawText(TextFormat("Enemies bullet speed multiplier: %.2f", gameState.diffSettings.enemiesAttributes.bulletSpeedMultiplier), 10, GetScreenHeight() - 320, 20, WHITE);
-    DrawText(TextFormat("Enemies prob of shooting at player: %.2f", gameState.diffSettings.enemiesAttributes.probOfShootingAtPlayer), 10, GetScreenHeight() - 340, 20, WHITE);
-    DrawText(TextFormat("Enemies bullets per shot: %d", gameState.diffSettings.enemiesAttributes.bulletsPerShot), 10, GetScreenHeight() - 360, 20, WHITE);
-
-    DrawText(TextFormat("Max asteroids: %d", gameState.diffSettings.maxAsteroids), 10, GetScreenHeight() - 380, 20, WHITE);
-    DrawText(TextFormat("Max shooters: %d", gameState.diffSettings.maxShooters), 10, GetScreenHeight() - 400, 20, WHITE);
-    DrawText(TextFormat("Max stalkers: %d", gameState.diffSettings.maxStalkers), 10, GetScreenHeight() - 420, 20, WHITE);
-    DrawText(TextFormat("Max pulsers: %d", gameState.diffSettings.maxPulsers), 10, GetScreenHeight() - 440, 20, WHITE);
-    DrawText(TextFormat("Max enemies: %d", gameState.diffSettings.maxEnemies), 10, GetScreenHeight() - 460, 20, WHITE);
+    int sleepingCount = 0;
+    for (size_t i = 0; i < gameState.world.gameObjects.size(); i++)
+    {
+        sleepingCount += gameState.world.gameObjects[i]->IsSleeping();
+    }
+
+    DrawText(TextFormat("Asteroids: %d", gameState.world.asteroidsCount), 10, GetScreenHeight() - 40, 20, WHITE);
+    DrawText(TextFormat("Shooters: %d", gameState.world.shootersCount), 10, GetScreenHeight() - 60, 20, WHITE);
+    DrawText(TextFormat("Stalkers: %d", gameState.world.stalkersCount), 10, GetScreenHeight() - 80, 20, WHITE);
+    DrawText(TextFormat("Pulsers: %d", gameState.world.pulsersCount), 10, GetScreenHeight() - 100, 20, WHITE);
+    DrawText(TextFormat("Orphan bullets: %d", (int)gameState.world.orphanBullets.size()), 200, GetScreenHeight() - 40, 20, WHITE);
+    DrawText(TextFormat("Visible: %d/%d", gameState.drawList.GetVisibleCount(), gameState.drawList.GetTotalCount()), 200, GetScreenHeight() - 60, 20, WHITE);
+    DrawText(TextFormat("Submitted: %d, culled: %d, batches: %d", gameState.drawList.GetVisibleCount(), gameState.drawList.GetCulledCount(), gameState.drawList.GetBatchCount()), 200, GetScreenHeight() - 80, 20, WHITE);
+    DrawText(TextFormat("Batched bullets: %d", gameState.drawList.GetBulletCount()), 200, GetScreenHeight() - 100, 20, WHITE);
+    DrawText(TextFormat("World: %s", IsGamePaused() && gameState.worldCacheValid ? "cached" : "live"), 200, GetScreenHeight() - 120, 20, WHITE);
+    DrawText(TextFormat("Resolution: %.0f%% (%s), %dx%d, cpu %.1f ms, gpu %.1f ms", gameState.resolution.GetScale() * 100, gameState.resolution.GetFixedScale() > 0 ? "fixed" : "auto",
+                        (int)(GetScreenWidth() * gameState.resolution.GetScale()), (int)(GetScreenHeight() * gameState.resolution.GetScale()), gameState.resolution.GetCpuTime() * 1000, gameState.resolution.GetGpuTime() * 1000),
+             200, GetScreenHeight() - 380, 20, WHITE);
+    DrawText(TextFormat("Busy: %.1f%% (%s)", gameState.idle.busyPercent, gameState.idle.waitingEvents ? "waiting events" : "running"), 200, GetScreenHeight() - 140, 20, WHITE);
+    DrawText(TextFormat("SIMD: %s", GetSimdBackendName(GetSimdBackend())), 200, GetScreenHeight() - 160, 20, WHITE);
+    DrawText(TextFormat("Bullet tests: %d/%d", gameState.world.bulletGrid.GetTestedCount(), gameState.world.bulletPairs), 200, GetScreenHeight() - 180, 20, WHITE);
+    DrawText(TextFormat("Contacts: %d, hit rate: %.0f%%, axes: %d", gameState.world.contactCache.GetContactCount(), gameState.world.contactCache.GetHitRate(), gameState.world.contactCache.GetAxesTested()), 200, GetScreenHeight() - 200, 20, WHITE);
+    DrawText(TextFormat("Solved contacts: %d, sleeping: %d", gameState.world.contactSolver.GetContactCount(), sleepingCount), 200, GetScreenHeight() - 220, 20, WHITE);
+    DrawText(TextFormat("Broadphase: %d objects, %d ghosts, %d pairs", gameState.world.broadphase.GetObjectCount(), gameState.world.broadphase.GetGhostCount(), gameState.world.broadphase.GetPairCount()), 200, GetScreenHeight() - 240, 20, WHITE);
+    DrawText(TextFormat("Timers: %d pending, %d fired", gameState.world.timers.GetActiveCount(), gameState.world.timers.GetFiredCount()), 200, GetScreenHeight() - 260, 20, WHITE);
+    DrawText(TextFormat("AI: %d/%d due enemies thought, budget %d", gameState.world.aiScheduler.GetThinkCount(), gameState.world.aiScheduler.GetDueCount(), gameState.world.aiScheduler.GetBudget()), 200, GetScreenHeight() - 280, 20, WHITE);
+    DrawText(TextFormat("Flow field: %d cells, %d agents", gameState.world.flowField.GetCellCount(), gameState.world.flowField.GetAgentCount()), 200, GetScreenHeight() - 300, 20, WHITE);
+    DrawText(TextFormat("Brains: %d enemies, %d transitions", gameState.world.enemyBrains.GetCount(), gameState.world.enemyBrains.GetTransitionCount()), 200, GetScreenHeight() - 320, 20, WHITE);
+    DrawText(TextFormat("Seed: %llu", (unsigned long long)gameState.world.seed), 200, GetScreenHeight() - 340, 20, WHITE);
+    DrawText(TextFormat("Snapshot: %.1f KB, capture %.0f us, restore %.0f us, rewind %d/%d", gameState.snapshotSize / 1024.0f, gameState.snapshotCaptureTime * 1e6, gameState.snapshotRestoreTime * 1e6, gameState.rewind.GetCount(), gameState.rewind.GetCapacity()), 200, GetScreenHeight() - 360, 20, WHITE);
+
+    DrawText(TextFormat("Spawn timer: %.2f", gameState.world.spawnTimer), 10, GetScreenHeight() - 120, 20, WHITE);
+    DrawText(TextFormat("Spawn rate: %.2f", gameState.world.diffSettings.spawnRate), 10, GetScreenHeight() - 140, 20, WHITE);
+    DrawText(TextFormat("Asteroids spawn chance: %.2f", gameState.world.diffSettings.asteroidsSpawnChance), 10, GetScreenHeight() - 160, 20, WHITE);
+    DrawText(TextFormat("Enemies spawn chance: %.2f", gameState.world.diffSettings.enemiesSpawnChance), 10, GetScreenHeight() - 180, 20, WHITE);
+    DrawText(TextFormat("Powerup spawn chance: %.2f", gameState.world.diffSettings.powerupSpawnChance), 10, GetScreenHeight() - 200, 20, WHITE);
+    DrawText(TextFormat("Asteroid speed multiplier: %.2f", gameState.world.diffSettings.asteroidSpeedMultiplier), 10, GetScreenHeight() - 220, 20, WHITE);
+    DrawText(TextFormat("Score multiplier: %.2f", gameState.world.diffSettings.scoreMultiplier), 10, GetScreenHeight() - 240, 20, WHITE);
+    DrawText(TextFormat("Enemies velocity multiplier: %.2f", gameState.world.diffSettings.enemiesAttributes.velocityMultiplier), 10, GetScreenHeight() - 260, 20, WHITE);
+    DrawText(TextFormat("Enemies precision: %.2f", gameState.world.diffSettings.enemiesAttributes.precision), 10, GetScreenHeight() - 280, 20, WHITE);
+    DrawText(TextFormat("Enemies fire rate multiplier: %.2f", gameState.world.diffSettings.enemiesAttributes.fireRateMultiplier), 10, GetScreenHeight() - 300, 20, WHITE);
+    DrawText(TextFormat("Enemies bullet speed multiplier: %.2f", gameState.world.diffSettings.enemiesAttributes.bulletSpeedMultiplier), 10, GetScreenHeight() - 320, 20, WHITE);
+    DrawText(TextFormat("Enemies prob of shooting at player: %.2f", gameState.world.diffSettings.enemiesAttributes.probOfShootingAtPlayer), 10, GetScreenHeight() - 340, 20, WHITE);
+    DrawText(TextFormat("Enemies bullets per shot: %d", gameState.world.diffSettings.enemiesAttributes.bulletsPerShot), 10, GetScreenHeight() - 360, 20, WHITE);
+
+    DrawText(TextFormat("Max asteroids: %d", gameState.world.diffSettings.maxAsteroids), 10, GetScreenHeight() - 380, 20, WHITE);
+    DrawText(TextFormat("Max shooters: %d", gameState.world.diffSettings.maxShooters), 10, GetScreenHeight() - 400, 20, WHITE);
+    DrawText(TextFormat("Max stalkers: %d", gameState.world.diffSettings.maxStalkers), 10, GetScreenHeight() - 420, 20, WHITE);
+    DrawText(TextFormat("Max pulsers: %d", gameState.world.diffSettings.maxPulsers), 10, GetScreenHeight() - 440, 20, WHITE);
+    DrawText(TextFormat("Max enemies: %d", gameState.world.diffSettings.maxEnemies), 10, GetScreenHeight() - 460, 20, WHITE);
+
+    if (gameState.debugPage == DEBUG_PAGE_COUNTERS)
+    {
+        DrawCountersDebug(GetScreenWidth() - 340, 40);
+    }
+    else if (gameState.debugPage == DEBUG_PAGE_MEMORY)
+    {
+        DrawMemoryDebug(GetScreenWidth() - 520, 40);
+    }
+}
+
+void DrawCountersDebug(int x, int y)
+{
+    // counters of the last frame and since the game started
+    DrawText("Counter (F4)", x, y, 20, YELLOW);
+    DrawText("Frame", x + 170, y, 20, YELLOW);
+    DrawText("Total", x + 250, y, 20, YELLOW);
+    for (int i = 0; i < NUM_COUNTERS; i++)
+    {
+        const int rowY = y + 20 + i * 20;
+        DrawText(GetCounterName((CounterID)i), x, rowY, 20, WHITE);
+        DrawText(TextFormat("%llu", (unsigned long long)GetCounterFrameValue((CounterID)i)), x + 170, rowY, 20, WHITE);
+        DrawText(TextFormat("%llu", (unsigned long long)GetCounterTotal((CounterID)i)), x + 250, rowY, 20, WHITE);
+    }
+
+    // what the frame governor is shedding, yellow once it sheds anything
+    FrameGovernor *governor = &gameState.governor;
+    const GovernorSettings settings = governor->GetSettings();
+    const Color color = governor->GetLevel() > 0 ? YELLOW : WHITE;
+    const int governorY = y + 40 + NUM_COUNTERS * 20;
+    DrawText(TextFormat("Governor: %s, level %d/%d, %d changes", governor->IsEnabled() ? "on" : "off", governor->GetLevel(), GOVERNOR_MAX_LEVEL, governor->GetChangeCount()), x, governorY, 20, color);
+    DrawText(TextFormat("Busy %.1f ms, target %.1f ms", governor->GetSmoothedTime() * 1000, governor->GetTargetTime() * 1000), x, governorY + 20, 20, color);
+    DrawText(TextFormat("Entities %.0f%%, sounds %s", settings.entityBudget * 100, settings.soundBudget < 0 ? "all" : TextFormat("%d/frame", settings.soundBudget)), x, governorY + 40, 20, color);
+    DrawText(TextFormat("Explosions %s, object debug %s", settings.explosions ? "on" : "off", settings.objectDebug ? "on" : "off"), x, governorY + 60, 20, color);
+}
+
+void DrawMemoryDebug(int x, int y)
+{
+    MemoryReport report = {0};
+    GetGameMemoryUsage(&report);
+
+    // MB used and budgets, categories over their budget in red
+    DrawText(TextFormat("Memory (F4), budgets %s", AreMemoryBudgetsEnabled() ? "on" : "off"), x, y, 20, YELLOW);
+    DrawText("CPU", x + 170, y + 20, 20, YELLOW);
+    DrawText("GPU", x + 270, y + 20, 20, YELLOW);
+    DrawText("Budget", x + 370, y + 20, 20, YELLOW);
+    for (int i = 0; i < NUM_MEMORY_CATEGORIES; i++)
+    {
+        const MemoryCategory category = (MemoryCategory)i;
+        const MemoryUsage usage = report.categories[i];
+        const MemoryUsage budget = GetMemoryBudget(category);
+        const Color color = IsOverMemoryBudget(&report, category) ? RED : WHITE;
+        const int rowY = y + 40 + i * 20;
+        DrawText(GetMemoryCategoryName(category), x, rowY, 20, color);
+        DrawText(TextFormat("%.2f", (float)usage.cpu / MEMORY_MB), x + 170, rowY, 20, color);
+        DrawText(TextFormat("%.2f", (float)usage.gpu / MEMORY_MB), x + 270, rowY, 20, color);
+        DrawText(TextFormat("%.0f/%.0f", (float)budget.cpu / MEMORY_MB, (float)budget.gpu / MEMORY_MB), x + 370, rowY, 20, color);
+    }
+    const MemoryUsage total = GetTotalMemoryUsage(&report);
+    const int totalY = y + 40 + NUM_MEMORY_CATEGORIES * 20;
+    DrawText("total", x, totalY, 20, YELLOW);
+    DrawText(TextFormat("%.2f", (float)total.cpu / MEMORY_MB), x + 170, totalY, 20, YELLOW);
+    DrawText(TextFormat("%.2f", (float)total.gpu / MEMORY_MB), x + 270, totalY, 20, YELLOW);
 }
 
 void HandleInput()
 {
+    RECORDER_ZONE("HandleInput");
     if (IsKeyPressed(KEY_F11))
     {
         ToggleGameFullscreen();
     }
 
+#ifndef PLATFORM_WEB
+    if (IsKeyPressed(KEY_F8))
+    {
+        if (IsCapturingTrace())
+        {
+            StopTraceCapture();
+        }
+        else
+        {
+            StartTraceCapture(TextFormat(TRACE_CAPTURE_FILE, ++traceCaptures));
+        }
+    }
+#endif // PLATFORM_WEB
+
     if (IsKeyPressed(KEY_ESCAPE))
     {
         if (gameState.currentScreen == GAME)
@@ -441,7 +717,28 @@ void HandleInput()
     }
     if (IsKeyPressed(KEY_L))
     {
-        UpdateDifficultySettings((Difficulty)((gameState.diffSettings.difficulty + 1) % NUM_DIFFICULTIES));
+        gameState.world.UpdateDifficultySettings((Difficulty)((gameState.world.diffSettings.difficulty + 1) % NUM_DIFFICULTIES));
+    }
+    if (IsKeyPressed(KEY_BACKSPACE))
+    {
+        // each press goes SNAPSHOT_REWIND_INTERVAL further back
+        GameSnapshot *snapshot = gameState.rewind.Pop();
+        if (snapshot != nullptr)
+        {
+            RestoreGame(snapshot);
+        }
+    }
+    if (IsKeyPressed(KEY_F4))
+    {
+        gameState.debugPage = (DebugPage)((gameState.debugPage + 1) % NUM_DEBUG_PAGES);
+    }
+    if (IsKeyPressed(KEY_F6))
+    {
+        SaveGameSnapshot(SNAPSHOT_FILE);
+    }
+    if (IsKeyPressed(KEY_F9))
+    {
+        LoadGameSnapshot(SNAPSHOT_FILE);
     }
 
     if (IsKeyDown(KEY_LEFT_SHIFT))
@@ -474,52 +771,57 @@ void HandleInput()
     // spawn an asteroid
     if (IsKeyPressed(KEY_X))
     {
-        gameState.gameObjects.push_back(new Asteroid((AsteroidVariant)GetRandomValue(0, 1), gameState.diffSettings.asteroidSpeedMultiplier));
-        gameState.asteroidsCount++;
+        gameState.world.gameObjects.push_back(new Asteroid((AsteroidVariant)GetGameRng(RNG_ASTEROIDS)->GetInt(0, 1), gameState.world.diffSettings.asteroidSpeedMultiplier));
+        gameState.world.asteroidsCount++;
+
+        // the paused world is drawn again, its draw list is also used by the debug overlay and must not keep freed objects
+        gameState.worldCacheValid = false;
     }
     // spawn an enemy
     if (IsKeyPressed(KEY_C))
     {
         if (IsKeyDown(KEY_LEFT_SHIFT))
         {
-            gameState.gameObjects.push_back(new Pulser(gameState.player, gameState.diffSettings.enemiesAttributes));
-            gameState.pulsersCount++;
+            gameState.world.gameObjects.push_back(new Enemy(gameState.world.player, gameState.world.diffSettings.enemiesAttributes, PULSER));
+            gameState.world.pulsersCount++;
         }
         else
         {
-            gameState.gameObjects.push_back(new Stalker(gameState.player, gameState.diffSettings.enemiesAttributes));
-            gameState.shootersCount++;
+            gameState.world.gameObjects.push_back(new Enemy(gameState.world.player, gameState.world.diffSettings.enemiesAttributes, STALKER));
+            gameState.world.shootersCount++;
         }
+        gameState.worldCacheValid = false;
     }
     // spawn the selected powerup in the mouse position
     if (IsKeyPressed(KEY_V))
     {
-        if (gameState.powerupSpawned)
+        if (gameState.world.powerupSpawned)
         {
-            auto powerup = std::find_if(gameState.gameObjects.begin(), gameState.gameObjects.end(), [](GameObject *obj)
+            auto powerup = std::find_if(gameState.world.gameObjects.begin(), gameState.world.gameObjects.end(), [](GameObject *obj)
                                         { return obj->GetType() == POWER_UP; });
-            if (powerup != gameState.gameObjects.end())
+            if (powerup != gameState.world.gameObjects.end())
             {
                 delete *powerup;
-                gameState.gameObjects.erase(powerup);
+                gameState.world.gameObjects.erase(powerup);
             }
         }
-        gameState.gameObjects.push_back(new PowerUp(GetScreenToWorld2D(GetMousePosition(), gameState.player->GetCamera()), powerupToSpawn));
-        gameState.powerupSpawned = true;
+        gameState.world.gameObjects.push_back(new PowerUp(GetScreenToWorld2D(GetMousePosition(), gameState.world.player->GetCamera()), powerupToSpawn));
+        gameState.world.powerupSpawned = true;
+        gameState.worldCacheValid = false;
     }
 
     if (IsKeyPressed(KEY_KP_ADD))
     {
-        gameState.player->AddLife();
+        gameState.world.player->AddLife();
     }
     if (IsKeyPressed(KEY_KP_SUBTRACT))
     {
-        gameState.player->Kill();
+        gameState.world.player->Kill();
     }
 
     if (IsKeyPressed(KEY_P))
     {
-        gameState.player->ToggleDirectionalShip();
+        gameState.world.player->ToggleDirectionalShip();
     }
 
     if (GetMouseWheelMove() > 0)
@@ -534,23 +836,23 @@ void HandleInput()
     // moving objects with mouse
     static GameObject *movingObject = nullptr;
 
-    Vector2 mouseWorldPos = GetScreenToWorld2D(GetMousePosition(), gameState.player->GetCamera());
+    Vector2 mouseWorldPos = GetScreenToWorld2D(GetMousePosition(), gameState.world.player->GetCamera());
 
-    if (gameState.player != nullptr && CheckCollisionPointRec(mouseWorldPos, gameState.player->GetBounds()))
+    if (gameState.world.player != nullptr && CheckCollisionPointRec(mouseWorldPos, gameState.world.player->GetBounds()))
     {
         if (movingObject == nullptr && IsKeyDown(KEY_LEFT_CONTROL) && IsMouseButtonDown(MOUSE_LEFT_BUTTON))
         {
-            movingObject = gameState.player;
+            movingObject = gameState.world.player;
         }
     }
 
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
+    for (size_t i = 0; i < gameState.world.gameObjects.size(); i++)
     {
-        if (CheckCollisionPointRec(mouseWorldPos, gameState.gameObjects[i]->GetBounds()))
+        if (CheckCollisionPointRec(mouseWorldPos, gameState.world.gameObjects[i]->GetBounds()))
         {
             if (movingObject == nullptr && IsKeyDown(KEY_LEFT_CONTROL) && (IsMouseButtonDown(MOUSE_LEFT_BUTTON) || IsMouseButtonDown(MOUSE_RIGHT_BUTTON)))
             {
-                movingObject = gameState.gameObjects[i];
+                movingObject = gameState.world.gameObjects[i];
             }
         }
     }
@@ -570,274 +872,132 @@ void HandleInput()
         if (IsMouseButtonDown(MOUSE_RIGHT_BUTTON))
         {
             movingObject->SetVelocity(Vector2Scale(GetMouseDelta(), 0.4f / GetFrameTime()));
-            movingObject->SetAngularVelocity(GetRandomValue(-180, 180));
+            movingObject->SetAngularVelocity(GetGameRng(RNG_ASTEROIDS)->GetInt(-180, 180));
         }
     }
 
 #endif // _DEBUG
 }
 
-void UpdateGameObjects()
+void UpdateFrameGovernor(double busyTime)
 {
-    const float scoreMultiplier = gameState.diffSettings.scoreMultiplier;
-
-    if (gameState.currentScreen == GAME || gameState.currentScreen == GAME_OVER)
+    // menus, pauses and the frame after waiting for events don't tell how heavy the world is
+    if (gameState.currentScreen == GAME && !IsGamePaused() && !gameState.idle.waitingEvents)
     {
-        gameState.player->Update();
+        // a long frame is a wait (event waiting, a dragged window), it's only counted as a slow frame
+        gameState.governor.Update((float)busyTime, fminf(GetFrameTime(), 1.0f / UNFOCUSED_FPS), gameState.idle.targetFPS);
     }
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
-    {
-        gameState.gameObjects[i]->Update();
 
-        if (gameState.gameObjects[i]->GetType() == ASTEROID)
-        {
-            Asteroid *asteroid = (Asteroid *)gameState.gameObjects[i];
-            if (asteroid->IsDestroyed())
-            {
-                if (gameState.player->GetLives() > 0)
-                {
-                    AddScore(asteroid->GetVariant() == LARGE ? LARGE_ASTEROID_DESTROYED : SMALL_ASTEROID_DESTROYED, scoreMultiplier);
-                }
-                delete asteroid;
-                gameState.gameObjects.erase(gameState.gameObjects.begin() + i);
-                gameState.asteroidsCount--;
-            }
-        }
-        else if (gameState.gameObjects[i]->GetType() == ENEMY)
-        {
-            Shooter *enemy = (Shooter *)gameState.gameObjects[i];
-            if (enemy->IsDead() && enemy->GetBullets()->size() == 0)
-            {
-                if (gameState.player->GetLives() > 0)
-                {
-                    // ScoreType enum enemies start at 11 with the same order as the EnemyType enum
-                    AddScore((ScoreType)((int)enemy->GetEnemyType() + 11), scoreMultiplier);
-                }
-                if (enemy->GetEnemyType() == SHOOTER)
-                {
-                    gameState.shootersCount--;
-                }
-                else if (enemy->GetEnemyType() == STALKER)
-                {
-                    gameState.stalkersCount--;
-                }
-                else if (enemy->GetEnemyType() == PULSER)
-                {
-                    gameState.pulsersCount--;
-                }
-                delete enemy;
-                gameState.gameObjects.erase(gameState.gameObjects.begin() + i);
-            }
-        }
-        else if (gameState.gameObjects[i]->GetType() == POWER_UP)
-        {
-            PowerUp *powerup = (PowerUp *)gameState.gameObjects[i];
-            if (powerup->IsExpired())
-            {
-                delete powerup;
-                gameState.gameObjects.erase(gameState.gameObjects.begin() + i);
-                gameState.powerupSpawned = false;
-            }
-            else if (powerup->IsPickedUp())
-            {
-                AddScore((ScoreType)powerup->GetType(), scoreMultiplier);
-                gameState.gameObjects.erase(gameState.gameObjects.begin() + i);
-                gameState.powerupSpawned = false;
-            }
-        }
-    }
-    gameState.gameObjects.shrink_to_fit();
+    const GovernorSettings settings = gameState.governor.GetSettings();
+    gameState.world.entityBudget = settings.entityBudget;
+    ResourceManager::SetSoundBudget(settings.soundBudget);
+}
 
-    gameState.player->CleanBullets();
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
+void UpdateDynamicResolution(double cpuTime, double gpuTime)
+{
+    // same frames as the frame governor, the ones of the game being played
+    if (gameState.currentScreen == GAME && !IsGamePaused() && !gameState.idle.waitingEvents)
     {
-        if (gameState.gameObjects[i]->GetType() == ENEMY)
-        {
-            Shooter *enemy = (Shooter *)gameState.gameObjects[i];
-            enemy->CleanBullets();
-        }
+        gameState.resolution.Update((float)cpuTime, (float)gpuTime, gameState.idle.targetFPS);
     }
 }
 
-void HandleCollisions()
+void ChangeResolutionScale()
 {
-    Vector2 pushVector = {0, 0};
-    auto bullets = gameState.player->GetBullets();
+    static const float scales[] = {0, 1.0f, 0.75f, 0.5f};
+    static int scaleIndex = 0;
+    scaleIndex = (scaleIndex + 1) % (sizeof(scales) / sizeof(float));
+    gameState.resolution.SetFixedScale(scales[scaleIndex]);
+}
 
-    // check collisions between gameState.player and all main game objects
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
-    {
-        if (gameState.player->CheckCollision(gameState.gameObjects[i], &pushVector))
-        {
-            gameState.player->HandleCollision(gameState.gameObjects[i], &pushVector);
-            pushVector = Vector2Negate(pushVector);
-            gameState.gameObjects[i]->HandleCollision(gameState.player, &pushVector);
-        }
-        for (size_t j = 0; j < gameState.gameObjects.size(); j++)
-        {
-            if (i < j) // check each pair only once
-            {
-                if (gameState.gameObjects[i]->CheckCollision(gameState.gameObjects[j], &pushVector))
-                {
-                    gameState.gameObjects[i]->HandleCollision(gameState.gameObjects[j], &pushVector);
-                    pushVector = Vector2Negate(pushVector);
-                    gameState.gameObjects[j]->HandleCollision(gameState.gameObjects[i], &pushVector);
-                }
-            }
-        }
-    }
+void UpdateIdleMode()
+{
+    RECORDER_ZONE("UpdateIdleMode");
+    IdleState *idle = &gameState.idle;
+
+#ifdef PLATFORM_DESKTOP
+    const bool minimized = IsWindowMinimized();
+    const bool focused = IsWindowFocused() && !minimized;
 
-    // check collision between bullets and all main game objects
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
+    // nothing changes while paused or minimized, so the next frame is only produced when an event arrives
+    const bool waitEvents = minimized || IsGamePaused();
+    if (waitEvents != idle->waitingEvents)
     {
-        // player bullets
-        for (size_t b = 0; b < bullets->size(); b++)
+        idle->waitingEvents = waitEvents;
+        if (waitEvents)
         {
-            if ((*bullets)[b].CheckCollision(gameState.gameObjects[i], &pushVector))
-            {
-                // (*bullets)[b].HandleCollision(gameState.gameObjects[i], &pushVector);
-                gameState.player->HandleBulletCollision(&(*bullets)[b], gameState.gameObjects[i], &pushVector);
-                pushVector = Vector2Negate(pushVector);
-                gameState.gameObjects[i]->HandleCollision(&(*bullets)[b], &pushVector);
-            }
+            EnableEventWaiting();
         }
-
-        // enemy bullets
-        if (gameState.gameObjects[i]->GetType() == ENEMY)
+        else
         {
-            Shooter *enemy = (Shooter *)gameState.gameObjects[i];
-            auto enemyBullets = enemy->GetBullets();
-            for (size_t b = 0; b < enemyBullets->size(); b++)
-            {
-                if ((*enemyBullets)[b].CheckCollision(gameState.player, &pushVector))
-                {
-                    (*enemyBullets)[b].HandleCollision(gameState.player, &pushVector);
-                    pushVector = Vector2Negate(pushVector);
-                    gameState.player->HandleCollision(&(*enemyBullets)[b], &pushVector);
-                }
-            }
+            DisableEventWaiting();
+            idle->skipNextUpdate = true;
         }
+        TraceLog(LOG_INFO, "IDLE: %s (busy %.1f%% of the last second)", waitEvents ? "Waiting for input events" : "Running", idle->busyPercent);
     }
-}
 
-void TryToSpawnObject(GameObjectType type)
-{
-    if (gameState.spawnTimer > 0.0f)
+    // the world keeps moving behind the main menu, but it can do it at a lower rate while not focused
+    const int targetFPS = focused ? gameState.fps : UNFOCUSED_FPS;
+    if (targetFPS != idle->targetFPS)
     {
-        return;
-    }
-
-    float spawnChance = 0.0f;
-    switch (type)
-    {
-    case ASTEROID:
-        spawnChance = gameState.asteroidsCount == gameState.diffSettings.maxAsteroids
-                          ? 0.0f
-                          : gameState.diffSettings.asteroidsSpawnChance;
-        break;
-
-    case ENEMY:
-        spawnChance = gameState.shootersCount + gameState.stalkersCount + gameState.pulsersCount == gameState.diffSettings.maxEnemies
-                          ? 0.0f
-                          : gameState.diffSettings.enemiesSpawnChance;
-        break;
-    case POWER_UP:
-        spawnChance = gameState.powerupSpawned
-                          ? 0.0f
-                          : gameState.diffSettings.powerupSpawnChance;
-        break;
-    default:
-        return;
-    }
-
-    if (GetRandomValue(0, 100) >= spawnChance * 100)
-    {
-        return;
+        idle->targetFPS = targetFPS;
+        SetTargetFPS(targetFPS);
     }
+#endif // PLATFORM_DESKTOP
 
-    switch (type)
+    const double now = GetTime();
+    if (now - idle->sampleStart >= IDLE_SAMPLE_TIME)
     {
-    case ASTEROID:
-        gameState.gameObjects.push_back(new Asteroid(gameState.diffSettings.asteroidSpeedMultiplier));
-        gameState.asteroidsCount++;
-        break;
-    case ENEMY:
-    {
-
-        int enemyType = GetRandomValue(0, 2);
-        if (enemyType == 0 && gameState.stalkersCount < gameState.diffSettings.maxStalkers)
-        {
-            gameState.gameObjects.push_back(new Stalker(gameState.player, gameState.diffSettings.enemiesAttributes));
-            gameState.stalkersCount++;
-        }
-        else if (enemyType == 1 && gameState.shootersCount < gameState.diffSettings.maxShooters)
-        {
-            gameState.gameObjects.push_back(new Shooter(gameState.player, gameState.diffSettings.enemiesAttributes));
-            gameState.shootersCount++;
-        }
-        else if (enemyType == 2 && gameState.pulsersCount < gameState.diffSettings.maxPulsers)
-        {
-            gameState.gameObjects.push_back(new Pulser(gameState.player, gameState.diffSettings.enemiesAttributes));
-            gameState.pulsersCount++;
-        } // else don't spawn anything
-        break;
-    }
-    case POWER_UP:
-        gameState.gameObjects.push_back(new PowerUp());
-        gameState.powerupSpawned = true;
-        break;
-    default:
-        break;
+        idle->busyPercent = (float)(100.0 * idle->busyTime / (now - idle->sampleStart));
+        idle->busyTime = 0;
+        idle->sampleStart = now;
     }
 }
 
 void UpdateGame()
 {
-    if (gameState.currentScreen != PAUSE_MENU && !(gameState.previousScreen == PAUSE_MENU && gameState.currentScreen != GAME))
-    {
-        UpdateGameObjects();
+    RECORDER_ZONE("UpdateGame");
+    // after waiting for events, the frame time includes all the time waited
+    const bool skipSimulation = gameState.idle.skipNextUpdate;
+    gameState.idle.skipNextUpdate = false;
 
-        HandleCollisions();
+    if (!IsGamePaused() && !skipSimulation)
+    {
+        // the world only runs while the game isn't paused, so pausing delays its timers without any bookkeeping
+        const bool playing = gameState.currentScreen == GAME;
+        gameState.world.Step(GetFrameTime(), playing || gameState.currentScreen == GAME_OVER, playing);
 
-        if (gameState.currentScreen == GAME && gameState.player->IsAlive() && gameState.player->HasMoved())
+#ifdef _DEBUG
+        if (gameState.world.gameTime - gameState.lastRewindTime >= SNAPSHOT_REWIND_INTERVAL)
         {
-            TryToSpawnObject(ASTEROID);
-            TryToSpawnObject(ENEMY);
-            TryToSpawnObject(POWER_UP);
-
-            // this score is scaled relative to frame time
-            AddScore(TIME_ALIVE, 1.0f);
-
-            // update difficulty settings if the player has scored enough points
-            if (GetTotalScore() >= 50000 && gameState.diffSettings.difficulty == EASY)
-            {
-                UpdateDifficultySettings(MEDIUM);
-            }
-            else if (GetTotalScore() >= 100000 && gameState.diffSettings.difficulty == MEDIUM)
-            {
-                UpdateDifficultySettings(HARD);
-            }
+            CaptureGame(gameState.rewind.Push());
+            gameState.lastRewindTime = gameState.world.gameTime;
         }
+#endif // _DEBUG
 
         // game over
-        if (gameState.player->IsDead() && gameState.player->GetLives() <= 0)
+        if (gameState.world.IsOver())
         {
             ChangeScreen(GAME_OVER);
         }
+    }
 
-        // reset spawnTimer
-        if (gameState.spawnTimer <= 0.0f)
-        {
-            gameState.spawnTimer = gameState.diffSettings.spawnRate;
-        }
-        gameState.spawnTimer -= GetFrameTime();
+    if (AreMemoryBudgetsEnabled() && GetTime() - gameState.lastMemoryCheck >= MEMORY_CHECK_INTERVAL)
+    {
+        MemoryReport report = {0};
+        GetGameMemoryUsage(&report);
+        CheckMemoryBudgets(&report);
+        gameState.lastMemoryCheck = GetTime();
     }
 
     if (gameState.screens[gameState.currentScreen] == nullptr)
     {
         return;
     }
-    gameState.screens[gameState.currentScreen]->Update();
+    {
+        RECORDER_ZONE("UI Update");
+        gameState.screens[gameState.currentScreen]->Update();
+    }
     if (gameState.currentScreen == LOADING)
     {
         if (((RaylibLogo *)gameState.screens[LOADING])->IsDone())
@@ -856,10 +1016,16 @@ void UpdateGame()
 
 bool GameLoop()
 {
+    gameState.idle.frameStart = GetTime();
+    BeginRecorderFrame();
+
     HandleInput();
 
     UpdateGame();
 
+    // updated before drawing so event waiting is enabled/disabled in the same frame the game is paused/resumed
+    UpdateIdleMode();
+
     DrawFrame();
 
     if (gameState.currentScreen == EXITING)
@@ -879,13 +1045,7 @@ bool GameLoop()
 
 void ExitGame()
 {
-    delete gameState.player;
-
-    for (size_t i = 0; i < gameState.gameObjects.size(); i++)
-    {
-        delete gameState.gameObjects[i];
-    }
-    gameState.gameObjects.clear();
+    gameState.world.Clear();
 
     for (size_t i = 0; i < NUM_SCREENS; i++)
     {
@@ -899,6 +1059,14 @@ void ExitGame()
     {
         UnloadTexture(*gameState.spaceBackground);
     }
+    if (gameState.worldCache.id != 0)
+    {
+        UnloadRenderTexture(gameState.worldCache);
+        gameState.worldCache = {0};
+    }
+    gameState.resolution.Unload();
     ResourceManager::UnloadResources();
     CloseAudioDevice();
+
+    StopTraceCapture();
 }
@@ -0,0 +1,163 @@
+#include "game/game_snapshot.hpp"
+
+#include <string.h>
+#include <type_traits>
+
+typedef struct SnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size; // bytes after the header
+} SnapshotHeader;
+
+template <typename T>
+static void WriteArray(std::vector<unsigned char> *data, const std::vector<T> &array)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "snapshot records must be plain data");
+    const uint32_t count = array.size();
+    const size_t offset = data->size();
+    data->resize(offset + sizeof(count) + count * sizeof(T));
+    memcpy(data->data() + offset, &count, sizeof(count));
+    if (count > 0)
+    {
+        memcpy(data->data() + offset + sizeof(count), array.data(), count * sizeof(T));
+    }
+}
+
+template <typename T>
+static bool ReadArray(const unsigned char *data, size_t size, size_t *offset, std::vector<T> *array)
+{
+    uint32_t count;
+    if (*offset + sizeof(count) > size)
+    {
+        return false;
+    }
+    memcpy(&count, data + *offset, sizeof(count));
+    *offset += sizeof(count);
+    if (count > (size - *offset) / sizeof(T))
+    {
+        return false;
+    }
+    array->resize(count);
+    if (count > 0)
+    {
+        memcpy(array->data(), data + *offset, count * sizeof(T));
+    }
+    *offset += count * sizeof(T);
+    return true;
+}
+
+template <typename T>
+static size_t GetArraySize(const std::vector<T> &array)
+{
+    return sizeof(uint32_t) + array.size() * sizeof(T);
+}
+
+void ClearGameSnapshot(GameSnapshot *snapshot)
+{
+    snapshot->world = {0};
+    snapshot->objects.clear();
+    snapshot->hitboxPoints.clear();
+    snapshot->bullets.clear();
+    snapshot->players.clear();
+    snapshot->enemies.clear();
+    snapshot->asteroids.clear();
+    snapshot->powerups.clear();
+    snapshot->contacts.clear();
+}
+
+size_t GetGameSnapshotSize(const GameSnapshot *snapshot)
+{
+    return sizeof(SnapshotHeader) + sizeof(WorldRecord) +
+           GetArraySize(snapshot->objects) + GetArraySize(snapshot->hitboxPoints) + GetArraySize(snapshot->bullets) +
+           GetArraySize(snapshot->players) + GetArraySize(snapshot->enemies) + GetArraySize(snapshot->asteroids) +
+           GetArraySize(snapshot->powerups) + GetArraySize(snapshot->contacts);
+}
+
+void WriteGameSnapshot(const GameSnapshot *snapshot, std::vector<unsigned char> *data)
+{
+    const size_t size = GetGameSnapshotSize(snapshot);
+    data->clear();
+    data->reserve(size);
+
+    const SnapshotHeader header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, (uint32_t)(size - sizeof(SnapshotHeader))};
+    data->resize(sizeof(header) + sizeof(WorldRecord));
+    memcpy(data->data(), &header, sizeof(header));
+    memcpy(data->data() + sizeof(header), &snapshot->world, sizeof(WorldRecord));
+
+    WriteArray(data, snapshot->objects);
+    WriteArray(data, snapshot->hitboxPoints);
+    WriteArray(data, snapshot->bullets);
+    WriteArray(data, snapshot->players);
+    WriteArray(data, snapshot->enemies);
+    WriteArray(data, snapshot->asteroids);
+    WriteArray(data, snapshot->powerups);
+    WriteArray(data, snapshot->contacts);
+}
+
+bool ReadGameSnapshot(const unsigned char *data, size_t size, GameSnapshot *snapshot)
+{
+    SnapshotHeader header;
+    if (size < sizeof(header) + sizeof(WorldRecord))
+    {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.size != size - sizeof(header))
+    {
+        return false;
+    }
+    memcpy(&snapshot->world, data + sizeof(header), sizeof(WorldRecord));
+
+    size_t offset = sizeof(header) + sizeof(WorldRecord);
+    return ReadArray(data, size, &offset, &snapshot->objects) &&
+           ReadArray(data, size, &offset, &snapshot->hitboxPoints) &&
+           ReadArray(data, size, &offset, &snapshot->bullets) &&
+           ReadArray(data, size, &offset, &snapshot->players) &&
+           ReadArray(data, size, &offset, &snapshot->enemies) &&
+           ReadArray(data, size, &offset, &snapshot->asteroids) &&
+           ReadArray(data, size, &offset, &snapshot->powerups) &&
+           ReadArray(data, size, &offset, &snapshot->contacts) &&
+           offset == size;
+}
+
+SnapshotRing::SnapshotRing()
+{
+    this->head = 0;
+    this->count = 0;
+}
+
+SnapshotRing::~SnapshotRing()
+{
+}
+
+void SnapshotRing::Reset(int capacity)
+{
+    slots.resize(capacity > 0 ? capacity : 1);
+    head = 0;
+    count = 0;
+}
+
+GameSnapshot *SnapshotRing::Push()
+{
+    if (slots.empty())
+    {
+        Reset(1);
+    }
+    GameSnapshot *snapshot = &slots[head];
+    head = (head + 1) % slots.size();
+    count = count < (int)slots.size() ? count + 1 : count;
+    ClearGameSnapshot(snapshot);
+    return snapshot;
+}
+
+GameSnapshot *SnapshotRing::Pop()
+{
+    if (count == 0)
+    {
+        return nullptr;
+    }
+    head = (head + slots.size() - 1) % slots.size();
+    count--;
+    return &slots[head];
+}
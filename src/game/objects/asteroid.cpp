@@ -1,7 +1,9 @@
 #include "game/objects/asteroid.hpp"
 #include "game/objects/bullet.hpp"
 #include "game/objects/player.hpp"
+#include "game/game_snapshot.hpp"
 #include "utils/utils.hpp"
+#include "utils/simd.hpp"
 
 #include "raymath.h"
 #include <math.h>
@@ -68,24 +70,27 @@ const Vector2 *asteroid_shapes[] = {
 
 Asteroid::Asteroid(Vector2 origin, AsteroidVariant variant, float velocityMultiplier) : GameObject({0}, 0, {0, -1}, {}, ASTEROID)
 {
-    this->velocity = {(float)GetRandomValue(-100, 100), (float)GetRandomValue(-100, 100)};
+    Rng *rng = GetGameRng(RNG_ASTEROIDS);
+    this->velocity = {(float)rng->GetInt(-100, 100), (float)rng->GetInt(-100, 100)};
     this->velocity = Vector2Scale(this->velocity, velocityMultiplier);
-    this->rotation = GetRandomValue(0, 360);
-    this->angularVelocity = GetRandomValue(-10, 10) * 12;
+    this->rotation = rng->GetInt(0, 360);
+    this->angularVelocity = rng->GetInt(-10, 10) * 12;
     this->variant = variant;
     this->state = FLOATING;
+    this->lastExplosionTime = 0;
 
     this->origin = origin;
 
     // (2x + 1) -> [1, 3, 5, 7] -> large variants
     // (2x + 2) -> [2, 4, 6, 8] -> small variants
     this->size = (variant == LARGE) ? ASTEROID_SIZE_LARGE : ASTEROID_SIZE_SMALL;
-    SpriteTextureID randomAsteroidTexture = (SpriteTextureID)(2 * GetRandomValue(0, 3) + 1); // load large variants
+    SpriteTextureID randomAsteroidTexture = (SpriteTextureID)(2 * rng->GetInt(0, 3) + 1); // load large variants
     if (variant == SMALL)
     {
         randomAsteroidTexture = (SpriteTextureID)(randomAsteroidTexture + ASTEROID_DETAILED_LARGE_SPRITE); // load small variants
     }
 
+    this->sprite = randomAsteroidTexture;
     this->texture = ResourceManager::GetSpriteTexture(randomAsteroidTexture);
     this->explosionSound = ResourceManager::CreateSoundAlias(EXPLOSION_SOUND);
     SetSoundVolume(explosionSound, size / ASTEROID_SIZE_LARGE); // set volume according to size
@@ -96,36 +101,22 @@ Asteroid::Asteroid(Vector2 origin, AsteroidVariant variant, float velocityMultip
     //    normal/squared  large/small
     shape = 2 * (shape / 4) + shape % 2;
 
-    for (int i = 0; i < 9; i++)
-    {
-        this->hitbox.push_back(Vector2Add(origin, Vector2Scale(Vector2Rotate(asteroid_shapes[shape][i], rotation * DEG2RAD), size)));
-    }
+    this->hitbox.resize(9);
+    TransformPoints(asteroid_shapes[shape], hitbox.data(), hitbox.size(), MakePointTransform({0, 0}, rotation, size, origin));
 }
 
 Asteroid::Asteroid(AsteroidVariant variant, float velocityMultiplier)
-    : Asteroid(RandomVecOutsideScreen(variant == LARGE ? ASTEROID_SIZE_LARGE : ASTEROID_SIZE_SMALL), variant, velocityMultiplier)
+    : Asteroid(RandomVecOutsideScreen(variant == LARGE ? ASTEROID_SIZE_LARGE : ASTEROID_SIZE_SMALL, GetWorldBounds(), GetGameRng(RNG_SPAWN)), variant, velocityMultiplier)
 {
 }
 
 Asteroid::~Asteroid()
 {
-    if (explosionSound.frameCount > 0 && explosionSound.stream.buffer != NULL)
-    {
-        if (IsSoundPlaying(explosionSound))
-        {
-            StopSound(explosionSound);
-        }
-        UnloadSoundAlias(explosionSound);
-    }
+    ResourceManager::UnloadSoundAlias(explosionSound);
 }
 
 void Asteroid::Update()
 {
-    // change state to DESTROYED after destroying animation is finished
-    if (state == EXPLODING && GetTime() - lastExplosionTime > ASTEROID_DESTROY_TIME)
-    {
-        state = DESTROYED;
-    }
     if (state == DESTROYED)
     {
         return;
@@ -135,28 +126,12 @@ void Asteroid::Update()
     GameObject::Update();
 
     // Teleport to the other side of the screen if the asteroid goes off-screen
-    const Rectangle worldBox = {-(float)GetScreenWidth() / 2, -(float)GetScreenHeight() / 2, (float)GetScreenWidth(), (float)GetScreenHeight()};
-    if (origin.x > worldBox.x + worldBox.width + size / 2)
-    {
-        Translate({-worldBox.width - size, 0});
-    }
-    else if (origin.x < worldBox.x - size / 2)
-    {
-        Translate({worldBox.width + size, 0});
-    }
-    if (origin.y > worldBox.y + worldBox.height + size / 2)
-    {
-        Translate({0, -worldBox.height - size});
-    }
-    else if (origin.y < worldBox.y - size / 2)
-    {
-        Translate({0, worldBox.height + size});
-    }
+    WrapAround(GetWorldBounds());
 
     // Play explosion sound if asteroid is exploding
     if (state == EXPLODING && !IsSoundPlaying(explosionSound))
     {
-        PlaySound(explosionSound);
+        ResourceManager::PlaySound(explosionSound);
     }
 }
 
@@ -171,7 +146,7 @@ void Asteroid::Draw()
     // the asteroid grows in size and fades out
     if (state == EXPLODING)
     {
-        float explosionProgress = (GetTime() - lastExplosionTime) / ASTEROID_EXPLOSION_TIME;
+        float explosionProgress = (GetGameTime() - lastExplosionTime) / ASTEROID_EXPLOSION_TIME;
         float scale = 1 + explosionProgress;
         float explosionFade = 1 - explosionProgress;
 
@@ -197,10 +172,42 @@ void Asteroid::Destroy()
     {
         this->state = EXPLODING;
         this->hitbox.clear(); // remove hitbox to prevent collisions
-        this->lastExplosionTime = GetTime();
+        WakeUp();             // sleeping asteroids are not updated
+        this->lastExplosionTime = GetGameTime();
+        StartTimer(TIMER_ASTEROID_DESTROYED, ASTEROID_DESTROY_TIME);
     }
 }
 
+void Asteroid::OnTimer(TimerEvent event)
+{
+    // change state to DESTROYED after destroying animation is finished
+    if (event == TIMER_ASTEROID_DESTROYED && state == EXPLODING)
+    {
+        state = DESTROYED;
+    }
+}
+
+int Asteroid::Capture(GameSnapshot *snapshot)
+{
+    const int index = GameObject::Capture(snapshot);
+    snapshot->objects[index].kind = variant;
+    snapshot->objects[index].detail = snapshot->asteroids.size();
+    snapshot->asteroids.push_back({state, size, lastExplosionTime, sprite});
+    return index;
+}
+
+void Asteroid::Restore(const GameSnapshot *snapshot, const ObjectRecord *record)
+{
+    GameObject::Restore(snapshot, record);
+    const AsteroidRecord *asteroidRecord = &snapshot->asteroids[record->detail];
+    state = (AsteroidState)asteroidRecord->state;
+    size = asteroidRecord->size;
+    lastExplosionTime = asteroidRecord->lastExplosionTime;
+    sprite = (SpriteTextureID)asteroidRecord->sprite;
+    texture = ResourceManager::GetSpriteTexture(sprite);
+    SetSoundVolume(explosionSound, size / ASTEROID_SIZE_LARGE);
+}
+
 void Asteroid::HandleCollision(GameObject *other, Vector2 *pushVector)
 {
     // destroy if hit by player bullet
@@ -212,10 +219,7 @@ void Asteroid::HandleCollision(GameObject *other, Vector2 *pushVector)
         }
         return;
     }
-    if (other->GetType() == POWER_UP || other->GetType() == PLAYER) // player already handles collision with asteroids
-    {
-        // do nothing
-        return;
-    }
-    Push(other, *pushVector);
+    // player already handles collision with asteroids
+    // and contacts with other asteroids and enemies are resolved by the contact solver
+    (void)pushVector;
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "game/objects/bullet.hpp"
+#include "game/game_snapshot.hpp"
+
+#include <string.h>
 
 Bullet::Bullet(Vector2 origin, Vector2 forwardDir, float speed, bool isPlayerBullet)
     : GameObject({origin.x - BULLET_SIZE / 2, origin.y - BULLET_SIZE / 2, BULLET_SIZE, BULLET_SIZE},
@@ -63,6 +66,21 @@ void Bullet::HandleCollision(GameObject *other, Vector2 *pushVector)
 
 bool Bullet::IsOutOfBounds()
 {
-    const Rectangle worldBox = {-(float)GetScreenWidth() / 2, -(float)GetScreenHeight() / 2, (float)GetScreenWidth(), (float)GetScreenHeight()};
-    return !CheckCollisionPointRec(origin, worldBox);   
+    return !CheckCollisionPointRec(origin, GetWorldBounds());
+}
+
+void Bullet::CaptureBullet(GameSnapshot *snapshot)
+{
+    BulletRecord record;
+    memset(&record, 0, sizeof(record));
+    CaptureObject(snapshot, &record.object);
+    record.isPlayerBullet = isPlayerBullet;
+    record.isAlive = isAlive;
+    snapshot->bullets.push_back(record);
+}
+
+void Bullet::RestoreBullet(const GameSnapshot *snapshot, const BulletRecord *record)
+{
+    RestoreObject(snapshot, &record->object);
+    isAlive = record->isAlive;
 }
@@ -1,4 +1,5 @@
 #include "game/objects/character.hpp"
+#include "game/game_snapshot.hpp"
 
 Character::Character(Vector2 origin)
     : GameObject({origin.x - CHARACTER_SIZE / 2, origin.y - CHARACTER_SIZE / 2, CHARACTER_SIZE, CHARACTER_SIZE}, 0, {0, -1}, {}, NONE)
@@ -32,30 +33,9 @@ Character::Character(Vector2 origin)
 
 Character::~Character()
 {
-    if (thrustSound.frameCount > 0 && thrustSound.stream.buffer != NULL)
-    {
-        if (IsSoundPlaying(thrustSound))
-        {
-            StopSound(thrustSound);
-        }
-        UnloadSoundAlias(thrustSound);
-    }
-    if (shootSound.frameCount > 0 && shootSound.stream.buffer != NULL)
-    {
-        if (IsSoundPlaying(shootSound))
-        {
-            StopSound(shootSound);
-        }
-        UnloadSoundAlias(shootSound);
-    }
-    if (explosionSound.frameCount > 0 && explosionSound.stream.buffer != NULL)
-    {
-        if (IsSoundPlaying(explosionSound))
-        {
-            StopSound(explosionSound);
-        }
-        UnloadSoundAlias(explosionSound);
-    }
+    ResourceManager::UnloadSoundAlias(thrustSound);
+    ResourceManager::UnloadSoundAlias(shootSound);
+    ResourceManager::UnloadSoundAlias(explosionSound);
 }
 
 void Character::Update()
@@ -85,31 +65,26 @@ void Character::Update()
         return;
     }
 
-    // if dying, wait for dying animation to finish
-    if (state & DYING && GetTime() - lastDeathTime > CHARACTER_DYING_TIME)
-    {
-        state = DEAD;
-    }
-
     if (state & ACCELERATING)
     {
         if (!IsSoundPlaying(thrustSound))
         {
             StopSound(thrustSound);
-            PlaySound(thrustSound);
+            ResourceManager::PlaySound(thrustSound);
         }
-        timeAccelerating += GetFrameTime();
+        timeAccelerating += GetWorldFrameTime();
 
         // decrease pitch proportional to time accelerating
         const float pitch = fmaxf(THRUST_MIN_PITCH, 1.0f - timeAccelerating / THRUST_PITCH_DECAYING_TIME);
         SetSoundPitch(thrustSound, Clamp(pitch, 0, 1) * pitchAndVolumeScale);
 
         // move sound from right to left proportional to character position in x axis
-        const float pan = 1.0f - Lerp(THRUST_MIN_PAN, THRUST_MAX_PAN, (origin.x + GetScreenWidth() / 2) / GetScreenWidth());
+        const Rectangle world = GetWorldBounds();
+        const float pan = 1.0f - Lerp(THRUST_MIN_PAN, THRUST_MAX_PAN, (origin.x + world.width / 2) / world.width);
         SetSoundPan(thrustSound, Clamp(pan, 0, 1));
 
         // decrease volume proportional to character position in y axis
-        const float volume = 1.0f - fabsf(origin.y / GetScreenHeight());
+        const float volume = 1.0f - fabsf(origin.y / world.height);
         SetSoundVolume(thrustSound, Clamp(volume, 0, 1) * pitchAndVolumeScale);
     }
     else
@@ -123,7 +98,7 @@ void Character::Update()
         if (!IsAlive() && !exploded)
         {
             exploded = true;
-            PlaySound(explosionSound);
+            ResourceManager::PlaySound(explosionSound);
         }
         if (IsAlive() && exploded)
         {
@@ -141,19 +116,19 @@ void Character::Update()
     if (Vector2Length(velocity) > maxSpeed)
     {
         // decelerate
-        velocity = Vector2Subtract(velocity, Vector2Scale(Vector2Normalize(velocity), deceleration * GetFrameTime()));
+        velocity = Vector2Subtract(velocity, Vector2Scale(Vector2Normalize(velocity), deceleration * GetWorldFrameTime()));
     }
 
     // rotate character
     if (state & TURNING_LEFT)
     {
         angularVelocity = -turnSpeed;
-        accelDir = Vector2Rotate(accelDir, -turnSpeed * DEG2RAD * GetFrameTime());
+        accelDir = Vector2Rotate(accelDir, -turnSpeed * DEG2RAD * GetWorldFrameTime());
     }
     else if (state & TURNING_RIGHT)
     {
         angularVelocity = turnSpeed;
-        accelDir = Vector2Rotate(accelDir, turnSpeed * DEG2RAD * GetFrameTime());
+        accelDir = Vector2Rotate(accelDir, turnSpeed * DEG2RAD * GetWorldFrameTime());
     }
     else
     {
@@ -161,35 +136,12 @@ void Character::Update()
     }
 
     // Teleport to the other side of the screen if the character goes off-screen
-    const Rectangle worldBox = {-(float)GetScreenWidth() / 2, -(float)GetScreenHeight() / 2, (float)GetScreenWidth(), (float)GetScreenHeight()};
-
-    if (origin.x > worldBox.x + worldBox.width + CHARACTER_SIZE / 4)
-    {
-        Translate({-(float)worldBox.width - CHARACTER_SIZE / 2, 0});
-    }
-    else if (origin.x < worldBox.x - CHARACTER_SIZE / 4)
-    {
-        Translate({(float)worldBox.width + CHARACTER_SIZE / 2, 0});
-    }
-    if (origin.y > worldBox.y + worldBox.height + CHARACTER_SIZE / 4)
-    {
-        Translate({0, -(float)worldBox.height - CHARACTER_SIZE / 2});
-    }
-    else if (origin.y < worldBox.y - CHARACTER_SIZE / 4)
-    {
-        Translate({0, (float)worldBox.height + CHARACTER_SIZE / 2});
-    }
+    WrapAround(GetWorldBounds());
 }
 
 void Character::Draw()
 {
-    // draw bullets
-    for (size_t i = 0; i < bullets.size(); i++)
-    {
-        bullets[i].Draw();
-    }
-
-    // then draw character
+    // bullets are drawn separately by the game draw list
     if (state & DEAD)
     {
         return;
@@ -199,7 +151,7 @@ void Character::Draw()
 
     if (state & DYING)
     {
-        const float deathProgress = (GetTime() - lastDeathTime) / CHARACTER_DYING_TIME;
+        const float deathProgress = (GetGameTime() - lastDeathTime) / CHARACTER_DYING_TIME;
         const float scale = 1 + deathProgress;
         const float deathFade = 1 - deathProgress;
 
@@ -219,20 +171,16 @@ void Character::DrawDebug()
 {
     GameObject::DrawDebug();
     DrawLineV(origin, Vector2Add(origin, Vector2Scale(accelDir, 50)), ORANGE);
-    for (size_t i = 0; i < bullets.size(); i++)
-    {
-        bullets[i].DrawDebug();
-    }
 }
 
-bool Character::CheckCollision(GameObject *other, Vector2 *pushVector)
+bool Character::CheckCollision(GameObject *other, Vector2 *pushVector, ContactCache *cache, Vector2 otherOffset)
 {
     if (!IsAlive())
     {
         return false;
     }
 
-    return GameObject::CheckCollision(other, pushVector);
+    return GameObject::CheckCollision(other, pushVector, cache, otherOffset);
 }
 
 void Character::HandleCollision(GameObject *other, Vector2 *pushVector)
@@ -242,7 +190,7 @@ void Character::HandleCollision(GameObject *other, Vector2 *pushVector)
 
 void Character::Accelerate(float acceleration)
 {
-    this->velocity = Vector2Add(this->velocity, Vector2Scale(this->accelDir, acceleration * GetFrameTime()));
+    this->velocity = Vector2Add(this->velocity, Vector2Scale(this->accelDir, acceleration * GetWorldFrameTime()));
 }
 
 Rectangle Character::GetFrameRec()
@@ -268,8 +216,8 @@ void Character::Shoot()
         bullets.push_back(Bullet(Vector2Add(this->origin, Vector2Scale(this->forwardDir, CHARACTER_SIZE / 4)),
                                  Vector2Rotate(bulletDir, -i * bulletsSpread * DEG2RAD), bulletsSpeed, this->type == PLAYER));
     }
-    lastShootTime = GetTime();
-    PlaySound(shootSound);
+    lastShootTime = GetGameTime();
+    ResourceManager::PlaySound(shootSound);
 }
 
 void Character::CleanBullets()
@@ -284,6 +232,18 @@ void Character::CleanBullets()
     bullets.shrink_to_fit();
 }
 
+void Character::TransferBullets(std::vector<Bullet> *destination)
+{
+    for (size_t i = 0; i < bullets.size(); i++)
+    {
+        if (bullets[i].IsAlive())
+        {
+            destination->push_back(bullets[i]);
+        }
+    }
+    bullets.clear();
+}
+
 bool Character::CanBeKilled()
 {
     return IsAlive();
@@ -303,19 +263,32 @@ bool Character::Kill()
     }
     this->lives--;
     this->state = DYING;
-    this->lastDeathTime = GetTime();
+    this->lastDeathTime = GetGameTime();
     this->hitbox.clear();
+    StartTimer(TIMER_CHARACTER_DEAD, CHARACTER_DYING_TIME);
     return true;
 }
+
+void Character::OnTimer(TimerEvent event)
+{
+    // dying animation finished
+    if (event == TIMER_CHARACTER_DEAD && (state & DYING))
+    {
+        state = DEAD;
+    }
+}
 void Character::Respawn()
 {
     // respawn in any position
-    this->origin = {(float)GetRandomValue(0, GetScreenWidth()), (float)GetRandomValue(0, GetScreenHeight())};
+    Rng *rng = GetGameRng(RNG_SPAWN);
+    const Rectangle world = GetWorldBounds();
+    this->origin = {(float)rng->GetInt(0, world.width), (float)rng->GetInt(0, world.height)};
     this->bounds = {origin.x - CHARACTER_SIZE / 2, origin.y - CHARACTER_SIZE / 2, CHARACTER_SIZE, CHARACTER_SIZE};
     this->rotation = 0;
     this->forwardDir = {0, -1};
     this->velocity = {0, 0};
     this->state = IDLE;
+    StopTimer(TIMER_CHARACTER_DEAD);
     // leave bullets live
     SetDefaultHitBox();
 }
@@ -349,3 +322,58 @@ void Character::SetDefaultHitBox()
               {bounds.x, bounds.y + bounds.height},
               {bounds.x, bounds.y}}; // close the polygon
 }
+
+void Character::CaptureCharacter(GameSnapshot *snapshot, CharacterRecord *record)
+{
+    record->lives = lives;
+    record->state = state;
+    record->accelDir = accelDir;
+    record->lastShootTime = lastShootTime;
+    record->lastDeathTime = lastDeathTime;
+    record->timeAccelerating = timeAccelerating;
+    record->exploded = exploded;
+    record->maxSpeed = maxSpeed;
+    record->acceleration = acceleration;
+    record->deceleration = deceleration;
+    record->turnSpeed = turnSpeed;
+    record->shootCooldown = shootCooldown;
+    record->bulletsPerShot = bulletsPerShot;
+    record->bulletsSpeed = bulletsSpeed;
+    record->bulletsSpread = bulletsSpread;
+    record->pitchAndVolumeScale = pitchAndVolumeScale;
+    record->bulletFirst = snapshot->bullets.size();
+    record->bulletCount = bullets.size();
+    for (size_t i = 0; i < bullets.size(); i++)
+    {
+        bullets[i].CaptureBullet(snapshot);
+    }
+}
+
+void Character::RestoreCharacter(const GameSnapshot *snapshot, const CharacterRecord *record)
+{
+    lives = record->lives;
+    state = record->state;
+    accelDir = record->accelDir;
+    lastShootTime = record->lastShootTime;
+    lastDeathTime = record->lastDeathTime;
+    timeAccelerating = record->timeAccelerating;
+    exploded = record->exploded;
+    maxSpeed = record->maxSpeed;
+    acceleration = record->acceleration;
+    deceleration = record->deceleration;
+    turnSpeed = record->turnSpeed;
+    shootCooldown = record->shootCooldown;
+    bulletsPerShot = record->bulletsPerShot;
+    bulletsSpeed = record->bulletsSpeed;
+    bulletsSpread = record->bulletsSpread;
+    pitchAndVolumeScale = record->pitchAndVolumeScale;
+
+    bullets.clear();
+    for (int i = 0; i < record->bulletCount; i++)
+    {
+        const BulletRecord *bulletRecord = &snapshot->bullets[record->bulletFirst + i];
+        Bullet bullet(bulletRecord->object.origin, bulletRecord->object.forwardDir, 0, bulletRecord->isPlayerBullet);
+        bullet.RestoreBullet(snapshot, bulletRecord);
+        bullets.push_back(bullet);
+    }
+}
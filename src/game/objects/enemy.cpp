@@ -1,13 +1,108 @@
 #include "game/objects/enemy.hpp"
+#include "game/flow_field.hpp"
+#include "game/game_snapshot.hpp"
+#include "utils/simd.hpp"
+#include <string.h>
 #include <string>
 
-Enemy::Enemy(Vector2 origin, Player *player, EnemyAttributes attributes, EnemyType type)
+static const Vector2 shooterHitbox[] = {{0.0f, -0.4f}, {0.4f, 0.35f}, {-0.4f, 0.35f}, {0.0f, -0.4f}};
+
+static const Vector2 stalkerHitbox[] = {
+    {-0.25f, -0.25f},
+    {0.25f, -0.25f},
+    {0.25f, 0.25f},
+    {-0.25f, 0.25f},
+    {-0.25f, -0.25f},
+};
+
+static const Vector2 pulserHitbox[] = {
+    {-0.16f, -0.38f},
+    {0.15f, -0.39f},
+    {0.38f, -0.15f},
+    {0.38f, 0.15f},
+    {0.15f, 0.38f},
+    {-0.15f, 0.38f},
+    {-0.38f, 0.15f},
+    {-0.38f, -0.15f},
+    {-0.15f, -0.38f}, // close the polygon
+};
+
+enum ShooterState
+{
+    SHOOTER_ROAM,
+    SHOOTER_DRIFT,
+    SHOOTER_WHEEL,
+    SHOOTER_DRIFT_WHEEL,
+    SHOOTER_AIM,
+    SHOOTER_ATTACK,
+};
+
+// shooters drift and turn randomly, and sometimes aim at the player, shoot and speed away
+static const BehaviorState shooterStates[] = {
+    {"ROAM", false, TURN_NONE, STEER_NONE, 0, 0, 0, {
+        {TRIGGER_TARGET_CHANCE, 1.0f / ENEMY_SHOOT_COOLDOWN, SHOOTER_AIM},
+        {TRIGGER_CHANCE, SHOOTER_ACCELERATE_RATE, SHOOTER_DRIFT},
+        {TRIGGER_CHANCE, SHOOTER_TURN_RATE, SHOOTER_WHEEL},
+    }},
+    {"DRIFT", true, TURN_NONE, STEER_NONE, 0, SHOOTER_ACCELERATE_MIN_TIME, SHOOTER_ACCELERATE_MAX_TIME, {
+        {TRIGGER_TIMEOUT, 0, SHOOTER_ROAM},
+        {TRIGGER_TARGET_CHANCE, 1.0f / ENEMY_SHOOT_COOLDOWN, SHOOTER_AIM},
+        {TRIGGER_CHANCE, SHOOTER_TURN_RATE, SHOOTER_DRIFT_WHEEL},
+    }},
+    {"WHEEL", false, TURN_RANDOM, STEER_NONE, 0, SHOOTER_ROTATE_MIN_TIME, SHOOTER_ROTATE_MAX_TIME, {
+        {TRIGGER_TIMEOUT, 0, SHOOTER_ROAM},
+        {TRIGGER_TARGET_CHANCE, 1.0f / ENEMY_SHOOT_COOLDOWN, SHOOTER_AIM},
+        {TRIGGER_CHANCE, SHOOTER_ACCELERATE_RATE, SHOOTER_DRIFT_WHEEL},
+    }},
+    {"DRIFT_WHEEL", true, TURN_RANDOM, STEER_NONE, 0, SHOOTER_ROTATE_MIN_TIME, SHOOTER_ROTATE_MAX_TIME, {
+        {TRIGGER_TIMEOUT, 0, SHOOTER_DRIFT},
+        {TRIGGER_TARGET_CHANCE, 1.0f / ENEMY_SHOOT_COOLDOWN, SHOOTER_AIM},
+    }},
+    {"AIM", false, TURN_NONE, STEER_AIM, 0, SHOOTER_AIM_MAX_TIME, SHOOTER_AIM_MAX_TIME, {
+        {TRIGGER_AIMED, 0, SHOOTER_ATTACK},
+        {TRIGGER_TIMEOUT, 0, SHOOTER_ROAM},
+    }},
+    {"ATTACK", true, TURN_NONE, STEER_NONE, ACTION_SHOOT, SHOOTER_ACCELERATE_MIN_TIME, SHOOTER_ACCELERATE_MAX_TIME, {
+        {TRIGGER_TIMEOUT, 0, SHOOTER_ROAM},
+        {TRIGGER_TARGET_CHANCE, 1.0f / ENEMY_SHOOT_COOLDOWN, SHOOTER_AIM},
+    }},
+};
+
+// stalkers spin and chase the player through the flow field
+static const BehaviorState stalkerStates[] = {
+    {"CHASE", true, TURN_LEFT, STEER_FLOW, 0, 0, 0, {}},
+};
+
+// pulsers spin and drift in a random direction, changing it every few seconds
+static const BehaviorState pulserStates[] = {
+    {"DRIFT", true, TURN_RIGHT, STEER_DIRECTION, ACTION_RANDOM_DIRECTION, PULSER_CHANGE_DIR_COOLDOWN, PULSER_CHANGE_DIR_COOLDOWN, {
+        {TRIGGER_TIMEOUT, 0, 0},
+    }},
+};
+
+#define COUNT_OF(array) (int)(sizeof(array) / sizeof(array[0]))
+
+static const EnemyDefinition enemyDefinitions[NUM_ENEMY_TYPES] = {
+    {SHOOTER, "Shooter", ENEMY_SHOOTER_SPRITES, true, shooterHitbox, COUNT_OF(shooterHitbox), CHARACTER_SIZE / 2, 0, false,
+     SHOT_FORWARD, 1.0f, 0, shooterStates, COUNT_OF(shooterStates), SHOOTER_ROAM},
+    {STALKER, "Stalker", ENEMY_STALKER_SPRITES, false, stalkerHitbox, COUNT_OF(stalkerHitbox), CHARACTER_SIZE, STALKER_TURN_SPEED, true,
+     SHOT_FORWARD, 1.0f, 0, stalkerStates, COUNT_OF(stalkerStates), 0},
+    {PULSER, "Pulser", ENEMY_PULSER_SPRITES, false, pulserHitbox, COUNT_OF(pulserHitbox), CHARACTER_SIZE, 360.0f / PULSER_SHOOT_COOLDOWN, true,
+     SHOT_RADIAL, 0.5f, PULSER_SHOOT_COOLDOWN, pulserStates, COUNT_OF(pulserStates), 0},
+};
+
+const EnemyDefinition *GetEnemyDefinition(EnemyType type)
+{
+    return &enemyDefinitions[type];
+}
+
+Enemy::Enemy(Vector2 origin, Player *player, EnemyAttributes attributes, const EnemyDefinition *definition)
     : Character(origin)
 {
     this->state = IDLE;
     this->player = player;
     this->type = ENEMY;
-    this->enemyType = type;
+    this->definition = definition;
 
     // nerf enemy
     this->turnSpeed = CHARACTER_TURN_SPEED / 3;
@@ -16,37 +111,198 @@ Enemy::Enemy(Vector2 origin, Player *player, EnemyAttributes attributes, EnemyTy
     this->deceleration = CHARACTER_DECELERATION / 3;
     this->lives = 1;
 
-    this->texture = ResourceManager::GetInvalidTexture(); // This class is abstract
+    this->texture = ResourceManager::GetSpriteTexture(definition->sprite);
     this->shootSound = ResourceManager::CreateSoundAlias(ENEMY_BULLET_SOUND);
     this->thrustSound = ResourceManager::CreateSoundAlias(ENEMY_THRUST_SOUND);
     this->explosionSound = ResourceManager::CreateSoundAlias(ENEMY_EXPLOSION_SOUND);
 
     SetDefaultHitBox();
 
-    Rotate(GetRandomValue(0, 360));
-    this->velocity = Vector2Scale(forwardDir, GetRandomValue(20, CHARACTER_SIZE));
+    Rng *rng = GetGameRng(RNG_ENEMIES);
+    Rotate(rng->GetInt(0, 360));
+    this->velocity = Vector2Scale(forwardDir, rng->GetInt(20, CHARACTER_SIZE));
 
     const float frMultiplier = attributes.fireRateMultiplier <= 0.0f ? 0.001f : attributes.fireRateMultiplier;
 
     this->velocity = Vector2Scale(this->velocity, attributes.velocityMultiplier);
     this->turnSpeed *= attributes.precision; // increase turn speed with precision
     this->shootCooldown /= frMultiplier;
-    this->bulletsSpeed *= attributes.bulletSpeedMultiplier;
+    this->bulletsSpeed *= attributes.bulletSpeedMultiplier * definition->bulletSpeedScale;
     this->precision = attributes.precision;
+
+    if (definition->turnSpeed > 0)
+    {
+        this->turnSpeed = definition->turnSpeed;
+    }
+    if (definition->silentThrust)
+    {
+        SetSoundVolume(thrustSound, 0.0f);
+    }
+    if (definition->shot == SHOT_RADIAL)
+    {
+        this->bulletsPerShot = attributes.bulletsPerShot;
+        this->bulletsSpread = 360.0f / bulletsPerShot;
+    }
+    if (definition->shootPeriod > 0)
+    {
+        this->lastShootTime = GetGameTime();
+        StartTimer(TIMER_ENEMY_SHOOT, definition->shootPeriod);
+    }
+
+    this->brainSlot = GetGameEnemyBrains()->Add(this, definition->states, definition->initialState,
+                                                attributes.precision, attributes.probOfShootingAtPlayer, rng->Split(RNG_ENEMIES), GetGameTime());
+    GetGameEnemyBrains()->SetPose(brainSlot, origin, forwardDir, true);
 }
 
 Enemy::~Enemy()
 {
+    GetGameEnemyBrains()->Remove(brainSlot);
 }
 
 void Enemy::SetDefaultHitBox()
 {
-    Character::SetDefaultHitBox();
+    hitbox.assign(definition->hitbox, definition->hitbox + definition->hitboxCount);
+    TransformPoints(hitbox.data(), hitbox.data(), hitbox.size(), MakePointTransform({0, 0}, rotation, definition->hitboxScale, origin));
 }
 
 void Enemy::Update()
 {
+    EnemyBrains *brains = GetGameEnemyBrains();
+    EnemyControls *controls = brains->GetControls(brainSlot);
+
+    // steer every frame with the last decision
+    if (IsAlive())
+    {
+        state &= ~(ACCELERATING | TURNING_LEFT | TURNING_RIGHT);
+        if (controls->accelerate)
+        {
+            state |= ACCELERATING;
+        }
+        if (controls->turn < 0)
+        {
+            state |= TURNING_LEFT;
+        }
+        else if (controls->turn > 0)
+        {
+            state |= TURNING_RIGHT;
+        }
+
+        // turn towards the player by the angle measured at the last decision
+        if (controls->steering == STEER_AIM)
+        {
+            const float rotationSpeed = turnSpeed * GetWorldFrameTime();
+            if (controls->aimAngle > rotationSpeed)
+            {
+                state |= TURNING_RIGHT;
+                controls->aimAngle -= rotationSpeed;
+            }
+            else if (controls->aimAngle < -rotationSpeed)
+            {
+                state |= TURNING_LEFT;
+                controls->aimAngle += rotationSpeed;
+            }
+            else
+            {
+                Rotate(controls->aimAngle);
+                controls->aimAngle = 0;
+            }
+        }
+    }
+
     Character::Update();
+
+    controls = brains->GetControls(brainSlot);
+    if (IsAlive())
+    {
+        if (controls->steering == STEER_FLOW)
+        {
+            // follow the shared flow field to the player around the asteroids, keeping away from the other enemies
+            FlowField *flowField = GetGameFlowField();
+            const Vector2 chaseDir = flowField->GetDirection(origin);
+            const Vector2 separation = Vector2Scale(flowField->GetSeparation(origin), ENEMY_SEPARATION_WEIGHT);
+            this->accelDir = Vector2Normalize(Vector2Add(chaseDir, separation)); // overrides character accelDir
+        }
+        else if (controls->steering == STEER_DIRECTION)
+        {
+            this->accelDir = controls->direction; // overrides character accelDir
+        }
+
+        if (controls->shoot)
+        {
+            controls->shoot = false;
+            Shoot();
+        }
+    }
+
+    brains->SetPose(brainSlot, origin, forwardDir, IsAlive());
+}
+
+void Enemy::Shoot()
+{
+    if (definition->shot != SHOT_RADIAL)
+    {
+        Character::Shoot();
+        return;
+    }
+
+    // same as Character::Shoot() but with center at origin and bullets spawning away from the center
+    if (!CanShoot())
+    {
+        return;
+    }
+
+    Vector2 bulletDir = Vector2Rotate(forwardDir, (bulletsPerShot - 1) * bulletsSpread * DEG2RAD / 2);
+
+    for (int i = 0; i < bulletsPerShot; i++)
+    {
+        bullets.push_back(Bullet(Vector2Add(this->origin, Vector2Scale(bulletDir, CHARACTER_SIZE / 2)),
+                                 bulletDir, bulletsSpeed, this->type == PLAYER));
+
+        bulletDir = Vector2Rotate(bulletDir, bulletsSpread * DEG2RAD);
+    }
+    lastShootTime = GetGameTime();
+    ResourceManager::PlaySound(shootSound);
+}
+
+void Enemy::OnTimer(TimerEvent event)
+{
+    if (event == TIMER_ENEMY_SHOOT)
+    {
+        if (IsAlive())
+        {
+            Shoot();
+            StartTimer(TIMER_ENEMY_SHOOT, definition->shootPeriod);
+        }
+        return;
+    }
+    Character::OnTimer(event);
+}
+
+int Enemy::Capture(GameSnapshot *snapshot)
+{
+    const int index = GameObject::Capture(snapshot);
+    EnemyRecord record;
+    memset(&record, 0, sizeof(record));
+    CaptureCharacter(snapshot, &record.character);
+    record.precision = precision;
+    GetGameEnemyBrains()->GetRecord(brainSlot, &record.brain);
+
+    snapshot->objects[index].kind = definition->type;
+    snapshot->objects[index].detail = snapshot->enemies.size();
+    snapshot->enemies.push_back(record);
+    return index;
+}
+
+void Enemy::Restore(const GameSnapshot *snapshot, const ObjectRecord *record)
+{
+    GameObject::Restore(snapshot, record);
+    const EnemyRecord *enemyRecord = &snapshot->enemies[record->detail];
+    RestoreCharacter(snapshot, &enemyRecord->character);
+    precision = enemyRecord->precision;
+
+    EnemyBrains *brains = GetGameEnemyBrains();
+    brains->SetRecord(brainSlot, enemyRecord->brain);
+    brains->SetPose(brainSlot, origin, forwardDir, IsAlive());
 }
 
 void Enemy::DrawDebug()
@@ -66,8 +322,16 @@ void Enemy::DrawDebug()
         }
     }
 
+    EnemyBrains *brains = GetGameEnemyBrains();
+
     DrawText(TextFormat("State: %s", stateString.c_str()), origin.x - CHARACTER_SIZE / 2, origin.y + CHARACTER_SIZE / 2 + 10, 10, WHITE);
     DrawText(TextFormat("Turn speed: %f", turnSpeed), origin.x - CHARACTER_SIZE / 2, origin.y + CHARACTER_SIZE / 2 + 20, 10, WHITE);
+    DrawText(TextFormat("%s: %s", definition->name, brains->GetStateName(brainSlot)), origin.x - CHARACTER_SIZE / 2, origin.y + CHARACTER_SIZE / 2 + 30, 10, WHITE);
+    if (brains->GetControls(brainSlot)->steering == STEER_AIM)
+    {
+        DrawLineEx(origin, player->GetOrigin(), 2, RED);
+        DrawText(TextFormat("Angle to player: %f", Vector2Angle(forwardDir, Vector2Subtract(player->GetOrigin(), origin)) * RAD2DEG), origin.x - CHARACTER_SIZE / 2, origin.y + CHARACTER_SIZE / 2 + 40, 10, WHITE);
+    }
 }
 
 void Enemy::HandleCollision(GameObject *other, Vector2 *pushVector)
@@ -80,14 +344,16 @@ void Enemy::HandleCollision(GameObject *other, Vector2 *pushVector)
         }
         return;
     }
-    if (other->GetType() == ASTEROID || other->GetType() == ENEMY)
-    {
-        Push(other, *pushVector);
-    };
+    // contacts with asteroids and other enemies are resolved by the contact solver
+    (void)pushVector;
 }
 
 Rectangle Enemy::GetFrameRec()
 {
+    if (definition->thrustFrames)
+    {
+        return ResourceManager::GetSpriteSrcRect(definition->sprite, (state & ACCELERATING) ? 1 : 0);
+    }
     return Character::GetFrameRec();
 }
 
@@ -98,7 +364,6 @@ bool Enemy::IsLookingAtPlayer()
 
 bool Enemy::IsLookingAt(Vector2 position)
 {
-    const float angleThreshold = 3.0f; // degrees
     const float angle = fabsf(Vector2Angle(forwardDir, Vector2Subtract(position, origin)) * RAD2DEG);
-    return angle < angleThreshold / precision;
+    return angle < BEHAVIOR_AIM_THRESHOLD / precision;
 }
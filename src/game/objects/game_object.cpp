@@ -1,7 +1,12 @@
 #include "game/objects/game_object.hpp"
+#include "game/contact_cache.hpp"
+#include "game/game_snapshot.hpp"
 #include "utils/utils.hpp"
+#include "utils/simd.hpp"
+#include "utils/counters.hpp"
 
 #include <math.h>
+#include <string.h>
 
 GameObject::GameObject(Rectangle bounds, float rotation, Vector2 forwardDir, std::vector<Vector2> hitbox, GameObjectType type)
 {
@@ -16,18 +21,46 @@ GameObject::GameObject(Rectangle bounds, float rotation, Vector2 forwardDir, std
     this->angularVelocity = 0;
     this->type = type;
     this->texture = ResourceManager::GetInvalidTexture();
+    this->id = NewObjectId();
+    this->sleeping = false;
+    this->restTime = 0;
+    for (int i = 0; i < NUM_TIMER_EVENTS; i++)
+    {
+        this->timers[i] = 0;
+    }
 }
 
 GameObject::~GameObject()
 {
+    // the wheel would call OnTimer on a deleted object
+    for (int i = 0; i < NUM_TIMER_EVENTS; i++)
+    {
+        StopTimer((TimerEvent)i);
+    }
 }
 
 void GameObject::Update() // for overriding
 {
     this->previousVelocity = this->velocity;
     this->previousAngularVelocity = this->angularVelocity;
-    Translate(Vector2Scale(velocity, GetFrameTime()));
-    Rotate(angularVelocity * GetFrameTime());
+
+    const Vector2 translation = Vector2Scale(velocity, GetWorldFrameTime());
+    const float angle = angularVelocity * GetWorldFrameTime();
+    if (angle == 0)
+    {
+        Translate(translation);
+        return;
+    }
+
+    // same as Translate + Rotate, but moving the hitbox in a single pass:
+    // rotating around the new origin is rotating around the old one and then translating
+    const PointTransform transform = MakePointTransform(origin, angle, 1, translation);
+    this->rotation = fmod(rotation + angle, 360);
+    this->forwardDir = {transform.cos * forwardDir.x - transform.sin * forwardDir.y, transform.sin * forwardDir.x + transform.cos * forwardDir.y};
+    this->origin = Vector2Add(this->origin, translation);
+    this->bounds.x = this->origin.x - this->bounds.width / 2;
+    this->bounds.y = this->origin.y - this->bounds.height / 2;
+    TransformPoints(hitbox.data(), hitbox.data(), hitbox.size(), transform);
 }
 
 void GameObject::Draw()
@@ -73,6 +106,97 @@ void GameObject::HandleCollision(GameObject *other, Vector2 *pushVector)
     Push(other, *pushVector);
 }
 
+void GameObject::OnTimer(TimerEvent event)
+{
+    // base class does not start any timers
+    (void)event;
+}
+
+void GameObject::CaptureObject(GameSnapshot *snapshot, ObjectRecord *record)
+{
+    record->type = type;
+    record->kind = 0;
+    record->detail = -1;
+    record->bounds = bounds;
+    record->origin = origin;
+    record->rotation = rotation;
+    record->forwardDir = forwardDir;
+    record->previousVelocity = previousVelocity;
+    record->velocity = velocity;
+    record->previousAngularVelocity = previousAngularVelocity;
+    record->angularVelocity = angularVelocity;
+    record->restTime = restTime;
+    record->sleeping = sleeping;
+    record->hitboxFirst = snapshot->hitboxPoints.size();
+    record->hitboxCount = hitbox.size();
+    snapshot->hitboxPoints.insert(snapshot->hitboxPoints.end(), hitbox.begin(), hitbox.end());
+
+    for (int i = 0; i < NUM_TIMER_EVENTS; i++)
+    {
+        record->timersLeft[i] = timers[i] != 0 ? GetGameTimers()->GetTimeLeft(timers[i]) : -1;
+    }
+}
+
+void GameObject::RestoreObject(const GameSnapshot *snapshot, const ObjectRecord *record)
+{
+    bounds = record->bounds;
+    origin = record->origin;
+    rotation = record->rotation;
+    forwardDir = record->forwardDir;
+    previousVelocity = record->previousVelocity;
+    velocity = record->velocity;
+    previousAngularVelocity = record->previousAngularVelocity;
+    angularVelocity = record->angularVelocity;
+    restTime = record->restTime;
+    sleeping = record->sleeping;
+    hitbox.assign(snapshot->hitboxPoints.begin() + record->hitboxFirst,
+                  snapshot->hitboxPoints.begin() + record->hitboxFirst + record->hitboxCount);
+
+    for (int i = 0; i < NUM_TIMER_EVENTS; i++)
+    {
+        StopTimer((TimerEvent)i);
+        if (record->timersLeft[i] >= 0)
+        {
+            // half a tick less, so the wheel rounds it up to the same tick it was due
+            StartTimer((TimerEvent)i, record->timersLeft[i] - TIMER_WHEEL_TICK / 2);
+        }
+    }
+}
+
+int GameObject::Capture(GameSnapshot *snapshot)
+{
+    ObjectRecord record;
+    memset(&record, 0, sizeof(record)); // the padding too, so equal worlds write equal bytes
+    CaptureObject(snapshot, &record);
+    snapshot->objects.push_back(record);
+    return snapshot->objects.size() - 1;
+}
+
+void GameObject::Restore(const GameSnapshot *snapshot, const ObjectRecord *record)
+{
+    RestoreObject(snapshot, record);
+}
+
+void GameObject::StartTimer(TimerEvent event, float delay)
+{
+    StopTimer(event);
+    timers[event] = GetGameTimers()->Schedule(this, event, delay);
+}
+
+void GameObject::StopTimer(TimerEvent event)
+{
+    if (timers[event] != 0)
+    {
+        GetGameTimers()->Cancel(timers[event]);
+        timers[event] = 0;
+    }
+}
+
+bool GameObject::IsTimerPending(TimerEvent event)
+{
+    return timers[event] != 0 && GetGameTimers()->IsPending(timers[event]);
+}
+
 void GameObject::PauseSounds()
 {
     // base class does not have any sounds
@@ -83,7 +207,7 @@ void GameObject::ResumeSounds()
     // base class does not have any sounds
 }
 
-bool GameObject::CheckCollision(GameObject *other, Vector2 *pushVector)
+bool GameObject::CheckCollision(GameObject *other, Vector2 *pushVector, ContactCache *cache, Vector2 otherOffset)
 {
     *pushVector = {0};
 
@@ -93,92 +217,110 @@ bool GameObject::CheckCollision(GameObject *other, Vector2 *pushVector)
         return false;
     }
 
+    // the other object as seen from this one, moved to the other side of the world if it is being tested wrapped around
+    const std::vector<Vector2> *otherHitbox = &other->GetHitbox();
+    std::vector<Vector2> wrappedHitbox;
+    Rectangle otherBounds = other->GetBounds();
+    Vector2 otherOrigin = other->GetOrigin();
+    if (otherOffset.x != 0 || otherOffset.y != 0)
+    {
+        wrappedHitbox = *otherHitbox;
+        TranslatePoints(wrappedHitbox.data(), wrappedHitbox.size(), otherOffset);
+        otherHitbox = &wrappedHitbox;
+        otherBounds.x += otherOffset.x;
+        otherBounds.y += otherOffset.y;
+        otherOrigin = Vector2Add(otherOrigin, otherOffset);
+    }
+
     // if both objects have a single point hitbox then just check if the points are colliding
-    if (hitbox.size() == 1 && other->GetHitbox().size() == 1)
+    if (hitbox.size() == 1 && otherHitbox->size() == 1)
     {
-        return CheckCollisionCircles(hitbox[0], 1, other->GetHitbox()[0], 1);
+        return CheckCollisionCircles(hitbox[0], 1, (*otherHitbox)[0], 1);
     }
 
     // if the hitbox is a single point then just check if the point is inside the other hitbox
     if (hitbox.size() == 1)
     {
-        return CheckCollisionPointPoly(hitbox[0], other->GetHitbox().data(), other->GetHitbox().size());
+        return CheckCollisionPointPoly(hitbox[0], (Vector2 *)otherHitbox->data(), otherHitbox->size());
     }
 
     // same as above but for the other object
-    if (other->GetHitbox().size() == 1)
+    if (otherHitbox->size() == 1)
     {
-        return CheckCollisionPointPoly(other->GetHitbox()[0], hitbox.data(), hitbox.size());
+        return CheckCollisionPointPoly((*otherHitbox)[0], hitbox.data(), hitbox.size());
     }
 
     // objects are not colliding if their bounding boxes are not colliding
-    if (this->bounds.x + this->bounds.width < other->GetBounds().x || this->bounds.x > other->GetBounds().x + other->GetBounds().width || this->bounds.y + this->bounds.height < other->GetBounds().y || this->bounds.y > other->GetBounds().y + other->GetBounds().height)
+    if (this->bounds.x + this->bounds.width < otherBounds.x || this->bounds.x > otherBounds.x + otherBounds.width || this->bounds.y + this->bounds.height < otherBounds.y || this->bounds.y > otherBounds.y + otherBounds.height)
     {
+        AddCounter(COUNTER_AABB_REJECTS);
+        if (cache != nullptr)
+        {
+            cache->Evict(id, other->GetId());
+        }
         return false;
     }
+    AddCounter(COUNTER_SAT_TESTS);
 
-    // SAT adapted from https://dyn4j.org/2010/01/sat/#sat-mtv
     float overlap = INFINITY;
     float o = overlap;
-    Vector2 smallest = {0, 0};
-    std::vector<Vector2> axes1 = getAxes(hitbox);
-    std::vector<Vector2> axes2 = getAxes(other->GetHitbox());
-    // loop over the axes1
-    for (size_t i = 0; i < axes1.size(); i++)
+
+    // the axis that separated the pair last frame most likely still does
+    Contact *contact = nullptr;
+    if (cache != nullptr)
     {
-        Vector2 axis = axes1[i];
-        // project both shapes onto the axis
-        Vector2 p1 = Project(axis, hitbox);
-        Vector2 p2 = Project(axis, other->GetHitbox());
-        // do the projections overlap?
-        if (!Overlaps(p1, p2, &o))
+        bool created = false;
+        contact = cache->GetContact(id, other->GetId(), &created);
+        if (!created && contact->separated)
         {
-            // then we can guarantee that the shapes do not overlap
-            return false;
-        }
-        else
-        {
-            // get the overlap
-            Overlaps(p1, p2, &o);
-            // check for minimum
-            if (o < overlap)
+            cache->CountAxes(1);
+            if (!Overlaps(Project(contact->separatingAxis, hitbox), Project(contact->separatingAxis, *otherHitbox), &o))
             {
-                // then set this one as the smallest
-                overlap = o;
-                smallest = axis;
+                cache->CountLookup(true);
+                return false;
             }
         }
+        cache->CountLookup(false);
     }
-    // loop over the axes2
-    for (size_t i = 0; i < axes2.size(); i++)
+
+    // SAT adapted from https://dyn4j.org/2010/01/sat/#sat-mtv
+    Vector2 smallest = {0, 0};
+    std::vector<Vector2> axes = getAxes(hitbox);
+    std::vector<Vector2> axes2 = getAxes(*otherHitbox);
+    axes.insert(axes.end(), axes2.begin(), axes2.end());
+    // loop over the axes of both shapes
+    for (size_t i = 0; i < axes.size(); i++)
     {
-        Vector2 axis = axes2[i];
+        Vector2 axis = axes[i];
         // project both shapes onto the axis
         Vector2 p1 = Project(axis, hitbox);
-        Vector2 p2 = Project(axis, other->GetHitbox());
+        Vector2 p2 = Project(axis, *otherHitbox);
         // do the projections overlap?
         if (!Overlaps(p1, p2, &o))
         {
             // then we can guarantee that the shapes do not overlap
+            if (contact != nullptr)
+            {
+                cache->CountAxes(i + 1);
+                contact->separated = true;
+                contact->separatingAxis = axis;
+                contact->normalImpulse = 0;
+                contact->touchingFrames = 0;
+            }
             return false;
         }
-        else
+        // check for minimum
+        if (o < overlap)
         {
-            // get the overlap
-            Overlaps(p1, p2, &o);
-            // check for minimum
-            if (o < overlap)
-            {
-                // then set this one as the smallest
-                overlap = o;
-                smallest = axis;
-            }
+            // then set this one as the smallest
+            overlap = o;
+            smallest = axis;
         }
     }
     // minimum translation vector
     Vector2 mtv = Vector2Scale(smallest, overlap);
 
-    Vector2 c2c1 = Vector2Subtract(other->GetOrigin(), this->origin);
+    Vector2 c2c1 = Vector2Subtract(otherOrigin, this->origin);
     // check if the normal is in the direction of the center to center vector
     if (Vector2DotProduct(c2c1, mtv) < 0)
     {
@@ -186,11 +328,70 @@ bool GameObject::CheckCollision(GameObject *other, Vector2 *pushVector)
         mtv = Vector2Negate(mtv);
     }
     *pushVector = mtv;
+
+    if (contact != nullptr)
+    {
+        // the cached normal points from the object with the lowest id to the other one
+        cache->CountAxes(axes.size());
+        contact->separated = false;
+        contact->normal = Vector2Normalize(id < other->GetId() ? mtv : Vector2Negate(mtv));
+        contact->depth = overlap;
+        contact->touchingFrames++;
+    }
     return true;
 }
 
+void GameObject::UpdateSleep(float deltaTime)
+{
+    if (sleeping || !CanSleep())
+    {
+        return;
+    }
+    if (Vector2Length(velocity) > SLEEP_LINEAR_VELOCITY || fabsf(angularVelocity) > SLEEP_ANGULAR_VELOCITY)
+    {
+        restTime = 0;
+        return;
+    }
+    restTime += deltaTime;
+    if (restTime >= SLEEP_TIME)
+    {
+        sleeping = true;
+        velocity = {0, 0};
+        angularVelocity = 0;
+    }
+}
+
+void GameObject::WrapAround(Rectangle worldBox)
+{
+    const float margin = GetWrapMargin();
+    if (margin <= 0)
+    {
+        return;
+    }
+
+    if (origin.x > worldBox.x + worldBox.width + margin / 2)
+    {
+        Translate({-worldBox.width - margin, 0});
+    }
+    else if (origin.x < worldBox.x - margin / 2)
+    {
+        Translate({worldBox.width + margin, 0});
+    }
+    if (origin.y > worldBox.y + worldBox.height + margin / 2)
+    {
+        Translate({0, -worldBox.height - margin});
+    }
+    else if (origin.y < worldBox.y - margin / 2)
+    {
+        Translate({0, worldBox.height + margin});
+    }
+}
+
 void GameObject::Push(GameObject *other, Vector2 pushVector)
 {
+    this->WakeUp();
+    other->WakeUp();
+
     // constant for reducing velocity after collision
     static const float e = 0.85f;
     static const float nullVelocityThreshold = 1e-9f;
@@ -215,8 +416,8 @@ void GameObject::Push(GameObject *other, Vector2 pushVector)
     other->angularVelocity = e * this->previousAngularVelocity;
 
     // translate both objects with their new velocities so they don't get stuck
-    other->Translate(Vector2Scale(other->GetVelocity(), GetFrameTime()));
-    this->Translate(Vector2Scale(this->GetVelocity(), GetFrameTime()));
+    other->Translate(Vector2Scale(other->GetVelocity(), GetWorldFrameTime()));
+    this->Translate(Vector2Scale(this->GetVelocity(), GetWorldFrameTime()));
 }
 
 void GameObject::Translate(Vector2 translation)
@@ -224,23 +425,15 @@ void GameObject::Translate(Vector2 translation)
     this->origin = Vector2Add(this->origin, translation);
     this->bounds.x = this->origin.x - this->bounds.width / 2;
     this->bounds.y = this->origin.y - this->bounds.height / 2;
-    for (size_t i = 0; i < this->hitbox.size(); i++)
-    {
-        this->hitbox[i] = Vector2Add(this->hitbox[i], translation);
-    }
+    TranslatePoints(hitbox.data(), hitbox.size(), translation);
 }
 
 void GameObject::Rotate(float angle) // in degrees
 {
+    const PointTransform transform = MakePointTransform(origin, angle, 1, {0, 0});
     this->rotation = fmod((GetRotation() + angle), 360);
-    SetForwardDir(Vector2Rotate(GetForwardDir(), angle * DEG2RAD));
-    Vector2 vertex;
-    for (size_t i = 0; i < this->hitbox.size(); i++)
-    {
-        vertex = Vector2Subtract(this->hitbox[i], GetOrigin());
-        vertex = Vector2Rotate(vertex, angle * DEG2RAD);
-        this->hitbox[i] = Vector2Add(vertex, GetOrigin());
-    }
+    SetForwardDir({transform.cos * forwardDir.x - transform.sin * forwardDir.y, transform.sin * forwardDir.x + transform.cos * forwardDir.y});
+    TransformPoints(hitbox.data(), hitbox.data(), hitbox.size(), transform);
 }
 
 void GameObject::Scale(float scale)
@@ -250,10 +443,5 @@ void GameObject::Scale(float scale)
     this->bounds.height *= scale;
     this->bounds.x = this->origin.x - this->bounds.width / 2;
     this->bounds.y = this->origin.y - this->bounds.height / 2;
-    for (size_t i = 0; i < this->hitbox.size(); i++)
-    {
-        Vector2 vertex = Vector2Subtract(this->hitbox[i], GetOrigin());
-        vertex = Vector2Scale(vertex, scale);
-        this->hitbox[i] = Vector2Add(vertex, GetOrigin());
-    }
+    TransformPoints(hitbox.data(), hitbox.data(), hitbox.size(), MakePointTransform(origin, 0, scale, {0, 0}));
 }
@@ -1,7 +1,10 @@
 #include "game/objects/player.hpp"
-#include "game/objects/shooter.hpp"
+#include "game/objects/enemy.hpp"
+#include "game/game_snapshot.hpp"
+#include "utils/simd.hpp"
 
 #include <math.h>
+#include <string.h>
 #include <string>
 
 Player::Player(Vector2 origin) : Character(origin)
@@ -23,6 +26,9 @@ Player::Player(Vector2 origin) : Character(origin)
     this->changeToDirShipSound = ResourceManager::GetSound(CHANGE_TO_DIR_SHIP_SOUND);
     this->changeToShipSound = ResourceManager::GetSound(CHANGE_TO_NORMAL_SHIP_SOUND);
 
+    this->input = {0};
+    this->externalInput = false;
+
     Reset();
     Hide();
 }
@@ -42,16 +48,22 @@ void Player::Update()
 
     if (usingBoost)
     {
-        boostTime = fmaxf(boostTime - GetFrameTime(), 0.0f);
+        boostTime = fmaxf(boostTime - GetWorldFrameTime(), 0.0f);
         if (boostTime <= 0.0f)
         {
             usingBoost = false;
         }
-        lastBoostUsedTime = GetTime();
+        lastBoostUsedTime = GetGameTime();
+        boostRecharging = false;
+        StopTimer(TIMER_PLAYER_BOOST_RECHARGE);
+    }
+    else if (boostRecharging)
+    {
+        boostTime = fminf(boostTime + GetWorldFrameTime(), BOOST_TIME);
     }
-    else if (GetTime() - lastBoostUsedTime > BOOST_RECHARGE_COOLDOWN)
+    else if (!IsTimerPending(TIMER_PLAYER_BOOST_RECHARGE))
     {
-        boostTime = fminf(boostTime + GetFrameTime(), BOOST_TIME);
+        StartTimer(TIMER_PLAYER_BOOST_RECHARGE, BOOST_RECHARGE_COOLDOWN);
     }
 
     if (usingBoost && boostTime > 0.0f)
@@ -75,14 +87,9 @@ void Player::Update()
         HandleInput();
     }
 
-    if ((state & DEAD) && lives > 0 && GetTime() - lastDeathTime > CHARACTER_RESPAWN_TIME)
-    {
-        Respawn();
-    }
-
     if (directionalShip && IsAlive())
     {
-        directionalShipMeter -= 10.0f * GetFrameTime(); // (MAX / 10) seconds
+        directionalShipMeter -= 10.0f * GetWorldFrameTime(); // (MAX / 10) seconds
 
         // disable directional ship if meter is empty
         if (directionalShipMeter <= 0.0f)
@@ -94,18 +101,17 @@ void Player::Update()
 
     if (changingShip)
     {
-        static bool changed = false;
-        changingShipTime += GetFrameTime();
-        if (changingShipTime >= CHANGING_SHIP_TIME && !changed)
+        changingShipTime += GetWorldFrameTime();
+        if (changingShipTime >= CHANGING_SHIP_TIME && !shipChanged)
         {
             directionalShip = !directionalShip;
-            changed = true;
+            shipChanged = true;
         }
         if (changingShipTime >= CHANGING_SHIP_TIME * 2)
         {
             changingShip = false;
             changingShipTime = 0.0f;
-            changed = false;
+            shipChanged = false;
             if (!directionalShip)
             {
                 accelDir = forwardDir;
@@ -166,7 +172,7 @@ void Player::Draw()
 
     // draw boost bar
     PowerUp *temporaryInfiniteBoost = GetPowerup(TEMPORARY_INFINITE_BOOST);
-    const float timeSinceBoost = GetTime() - lastBoostUsedTime;
+    const float timeSinceBoost = GetGameTime() - lastBoostUsedTime;
     if (IsAlive() && (temporaryInfiniteBoost != nullptr || timeSinceBoost < BOOST_BAR_HIDE_TIME + BOOST_BAR_FADE_TIME))
     {
         Rectangle boostBar = bar;
@@ -209,12 +215,6 @@ void Player::Draw()
     {
         if (changingShip)
         {
-            static Vector2 originalSize = {0, 0};
-            if (originalSize.x == 0 && originalSize.y == 0)
-            {
-                originalSize = {bounds.width, bounds.height};
-            }
-
             // changingShipTime <= CHANGING_SHIP_TIME -> shrinking
             // changingShipTime > CHANGING_SHIP_TIME -> growing
             float scaleFactor = 1 + (changingShipTime <= CHANGING_SHIP_TIME ? -1.0f : 1.0f) * GetFrameTime() / (CHANGING_SHIP_TIME);
@@ -271,22 +271,20 @@ void Player::HandleInput()
     {
         return;
     }
-#ifdef _DEBUG
-    if (IsMouseButtonPressed(MOUSE_BUTTON_SIDE))
+    if (!externalInput)
     {
-        directionalShipMeter = DIRECTIONAL_SHIP_METER_MAX;
-    }
+#ifdef _DEBUG
+        if (IsMouseButtonPressed(MOUSE_BUTTON_SIDE))
+        {
+            directionalShipMeter = DIRECTIONAL_SHIP_METER_MAX;
+        }
 #endif
+        input = ReadInput();
+    }
 
     if (directionalShip)
     {
-        int wasdMask = IsKeyDown(KEY_D) << 0 | IsKeyDown(KEY_S) << 1 | IsKeyDown(KEY_A) << 2 | IsKeyDown(KEY_W) << 3;
-        accelDir = {0, 0};
-        if (wasdMask)
-        {
-            accelDir.x = (bool)(wasdMask & 1) - (bool)(wasdMask & 4); // 1 if D, -1 if A, 0 otherwise
-            accelDir.y = (bool)(wasdMask & 2) - (bool)(wasdMask & 8); // 1 if S, -1 if W, 0 otherwise
-        }
+        accelDir = Vector2Clamp(input.moveDir, {-1, -1}, {1, 1});
         if (accelDir.x != 0 || accelDir.y != 0)
         {
             state |= ACCELERATING;
@@ -297,63 +295,77 @@ void Player::HandleInput()
             usingBoost = false;
         }
 
-        Vector2 mousePos = GetScreenToWorld2D(GetMousePosition(), camera);
-        float angle = Vector2Angle(forwardDir, Vector2Subtract(mousePos, origin));
+        float angle = Vector2Angle(forwardDir, Vector2Subtract(input.aimTarget, origin));
         Rotate(angle * RAD2DEG);
     }
     else
     {
-        if (IsKeyPressed(KEY_W))
+        if (input.accelerate)
         {
             this->state |= ACCELERATING;
         }
-        if (IsKeyReleased(KEY_W))
+        else
         {
             this->state &= ~ACCELERATING;
             usingBoost = false;
         }
-        if (IsKeyDown(KEY_A))
+        state &= ~(TURNING_LEFT | TURNING_RIGHT);
+        if (input.turn < 0)
         {
-            state &= ~TURNING_RIGHT;
             state |= TURNING_LEFT;
         }
-        else if (IsKeyDown(KEY_D))
+        else if (input.turn > 0)
         {
-            state &= ~TURNING_LEFT;
             state |= TURNING_RIGHT;
         }
-        else
-        {
-            state &= ~(TURNING_LEFT | TURNING_RIGHT);
-        }
     }
 
-    if (IsKeyDown(KEY_LEFT_SHIFT) && this->state & ACCELERATING)
+    if (input.boost && this->state & ACCELERATING)
     {
         usingBoost = true;
     }
-    if (IsKeyUp(KEY_LEFT_SHIFT) && usingBoost)
+    if (!input.boost && usingBoost)
     {
         usingBoost = false;
     }
 
-    if (IsKeyDown(KEY_SPACE) || IsMouseButtonDown(MOUSE_LEFT_BUTTON))
+    if (input.shoot)
     {
         Shoot();
     }
-    if (IsKeyPressed(KEY_Q))
+    if (input.toggleShip)
     {
         ToggleDirectionalShip();
+        input.toggleShip = false; // like a key press, held input doesn't keep toggling
     }
 }
 
-bool Player::CheckCollision(GameObject *other, Vector2 *pushVector)
+PlayerInput Player::ReadInput()
+{
+    PlayerInput keyboard = {0};
+    keyboard.accelerate = IsKeyDown(KEY_W);
+    keyboard.turn = IsKeyDown(KEY_A) ? -1 : (IsKeyDown(KEY_D) ? 1 : 0); // A wins if both are down
+    keyboard.moveDir = {(float)(IsKeyDown(KEY_D) - IsKeyDown(KEY_A)), (float)(IsKeyDown(KEY_S) - IsKeyDown(KEY_W))};
+    keyboard.aimTarget = GetScreenToWorld2D(GetMousePosition(), camera);
+    keyboard.boost = IsKeyDown(KEY_LEFT_SHIFT);
+    keyboard.shoot = IsKeyDown(KEY_SPACE) || IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+    keyboard.toggleShip = IsKeyPressed(KEY_Q);
+    return keyboard;
+}
+
+void Player::SetInput(PlayerInput input)
+{
+    this->input = input;
+    this->externalInput = true;
+}
+
+bool Player::CheckCollision(GameObject *other, Vector2 *pushVector, ContactCache *cache, Vector2 otherOffset)
 {
     if (hidden)
     {
         return false;
     }
-    return Character::CheckCollision(other, pushVector);
+    return Character::CheckCollision(other, pushVector, cache, otherOffset);
 }
 
 void Player::HandleCollision(GameObject *other, Vector2 *pushVector)
@@ -364,7 +376,7 @@ void Player::HandleCollision(GameObject *other, Vector2 *pushVector)
     }
     if (other->GetType() == ENEMY)
     {
-        Shooter *enemy = (Shooter *)other;
+        Enemy *enemy = (Enemy *)other;
         Push(enemy, *pushVector);
         if (this->CanBeHit() && !this->HasPowerup(SHIELD))
         {
@@ -563,7 +575,31 @@ bool Player::Kill()
     {
         return false;
     }
-    return Character::Kill();
+    if (!Character::Kill())
+    {
+        return false;
+    }
+    StartTimer(TIMER_PLAYER_RESPAWN, CHARACTER_RESPAWN_TIME);
+    return true;
+}
+
+void Player::OnTimer(TimerEvent event)
+{
+    switch (event)
+    {
+    case TIMER_PLAYER_RESPAWN:
+        if ((state & DEAD) && lives > 0)
+        {
+            Respawn();
+        }
+        break;
+    case TIMER_PLAYER_BOOST_RECHARGE:
+        boostRecharging = true;
+        break;
+    default:
+        Character::OnTimer(event);
+        break;
+    }
 }
 
 void Player::Respawn()
@@ -576,6 +612,7 @@ void Player::Respawn()
     this->usingBoost = false;
     this->boostTime = BOOST_TIME;
     this->lastBoostUsedTime = 0;
+    this->boostRecharging = true;
     this->forwardDir = {0, -1};
     this->accelDir = forwardDir;
     this->directionalShip = false;
@@ -584,6 +621,9 @@ void Player::Respawn()
     this->state = IDLE;
     this->lastDeathTime = 0;
     this->lastShootTime = 0;
+    StopTimer(TIMER_CHARACTER_DEAD);
+    StopTimer(TIMER_PLAYER_RESPAWN);
+    StopTimer(TIMER_PLAYER_BOOST_RECHARGE);
     this->shootCooldown = CHARACTER_SHOOT_COOLDOWN;
     this->bulletsPerShot = 1;
     this->bulletsSpeed = BULLET_SPEED;
@@ -606,7 +646,9 @@ void Player::Reset()
     this->directionalShipMeter = DIRECTIONAL_SHIP_METER_MAX / 3;
     this->directionalShip = false;
     this->changingShip = false;
+    this->shipChanged = false;
     this->changingShipTime = 0.0f;
+    bullets.clear();
 
     // remove all powerups
     for (auto powerup : powerups)
@@ -620,6 +662,77 @@ void Player::Reset()
     }
 }
 
+int Player::Capture(GameSnapshot *snapshot)
+{
+    const int index = GameObject::Capture(snapshot);
+    PlayerRecord record;
+    memset(&record, 0, sizeof(record));
+    CaptureCharacter(snapshot, &record.character);
+    record.initialOrigin = initialOrigin;
+    record.camera = camera;
+    record.invincible = invincible;
+    record.hasMoved = hasMoved;
+    record.usingBoost = usingBoost;
+    record.boostTime = boostTime;
+    record.lastBoostUsedTime = lastBoostUsedTime;
+    record.boostRecharging = boostRecharging;
+    record.changingShipTime = changingShipTime;
+    record.changingShip = changingShip;
+    record.shipChanged = shipChanged;
+    record.directionalShip = directionalShip;
+    record.directionalShipMeter = directionalShipMeter;
+    record.hidden = hidden;
+    for (size_t i = 0; i < NUM_POWER_UP_TYPES; i++)
+    {
+        record.powerupsCount[i] = powerupsCount[i];
+    }
+
+    // the carried powerups are not in the world, they follow the player record
+    record.powerupFirst = snapshot->objects.size();
+    record.powerupCount = powerups.size();
+    for (size_t i = 0; i < powerups.size(); i++)
+    {
+        powerups[i]->Capture(snapshot);
+    }
+
+    snapshot->objects[index].detail = snapshot->players.size();
+    snapshot->players.push_back(record);
+    return index;
+}
+
+void Player::Restore(const GameSnapshot *snapshot, const ObjectRecord *record)
+{
+    GameObject::Restore(snapshot, record);
+    const PlayerRecord *playerRecord = &snapshot->players[record->detail];
+    RestoreCharacter(snapshot, &playerRecord->character);
+    initialOrigin = playerRecord->initialOrigin;
+    camera = playerRecord->camera;
+    invincible = playerRecord->invincible;
+    hasMoved = playerRecord->hasMoved;
+    usingBoost = playerRecord->usingBoost;
+    boostTime = playerRecord->boostTime;
+    lastBoostUsedTime = playerRecord->lastBoostUsedTime;
+    boostRecharging = playerRecord->boostRecharging;
+    changingShipTime = playerRecord->changingShipTime;
+    changingShip = playerRecord->changingShip;
+    shipChanged = playerRecord->shipChanged;
+    directionalShip = playerRecord->directionalShip;
+    directionalShipMeter = playerRecord->directionalShipMeter;
+    hidden = playerRecord->hidden;
+    for (size_t i = 0; i < NUM_POWER_UP_TYPES; i++)
+    {
+        powerupsCount[i] = playerRecord->powerupsCount[i];
+    }
+
+    for (int i = 0; i < playerRecord->powerupCount; i++)
+    {
+        const ObjectRecord *powerupRecord = &snapshot->objects[playerRecord->powerupFirst + i];
+        PowerUp *powerup = new PowerUp(powerupRecord->origin, (PowerUpType)powerupRecord->kind);
+        powerup->Restore(snapshot, powerupRecord);
+        powerups.push_back(powerup);
+    }
+}
+
 void Player::ToggleDirectionalShip()
 {
     if (changingShip || !IsAlive())
@@ -633,11 +746,11 @@ void Player::ToggleDirectionalShip()
 
     if (directionalShip)
     {
-        PlaySound(*changeToShipSound);
+        ResourceManager::PlaySound(*changeToShipSound);
     }
     else
     {
-        PlaySound(*changeToDirShipSound);
+        ResourceManager::PlaySound(*changeToDirShipSound);
     }
     changingShip = true;
 }
@@ -741,10 +854,7 @@ void Player::SetDefaultHitBox()
     this->hitbox = {{0.0f, -0.4f}, {0.4f, 0.35f}, {-0.4f, 0.35f}, {0.0f, -0.4f}}; // up, right-down, left-down, close polygon
 
     // scale to size -> rotate -> translate
-    for (size_t i = 0; i < hitbox.size(); i++)
-    {
-        this->hitbox[i] = Vector2Add(Vector2Rotate(Vector2Scale(this->hitbox[i], CHARACTER_SIZE / 2), rotation * DEG2RAD), GetOrigin());
-    }
+    TransformPoints(hitbox.data(), hitbox.data(), hitbox.size(), MakePointTransform({0, 0}, rotation, CHARACTER_SIZE / 2, origin));
 }
 
 void Player::SetDirectionalShipHitBox()
@@ -762,8 +872,5 @@ void Player::SetDirectionalShipHitBox()
     };
 
     // scale to size -> rotate -> translate
-    for (size_t i = 0; i < hitbox.size(); i++)
-    {
-        this->hitbox[i] = Vector2Add(Vector2Rotate(Vector2Scale(this->hitbox[i], CHARACTER_SIZE / 2), rotation * DEG2RAD), GetOrigin());
-    }
+    TransformPoints(hitbox.data(), hitbox.data(), hitbox.size(), MakePointTransform({0, 0}, rotation, CHARACTER_SIZE / 2, origin));
 }
@@ -1,7 +1,9 @@
 #include "game/objects/power_up.hpp"
 #include "game/objects/player.hpp"
+#include "game/game_snapshot.hpp"
 
 #include <map>
+#include <string.h>
 
 // ------------------------- Powerups item sprites -------------------------
 const std::map<PowerUpType, SpriteTextureID> powerUpSpriteItemMap = {
@@ -16,7 +18,7 @@ const std::map<PowerUpType, SpriteTextureID> powerUpSpriteItemMap = {
 };
 // -------------------------------------------------------------------------
 
-PowerUp::PowerUp(Vector2 origin, PowerUpType type) : GameObject()
+PowerUp::PowerUp(Vector2 origin, PowerUpType type, bool restored) : GameObject()
 {
     this->origin = origin;
     this->bounds = {origin.x - POWER_UP_SIZE / 2, origin.y - POWER_UP_SIZE / 2, POWER_UP_SIZE, POWER_UP_SIZE};
@@ -31,10 +33,13 @@ PowerUp::PowerUp(Vector2 origin, PowerUpType type) : GameObject()
     this->pickedUp = false;
     this->drawable = true;
     this->shaking = false;
-    this->shakingTime = 0.0f;
     this->lastShakeTime = 0.0f;
-    this->timeToLive = POWER_UP_TIME_TO_LIVE;
-    this->effectiveUseTime = 0.0f;
+    this->rng = GetGameRng(RNG_POWER_UPS)->Split(RNG_POWER_UPS);
+    this->expireTime = GetGameTime() + POWER_UP_TIME_TO_LIVE;
+    this->expired = false;
+    this->useEndTime = 0.0f;
+    this->used = false;
+    StartTimer(TIMER_POWER_UP_EXPIRED, POWER_UP_TIME_TO_LIVE);
 
     this->spawnSound = ResourceManager::GetSound(POWERUP_SPAWN_SOUND);
     this->pickupSound = ResourceManager::GetSound(POWERUP_PICKUP_SOUND);
@@ -44,7 +49,10 @@ PowerUp::PowerUp(Vector2 origin, PowerUpType type) : GameObject()
     {
         this->texture = ResourceManager::GetSpriteTexture(powerUpSpriteItemMap.at(type));
     }
-    PlaySound(*spawnSound);
+    if (!restored)
+    {
+        ResourceManager::PlaySound(*spawnSound);
+    }
 }
 
 PowerUp::~PowerUp()
@@ -55,26 +63,71 @@ void PowerUp::Update()
 {
     if (pickedUp)
     {
-        effectiveUseTime = fmaxf(effectiveUseTime - GetFrameTime(), 0.0f);
         return;
     }
     if (shaking)
     {
-        Translate({(float)GetRandomValue(-1, 1), 0});
-        shakingTime += GetFrameTime();
-        if (shakingTime >= POWER_UP_SHAKE_TIME)
-        {
-            shaking = false;
-            shakingTime = 0.0f;
-        }
+        Translate({(float)rng.GetInt(-1, 1), 0});
     }
     GameObject::Update();
-    timeToLive = fmaxf(timeToLive - GetFrameTime(), 0.0f);
+}
+
+int PowerUp::Capture(GameSnapshot *snapshot)
+{
+    const int index = GameObject::Capture(snapshot);
+    snapshot->objects[index].kind = powerupType;
+    snapshot->objects[index].detail = snapshot->powerups.size();
+    PowerUpRecord powerupRecord;
+    memset(&powerupRecord, 0, sizeof(powerupRecord));
+    powerupRecord.pickedUp = pickedUp;
+    powerupRecord.drawable = drawable;
+    powerupRecord.shaking = shaking;
+    powerupRecord.lastShakeTime = lastShakeTime;
+    powerupRecord.expireTime = expireTime;
+    powerupRecord.expired = expired;
+    powerupRecord.useEndTime = useEndTime;
+    powerupRecord.used = used;
+    powerupRecord.rng = rng.GetState();
+    snapshot->powerups.push_back(powerupRecord);
+    return index;
+}
+
+void PowerUp::Restore(const GameSnapshot *snapshot, const ObjectRecord *record)
+{
+    GameObject::Restore(snapshot, record);
+    const PowerUpRecord *powerupRecord = &snapshot->powerups[record->detail];
+    pickedUp = powerupRecord->pickedUp;
+    drawable = powerupRecord->drawable;
+    shaking = powerupRecord->shaking;
+    lastShakeTime = powerupRecord->lastShakeTime;
+    expireTime = powerupRecord->expireTime;
+    expired = powerupRecord->expired;
+    useEndTime = powerupRecord->useEndTime;
+    used = powerupRecord->used;
+    rng.SetState(powerupRecord->rng);
+}
+
+void PowerUp::OnTimer(TimerEvent event)
+{
+    switch (event)
+    {
+    case TIMER_POWER_UP_EXPIRED:
+        expired = true;
+        break;
+    case TIMER_POWER_UP_SHAKE_END:
+        shaking = false;
+        break;
+    case TIMER_POWER_UP_USE_END:
+        used = true;
+        break;
+    default:
+        break;
+    }
 }
 
 void PowerUp::Draw()
 {
-    if ((!pickedUp && timeToLive <= 0.0f) || !drawable)
+    if ((!pickedUp && expired) || !drawable)
     {
         return;
     }
@@ -84,6 +137,7 @@ void PowerUp::Draw()
         return;
     }
 
+    const float timeToLive = GetTimeToLive();
     Color colorTint = WHITE;
     Rectangle dst = {origin.x, origin.y, bounds.width, bounds.height};
 
@@ -136,11 +190,13 @@ void PowerUp::ResumeSounds()
 
 void PowerUp::PickUp()
 {
-    PlaySound(*pickupSound);
+    ResourceManager::PlaySound(*pickupSound);
     pickedUp = true;
     drawable = false;
-    timeToLive = 0.0f;
     hitbox.clear();
+    StopTimer(TIMER_POWER_UP_EXPIRED);
+    StopTimer(TIMER_POWER_UP_SHAKE_END);
+    shaking = false;
     switch (powerupType)
     {
     case SHIELD:
@@ -172,13 +228,14 @@ void PowerUp::PickUp()
 
 void PowerUp::Shake()
 {
-    if (shaking || pickedUp || GetTime() - lastShakeTime < POWER_UP_SHAKE_TIME * 6)
+    if (shaking || pickedUp || GetGameTime() - lastShakeTime < POWER_UP_SHAKE_TIME * 6)
     {
         return;
     }
-    PlaySound(*cantPickupSound);
+    ResourceManager::PlaySound(*cantPickupSound);
     this->shaking = true;
-    this->lastShakeTime = GetTime();
+    this->lastShakeTime = GetGameTime();
+    StartTimer(TIMER_POWER_UP_SHAKE_END, POWER_UP_SHAKE_TIME);
 }
 
 void PowerUp::UpdateBounds(Rectangle playerBounds)
@@ -189,7 +246,7 @@ void PowerUp::UpdateBounds(Rectangle playerBounds)
 
 void PowerUp::ResetUseTime()
 {
-    effectiveUseTime = INFINITY;
+    float effectiveUseTime = INFINITY;
     switch (powerupType)
     {
     case SHIELD:
@@ -207,6 +264,17 @@ void PowerUp::ResetUseTime()
     default:
         break;
     }
+
+    used = false;
+    useEndTime = GetGameTime() + effectiveUseTime;
+    if (effectiveUseTime == INFINITY)
+    {
+        StopTimer(TIMER_POWER_UP_USE_END);
+    }
+    else
+    {
+        StartTimer(TIMER_POWER_UP_USE_END, effectiveUseTime);
+    }
 }
 
 const char *PowerUp::GetPowerUpName(PowerUpType type)
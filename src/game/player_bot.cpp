@@ -0,0 +1,164 @@
+#include "game/player_bot.hpp"
+#include "game/world.hpp"
+
+#include <math.h>
+
+// shortest offset from a to b in a world that wraps around its edges
+static Vector2 WrappedDelta(Vector2 a, Vector2 b, Rectangle bounds)
+{
+    Vector2 delta = Vector2Subtract(b, a);
+    if (delta.x > bounds.width / 2)
+    {
+        delta.x -= bounds.width;
+    }
+    else if (delta.x < -bounds.width / 2)
+    {
+        delta.x += bounds.width;
+    }
+    if (delta.y > bounds.height / 2)
+    {
+        delta.y -= bounds.height;
+    }
+    else if (delta.y < -bounds.height / 2)
+    {
+        delta.y += bounds.height;
+    }
+    return delta;
+}
+
+typedef struct BotThreat
+{
+    float distance;  // between the edges at the closest approach
+    Vector2 closest; // offset from the player at the closest approach
+    Vector2 relativeVelocity;
+} BotThreat;
+
+static void CheckThreat(Player *player, GameObject *object, Rectangle bounds, BotThreat *threat)
+{
+    const Vector2 delta = WrappedDelta(player->GetOrigin(), object->GetOrigin(), bounds);
+    const Vector2 relativeVelocity = Vector2Subtract(object->GetVelocity(), player->GetVelocity());
+    const float speed2 = Vector2LengthSqr(relativeVelocity);
+    float time = speed2 > 0 ? -Vector2DotProduct(delta, relativeVelocity) / speed2 : 0;
+    time = fminf(fmaxf(time, 0), BOT_LOOKAHEAD_TIME);
+
+    const Vector2 closest = Vector2Add(delta, Vector2Scale(relativeVelocity, time));
+    const float distance = Vector2Length(closest) - (object->GetBounds().width + CHARACTER_SIZE) / 2;
+    if (distance < threat->distance)
+    {
+        *threat = {distance, closest, relativeVelocity};
+    }
+}
+
+PlayerBot::PlayerBot()
+{
+    Reset(RNG_DEFAULT_SEED);
+}
+
+PlayerBot::~PlayerBot()
+{
+}
+
+void PlayerBot::Reset(uint64_t seed)
+{
+    rng.Seed(seed, NUM_RNG_STREAMS); // a stream the world doesn't use
+    nextDecisionTime = 0;
+    input = {0};
+}
+
+PlayerInput PlayerBot::Think(World *world)
+{
+    Player *player = world->player;
+    input.toggleShip = false;
+    if (!player->IsAlive() || world->gameTime < nextDecisionTime)
+    {
+        return input;
+    }
+    nextDecisionTime = world->gameTime + BOT_REACTION_TIME;
+
+    const Vector2 origin = player->GetOrigin();
+    const Rectangle bounds = world->bounds;
+    BotThreat threat = {BOT_DANGER_DISTANCE, {0, 0}, {0, 0}};
+    GameObject *target = nullptr;
+    float targetDistance = INFINITY;
+    GameObject *powerup = nullptr;
+    float powerupDistance = BOT_POWER_UP_DISTANCE;
+
+    for (GameObject *object : world->gameObjects)
+    {
+        const GameObjectType type = object->GetType();
+        const float distance = Vector2Length(WrappedDelta(origin, object->GetOrigin(), bounds));
+        if (type == POWER_UP)
+        {
+            if (distance < powerupDistance)
+            {
+                powerup = object;
+                powerupDistance = distance;
+            }
+            continue;
+        }
+        if (type != ASTEROID && type != ENEMY)
+        {
+            continue;
+        }
+        CheckThreat(player, object, bounds, &threat);
+        if (type == ENEMY)
+        {
+            for (Bullet &bullet : *((Enemy *)object)->GetBullets())
+            {
+                CheckThreat(player, &bullet, bounds, &threat);
+            }
+        }
+        // enemies first, they shoot back
+        const float priority = type == ENEMY ? distance * 0.5f : distance;
+        if (priority < targetDistance)
+        {
+            target = object;
+            targetDistance = priority;
+        }
+    }
+    for (Bullet &bullet : world->orphanBullets)
+    {
+        CheckThreat(player, &bullet, bounds, &threat);
+    }
+
+    input.boost = false;
+    input.shoot = false;
+    Vector2 heading;
+    if (threat.distance < BOT_DANGER_DISTANCE)
+    {
+        // move sideways to the path of the threat, away from where it passes
+        Vector2 side = {-threat.relativeVelocity.y, threat.relativeVelocity.x};
+        if (Vector2DotProduct(side, threat.closest) > 0)
+        {
+            side = Vector2Negate(side);
+        }
+        heading = Vector2LengthSqr(side) > 0 ? side : Vector2Negate(threat.closest);
+        input.accelerate = true;
+        input.boost = true;
+        input.shoot = true;
+    }
+    else if (powerup != nullptr)
+    {
+        heading = WrappedDelta(origin, powerup->GetOrigin(), bounds);
+        input.accelerate = true;
+    }
+    else if (target != nullptr)
+    {
+        // lead the target by the time the bullets take to reach it
+        const Vector2 delta = WrappedDelta(origin, target->GetOrigin(), bounds);
+        const float time = Vector2Length(delta) / BULLET_SPEED;
+        heading = Vector2Add(delta, Vector2Scale(Vector2Subtract(target->GetVelocity(), player->GetVelocity()), time));
+        input.accelerate = Vector2Length(delta) > BOT_CHASE_DISTANCE;
+    }
+    else
+    {
+        heading = player->GetForwardDir();
+        input.accelerate = true;
+    }
+
+    const float aimError = rng.GetFloat(-BOT_AIM_ERROR, BOT_AIM_ERROR);
+    const float angle = Vector2Angle(player->GetForwardDir(), heading) * RAD2DEG + aimError;
+    input.turn = fabsf(angle) < BOT_AIM_TOLERANCE / 2 ? 0 : (angle > 0 ? 1 : -1);
+    input.shoot = input.shoot || (target != nullptr && fabsf(angle) < BOT_AIM_TOLERANCE);
+    return input;
+}
@@ -0,0 +1,141 @@
+#include "game/point_grid.hpp"
+
+#include <math.h>
+
+PointGrid::PointGrid()
+{
+    this->area = {0, 0, 0, 0};
+    this->cellSize = 1;
+    this->columns = 1;
+    this->rows = 1;
+    this->tested = 0;
+}
+
+PointGrid::~PointGrid()
+{
+}
+
+int PointGrid::GetCell(Vector2 point)
+{
+    int column = (int)floorf((point.x - area.x) / cellSize);
+    int row = (int)floorf((point.y - area.y) / cellSize);
+    column = column < 0 ? 0 : (column >= columns ? columns - 1 : column);
+    row = row < 0 ? 0 : (row >= rows ? rows - 1 : row);
+    return row * columns + column;
+}
+
+void PointGrid::Begin(Rectangle area, float cellSize)
+{
+    this->area = area;
+    this->cellSize = cellSize;
+    this->columns = (int)fmaxf(1, ceilf(area.width / cellSize));
+    this->rows = (int)fmaxf(1, ceilf(area.height / cellSize));
+    this->tested = 0;
+
+    pending.clear();
+    pendingIds.clear();
+    pendingCells.clear();
+}
+
+void PointGrid::Add(Vector2 point, int id)
+{
+    pending.push_back(point);
+    pendingIds.push_back(id);
+    pendingCells.push_back(GetCell(point));
+}
+
+void PointGrid::Finish()
+{
+    // counting sort by cell
+    cellStart.assign(columns * rows + 1, 0);
+    for (size_t i = 0; i < pendingCells.size(); i++)
+    {
+        cellStart[pendingCells[i] + 1]++;
+    }
+    for (size_t c = 1; c < cellStart.size(); c++)
+    {
+        cellStart[c] += cellStart[c - 1];
+    }
+
+    xs.resize(pending.size());
+    ys.resize(pending.size());
+    ids.resize(pending.size());
+    inside.resize(pending.size());
+
+    // cellStart is used as the insert position of each cell and restored afterwards
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        const int index = cellStart[pendingCells[i]]++;
+        xs[index] = pending[i].x;
+        ys[index] = pending[i].y;
+        ids[index] = pendingIds[i];
+    }
+    for (size_t c = cellStart.size() - 1; c > 0; c--)
+    {
+        cellStart[c] = cellStart[c - 1];
+    }
+    cellStart[0] = 0;
+}
+
+void PointGrid::QueryConvex(Rectangle bounds, const HalfPlane *planes, size_t planeCount, std::vector<int> *hits)
+{
+    if (ids.empty())
+    {
+        return;
+    }
+
+    const int first = GetCell({bounds.x, bounds.y});
+    const int last = GetCell({bounds.x + bounds.width, bounds.y + bounds.height});
+    const int firstColumn = first % columns;
+    const int lastColumn = last % columns;
+
+    // the cells of a row are contiguous, so each row is a single batch
+    for (int row = first / columns; row <= last / columns; row++)
+    {
+        const int begin = cellStart[row * columns + firstColumn];
+        const int end = cellStart[row * columns + lastColumn + 1];
+        if (begin == end)
+        {
+            continue;
+        }
+
+        PointsInConvexPolygon(&xs[begin], &ys[begin], end - begin, planes, planeCount, &inside[begin]);
+        tested += end - begin;
+
+        for (int i = begin; i < end; i++)
+        {
+            if (inside[i])
+            {
+                hits->push_back(ids[i]);
+            }
+        }
+    }
+}
+
+void PointGrid::QueryPolygon(Rectangle bounds, const Vector2 *polygon, size_t count, std::vector<int> *hits)
+{
+    if (ids.empty())
+    {
+        return;
+    }
+
+    const int first = GetCell({bounds.x, bounds.y});
+    const int last = GetCell({bounds.x + bounds.width, bounds.y + bounds.height});
+    const int firstColumn = first % columns;
+    const int lastColumn = last % columns;
+
+    for (int row = first / columns; row <= last / columns; row++)
+    {
+        const int begin = cellStart[row * columns + firstColumn];
+        const int end = cellStart[row * columns + lastColumn + 1];
+        tested += end - begin;
+
+        for (int i = begin; i < end; i++)
+        {
+            if (CheckCollisionPointPoly({xs[i], ys[i]}, (Vector2 *)polygon, (int)count))
+            {
+                hits->push_back(ids[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,245 @@
+#include "game/timer_wheel.hpp"
+#include "game/objects/game_object.hpp"
+
+#include "raylib.h"
+
+#include <math.h>
+
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_MAX_ENTRIES 0xffff // entry indices are stored in the low 16 bits of the handles
+
+TimerWheel::TimerWheel()
+{
+    Reset(0);
+}
+
+TimerWheel::~TimerWheel()
+{
+}
+
+void TimerWheel::Reset(double time)
+{
+    // entries are kept so the handles still held by objects stay invalid
+    freeEntries.clear();
+    for (int i = (int)entries.size() - 1; i >= 0; i--)
+    {
+        if (entries[i].active)
+        {
+            entries[i].active = false;
+            entries[i].generation++;
+            entries[i].owner = nullptr;
+        }
+        entries[i].level = -1;
+        freeEntries.push_back(i);
+    }
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++)
+        {
+            slots[level][slot] = -1;
+        }
+    }
+    this->currentTick = (uint64_t)floor(time / TIMER_WHEEL_TICK);
+    this->activeCount = 0;
+    this->firedCount = 0;
+}
+
+void TimerWheel::Link(int index)
+{
+    TimerEntry *entry = &entries[index];
+
+    // the first level whose range covers the remaining time, timers too far away wait in the last level
+    // and are moved down when their slot comes up
+    uint64_t dueTick = entry->dueTick > currentTick ? entry->dueTick : currentTick;
+    const uint64_t maxDelta = ((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    if (dueTick - currentTick > maxDelta)
+    {
+        dueTick = currentTick + maxDelta;
+    }
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && dueTick - currentTick >= ((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+    const int slot = (dueTick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK;
+
+    entry->level = level;
+    entry->slot = slot;
+    entry->previous = -1;
+    entry->next = slots[level][slot];
+    if (entry->next != -1)
+    {
+        entries[entry->next].previous = index;
+    }
+    slots[level][slot] = index;
+}
+
+void TimerWheel::Unlink(int index)
+{
+    TimerEntry *entry = &entries[index];
+    if (entry->level < 0)
+    {
+        return;
+    }
+    if (entry->previous != -1)
+    {
+        entries[entry->previous].next = entry->next;
+    }
+    else
+    {
+        slots[entry->level][entry->slot] = entry->next;
+    }
+    if (entry->next != -1)
+    {
+        entries[entry->next].previous = entry->previous;
+    }
+    entry->level = -1;
+    entry->previous = -1;
+    entry->next = -1;
+}
+
+void TimerWheel::Free(int index)
+{
+    Unlink(index);
+    entries[index].active = false;
+    entries[index].generation++;
+    entries[index].owner = nullptr;
+    freeEntries.push_back(index);
+    activeCount--;
+}
+
+int TimerWheel::GetIndex(TimerHandle handle)
+{
+    const int index = (int)(handle & 0xffff) - 1;
+    if (index < 0 || index >= (int)entries.size())
+    {
+        return -1;
+    }
+    const TimerEntry *entry = &entries[index];
+    if (!entry->active || entry->generation != (uint16_t)(handle >> 16))
+    {
+        return -1;
+    }
+    return index;
+}
+
+TimerHandle TimerWheel::Schedule(GameObject *owner, TimerEvent event, float delay)
+{
+    int index;
+    if (!freeEntries.empty())
+    {
+        index = freeEntries.back();
+        freeEntries.pop_back();
+    }
+    else
+    {
+        if (entries.size() >= TIMER_WHEEL_MAX_ENTRIES)
+        {
+            TraceLog(LOG_WARNING, "Timer wheel is full, timer not scheduled");
+            return 0;
+        }
+        index = entries.size();
+        entries.push_back({0});
+    }
+
+    // timers always fire on a later tick, so a timer scheduled while firing doesn't fire in the same pass
+    const uint64_t ticks = (uint64_t)fmax(ceil(delay / TIMER_WHEEL_TICK), 1);
+
+    TimerEntry *entry = &entries[index];
+    entry->owner = owner;
+    entry->event = event;
+    entry->dueTick = currentTick + ticks;
+    entry->active = true;
+    Link(index);
+    activeCount++;
+
+    return ((TimerHandle)entries[index].generation << 16) | (TimerHandle)(index + 1);
+}
+
+void TimerWheel::Cancel(TimerHandle handle)
+{
+    const int index = GetIndex(handle);
+    if (index >= 0)
+    {
+        Free(index);
+    }
+}
+
+bool TimerWheel::IsPending(TimerHandle handle)
+{
+    return GetIndex(handle) >= 0;
+}
+
+float TimerWheel::GetTimeLeft(TimerHandle handle)
+{
+    const int index = GetIndex(handle);
+    if (index < 0)
+    {
+        return -1;
+    }
+    return (entries[index].dueTick - currentTick) * TIMER_WHEEL_TICK;
+}
+
+void TimerWheel::Cascade(int level)
+{
+    const int slot = (currentTick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK;
+    int index = slots[level][slot];
+    slots[level][slot] = -1;
+    while (index != -1)
+    {
+        const int next = entries[index].next;
+        Link(index);
+        index = next;
+    }
+}
+
+void TimerWheel::Advance(double time)
+{
+    firedCount = 0;
+    const uint64_t targetTick = (uint64_t)floor(time / TIMER_WHEEL_TICK);
+
+    while (currentTick < targetTick)
+    {
+        currentTick++;
+
+        // move the timers of the higher levels whose slot came up, from the top level down
+        for (int level = TIMER_WHEEL_LEVELS - 1; level > 0; level--)
+        {
+            if ((currentTick & (((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * level)) - 1)) == 0)
+            {
+                Cascade(level);
+            }
+        }
+
+        // detach the due timers first, callbacks can schedule and cancel timers
+        const int slot = currentTick & TIMER_WHEEL_SLOT_MASK;
+        firing.clear();
+        int index = slots[0][slot];
+        slots[0][slot] = -1;
+        while (index != -1)
+        {
+            TimerEntry *entry = &entries[index];
+            const int next = entry->next;
+            entry->level = -1;
+            entry->previous = -1;
+            entry->next = -1;
+            firing.push_back({index, entry->generation});
+            index = next;
+        }
+
+        for (size_t i = 0; i < firing.size(); i++)
+        {
+            TimerEntry *entry = &entries[firing[i].index];
+            // cancelled by an earlier callback, and maybe reused by a timer it scheduled that isn't due yet
+            if (!entry->active || entry->generation != firing[i].generation)
+            {
+                continue;
+            }
+            GameObject *owner = entry->owner;
+            const TimerEvent event = entry->event;
+            Free(firing[i].index);
+            firedCount++;
+            owner->OnTimer(event);
+        }
+    }
+}
@@ -0,0 +1,832 @@
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include "raylib.h"
+
+#include "game/world.hpp"
+#include "game/objects/asteroid.hpp"
+#include "game/objects/power_up.hpp"
+#include "utils/simd.hpp"
+#include "utils/profiler.hpp"
+#include "utils/counters.hpp"
+
+thread_local World *currentWorld = nullptr;
+
+World::World()
+{
+    this->player = nullptr;
+    this->bounds = {-WORLD_DEFAULT_WIDTH / 2, -WORLD_DEFAULT_HEIGHT / 2, WORLD_DEFAULT_WIDTH, WORLD_DEFAULT_HEIGHT};
+    this->gameTime = 0;
+    this->frameTime = 0;
+    this->seed = 0;
+    this->nextObjectId = 1;
+    this->scores = {0};
+    this->timers.Reset(gameTime);
+    this->bulletPairs = 0;
+    this->powerupSpawned = false;
+    this->spawnTimer = 0.0f;
+    this->asteroidsCount = 0;
+    this->shootersCount = 0;
+    this->stalkersCount = 0;
+    this->pulsersCount = 0;
+    this->entityBudget = 1.0f;
+    UpdateDifficultySettings(EASY);
+}
+
+World::~World()
+{
+    Clear();
+}
+
+void World::Clear()
+{
+    // the objects stop their timers and free their brain slots in this world
+    WorldScope scope(this);
+    DeleteObjects();
+    delete player;
+    player = nullptr;
+}
+
+void World::DeleteObjects()
+{
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        delete gameObjects[i];
+    }
+    gameObjects.clear();
+    orphanBullets.clear();
+    contactCache.Clear();
+}
+
+void World::Create(size_t numAsteroids, size_t numEnemies, uint64_t seed)
+{
+    WorldScope scope(this);
+
+    // every subsystem gets its own stream of the game seed
+    this->seed = seed;
+    for (int i = 0; i < NUM_RNG_STREAMS; i++)
+    {
+        rngs[i].Seed(seed, i);
+    }
+
+    asteroidsCount = 0;
+    shootersCount = 0;
+    stalkersCount = 0;
+    pulsersCount = 0;
+    powerupSpawned = false;
+    spawnTimer = 0.0f;
+
+    UpdateDifficultySettings(EASY); // difficulty starts at easy and is increased as the player scores more points
+
+    ResetScoreRegistry();
+
+    DeleteObjects();
+
+    // every game starts its own clock and object ids, so a seed plays the same game whatever was played before
+    gameTime = 0;
+    timers.Reset(gameTime);
+    aiScheduler.Reset();
+
+    // reset player
+    if (player != nullptr)
+    {
+        player->Reset();
+    }
+    else
+    {
+        player = new Player();
+    }
+    nextObjectId = player->GetId() + 1;
+
+    // create new game objects
+    for (size_t i = 0; i < numAsteroids + numEnemies; i++)
+    {
+        if (i < numAsteroids)
+        {
+            gameObjects.push_back(new Asteroid(diffSettings.asteroidSpeedMultiplier));
+            asteroidsCount++;
+        }
+        else
+        {
+            gameObjects.push_back(new Enemy(player, diffSettings.enemiesAttributes, SHOOTER));
+            shootersCount++;
+        }
+    }
+}
+
+void World::Step(float frameTime, bool updatePlayer, bool spawn)
+{
+    RECORDER_ZONE("World::Step");
+    WorldScope scope(this);
+    this->frameTime = frameTime;
+
+    // timers only run with the simulation, so pausing delays them without any bookkeeping
+    gameTime += frameTime;
+    timers.Advance(gameTime);
+
+    UpdateObjects(updatePlayer);
+
+    HandleCollisions();
+
+    if (spawn && player->IsAlive() && player->HasMoved())
+    {
+        RECORDER_ZONE("Spawn");
+        TryToSpawnObject(ASTEROID);
+        TryToSpawnObject(ENEMY);
+        TryToSpawnObject(POWER_UP);
+
+        // this score is scaled relative to frame time
+        AddScore(TIME_ALIVE, 1.0f);
+
+        // update difficulty settings if the player has scored enough points
+        if (GetTotalScore() >= 50000 && diffSettings.difficulty == EASY)
+        {
+            UpdateDifficultySettings(MEDIUM);
+        }
+        else if (GetTotalScore() >= 100000 && diffSettings.difficulty == MEDIUM)
+        {
+            UpdateDifficultySettings(HARD);
+        }
+    }
+
+    // reset spawnTimer
+    if (spawnTimer <= 0.0f)
+    {
+        spawnTimer = diffSettings.spawnRate;
+    }
+    spawnTimer -= frameTime;
+
+    RecordCounter("objects", gameObjects.size());
+    RecordCounter("orphan bullets", orphanBullets.size());
+}
+
+void World::UpdateDifficultySettings(Difficulty diff)
+{
+    DifficultySettings *settings = &diffSettings;
+
+    settings->difficulty = diff;
+    settings->maxAsteroids = fminf(powf(3, diff + 1), 18);                // 3, 9, 18
+    settings->maxShooters = powf(2, diff + 1);                            // 2, 4, 8
+    settings->maxStalkers = 1 + diff * 2;                                 // 1, 3, 5
+    settings->maxPulsers = fmaxf(diff * 2 - 1, 0);                        // 0, 1, 3
+    settings->maxEnemies = settings->maxShooters + settings->maxStalkers; // 3, 7, 13
+
+    settings->spawnRate = 1.0f - (float)diff * 0.12f;                                   // 1.0, 0.88, 0.76
+    settings->asteroidsSpawnChance = 0.35f + (float)(diffSettings.difficulty) * 0.15f;  // 0.35, 0.5, 0.65
+    settings->enemiesSpawnChance = 0.2f + (float)(diffSettings.difficulty + 1) * 0.1f;  // 0.2, 0.3, 0.4
+    settings->powerupSpawnChance = 0.15f + (float)(diffSettings.difficulty) * 0.2f;     // 0.15, 0.35, 0.55
+    settings->asteroidSpeedMultiplier = 1.0f + (float)(diffSettings.difficulty) * 0.5f; // 1.0, 1.5, 2.0
+    settings->scoreMultiplier = powf(1.2f, diffSettings.difficulty);
+
+    EnemyAttributes *enemiesAttr = &diffSettings.enemiesAttributes;
+
+    enemiesAttr->velocityMultiplier = 0.8f + (float)(diffSettings.difficulty) * 0.6f;       // 0.8, 1.4, 2.0
+    enemiesAttr->precision = 0.5f + (float)(diffSettings.difficulty) * 0.25f;               // 0.5, 0.75, 1.0
+    enemiesAttr->fireRateMultiplier = 0.5f + (float)(diffSettings.difficulty) * 0.25f;      // 0.5, 0.75, 1.0
+    enemiesAttr->bulletSpeedMultiplier = 0.9f + (float)(diffSettings.difficulty) * 0.2f;    // 0.9, 1.1, 1.3
+    enemiesAttr->probOfShootingAtPlayer = 0.35f + (float)(diffSettings.difficulty) * 0.25f; // 0.35, 0.6, 0.85
+    enemiesAttr->bulletsPerShot = 8 + 8 * diffSettings.difficulty;                          // 8, 16, 24
+}
+
+void World::UpdateObjects(bool updatePlayer)
+{
+    RECORDER_ZONE("UpdateObjects");
+    const float scoreMultiplier = diffSettings.scoreMultiplier;
+
+    // enemies decide first, then every object steers and moves with the decisions it has
+    flowField.Begin(bounds, player->GetOrigin());
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        GameObject *object = gameObjects[i];
+        if (object->GetType() == ENEMY)
+        {
+            Enemy *enemy = (Enemy *)object;
+            if (enemy->IsAlive())
+            {
+                flowField.AddAgent(enemy->GetOrigin());
+            }
+        }
+        else if (object->GetType() == ASTEROID && ((Asteroid *)object)->IsFloating())
+        {
+            flowField.AddObstacle(object->GetBounds());
+        }
+    }
+    flowField.Finish();
+    const BehaviorContext context = {player->GetOrigin(), !player->IsDead() && player->HasMoved()};
+    aiScheduler.Run(&enemyBrains, gameTime, player->GetCamera(), context);
+
+    if (updatePlayer)
+    {
+        player->Update();
+    }
+
+    // the bullets transferred by enemies dying in this frame were already stepped with their enemy
+    const size_t steppedOrphans = orphanBullets.size();
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        // sleeping objects are at rest until something wakes them up
+        if (!gameObjects[i]->IsSleeping())
+        {
+            gameObjects[i]->Update();
+        }
+
+        if (gameObjects[i]->GetType() == ASTEROID)
+        {
+            Asteroid *asteroid = (Asteroid *)gameObjects[i];
+            if (asteroid->IsDestroyed())
+            {
+                if (player->GetLives() > 0)
+                {
+                    AddScore(asteroid->GetVariant() == LARGE ? LARGE_ASTEROID_DESTROYED : SMALL_ASTEROID_DESTROYED, scoreMultiplier);
+                }
+                delete asteroid;
+                gameObjects.erase(gameObjects.begin() + i);
+                asteroidsCount--;
+                AddCounter(COUNTER_REMOVALS);
+                RecordInstant("destroy asteroid");
+            }
+        }
+        else if (gameObjects[i]->GetType() == ENEMY)
+        {
+            Enemy *enemy = (Enemy *)gameObjects[i];
+            if (enemy->IsDead())
+            {
+                // the world takes the bullets still in flight so the enemy can be freed right away
+                enemy->TransferBullets(&orphanBullets);
+
+                if (player->GetLives() > 0)
+                {
+                    // ScoreType enum enemies start at 11 with the same order as the EnemyType enum
+                    AddScore((ScoreType)((int)enemy->GetEnemyType() + 11), scoreMultiplier);
+                }
+                if (enemy->GetEnemyType() == SHOOTER)
+                {
+                    shootersCount--;
+                }
+                else if (enemy->GetEnemyType() == STALKER)
+                {
+                    stalkersCount--;
+                }
+                else if (enemy->GetEnemyType() == PULSER)
+                {
+                    pulsersCount--;
+                }
+                delete enemy;
+                gameObjects.erase(gameObjects.begin() + i);
+                AddCounter(COUNTER_REMOVALS);
+                RecordInstant("destroy enemy");
+            }
+        }
+        else if (gameObjects[i]->GetType() == POWER_UP)
+        {
+            PowerUp *powerup = (PowerUp *)gameObjects[i];
+            if (powerup->IsExpired())
+            {
+                delete powerup;
+                gameObjects.erase(gameObjects.begin() + i);
+                powerupSpawned = false;
+                AddCounter(COUNTER_REMOVALS);
+                RecordInstant("expire power up");
+            }
+            else if (powerup->IsPickedUp())
+            {
+                AddScore((ScoreType)powerup->GetType(), scoreMultiplier);
+                gameObjects.erase(gameObjects.begin() + i);
+                powerupSpawned = false;
+                AddCounter(COUNTER_REMOVALS);
+                RecordInstant("pick up power up");
+            }
+        }
+    }
+    gameObjects.shrink_to_fit();
+
+    // update the bullets of dead enemies and remove the ones that are no longer alive
+    for (size_t i = 0; i < steppedOrphans; i++)
+    {
+        orphanBullets[i].Update();
+    }
+    orphanBullets.erase(std::remove_if(orphanBullets.begin(), orphanBullets.end(), [](Bullet &bullet)
+                                                 { return !bullet.IsAlive(); }),
+                                  orphanBullets.end());
+
+    player->CleanBullets();
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        if (gameObjects[i]->GetType() == ENEMY)
+        {
+            Enemy *enemy = (Enemy *)gameObjects[i];
+            enemy->CleanBullets();
+        }
+    }
+}
+
+static bool IsSolverBody(GameObject *object)
+{
+    return object->GetType() == ASTEROID || object->GetType() == ENEMY;
+}
+
+void World::HandleCollisions()
+{
+    RECORDER_ZONE("HandleCollisions");
+    Vector2 pushVector = {0, 0};
+    auto bullets = player->GetBullets();
+    contactCache.BeginFrame();
+
+    // find the pairs of objects close to each other, including the ones across the world edges
+    const int64_t broadphaseStart = GetRecorderTime();
+    broadphase.Begin(bounds);
+    broadphase.Add(player);
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        broadphase.Add(gameObjects[i]);
+    }
+    const std::vector<BroadphasePair> &pairs = broadphase.FindPairs();
+    const int64_t pairsStart = GetRecorderTime();
+    RecordZone("Broadphase", broadphaseStart, pairsStart);
+    AddCounter(COUNTER_COLLISION_PAIRS, pairs.size());
+    int collisions = 0;
+
+    for (size_t p = 0; p < pairs.size(); p++)
+    {
+        GameObject *a = pairs[p].a;
+        GameObject *b = pairs[p].b;
+
+        // check collisions between the player and all main game objects
+        // the player is added first, so it is always the first object of its pairs
+        if (a == player)
+        {
+            if (player->CheckCollision(b, &pushVector, &contactCache, pairs[p].offset))
+            {
+                collisions++;
+                player->HandleCollision(b, &pushVector);
+                pushVector = Vector2Negate(pushVector);
+                b->HandleCollision(player, &pushVector);
+            }
+            continue;
+        }
+
+        if (a->IsSleeping() && b->IsSleeping()) // skip pairs at rest
+        {
+            continue;
+        }
+        if (a->CheckCollision(b, &pushVector, &contactCache, pairs[p].offset))
+        {
+            collisions++;
+            // asteroids and enemies bounce off each other, the contact is resolved with all the others after the loop
+            if (IsSolverBody(a) && IsSolverBody(b))
+            {
+                contactSolver.AddContact(a, b, pushVector, &contactCache);
+                continue;
+            }
+            a->HandleCollision(b, &pushVector);
+            pushVector = Vector2Negate(pushVector);
+            b->HandleCollision(a, &pushVector);
+        }
+    }
+    AddCounter(COUNTER_COLLISION_HITS, collisions);
+    const int64_t solverStart = GetRecorderTime();
+    RecordZone("Pairs", pairsStart, solverStart);
+    contactSolver.Solve(&contactCache);
+
+    // bodies that stayed at rest long enough fall asleep
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        gameObjects[i]->UpdateSleep(frameTime);
+    }
+
+    const int64_t bulletsStart = GetRecorderTime();
+    RecordZone("Contact solver", solverStart, bulletsStart);
+
+    // player bullets against asteroid and enemy hulls
+    // bullets are binned in a grid and each hull only tests the bullets of the cells it covers, in batches
+    bulletGrid.Begin(bounds, BULLET_GRID_CELL_SIZE);
+    for (size_t b = 0; b < bullets->size(); b++)
+    {
+        if ((*bullets)[b].IsAlive())
+        {
+            bulletGrid.Add((*bullets)[b].GetOrigin(), (int)b);
+        }
+    }
+    bulletGrid.Finish();
+    bulletPairs = 0;
+
+    HalfPlane planes[MAX_HULL_PLANES];
+    std::vector<int> hits;
+    for (size_t i = 0; i < gameObjects.size() && bulletGrid.GetPointCount() > 0; i++)
+    {
+        GameObject *object = gameObjects[i];
+        const std::vector<Vector2> &hull = object->GetHitbox();
+        if ((object->GetType() != ASTEROID && object->GetType() != ENEMY) || hull.size() < 3)
+        {
+            continue;
+        }
+        bulletPairs += bulletGrid.GetPointCount();
+
+        hits.clear();
+        const size_t planeCount = MakeConvexHalfPlanes(hull.data(), hull.size(), planes, MAX_HULL_PLANES);
+        if (planeCount > 0)
+        {
+            bulletGrid.QueryConvex(object->GetBounds(), planes, planeCount, &hits);
+        }
+        else
+        {
+            bulletGrid.QueryPolygon(object->GetBounds(), hull.data(), hull.size(), &hits);
+        }
+
+        for (size_t h = 0; h < hits.size(); h++)
+        {
+            Bullet *bullet = &(*bullets)[hits[h]];
+            if (!bullet->IsAlive()) // already hit something this frame
+            {
+                continue;
+            }
+            pushVector = {0, 0};
+            player->HandleBulletCollision(bullet, object, &pushVector);
+            object->HandleCollision(bullet, &pushVector);
+        }
+    }
+
+    AddCounter(COUNTER_BULLET_TESTS, bulletPairs);
+    const int64_t enemyBulletsStart = GetRecorderTime();
+    RecordZone("Player bullets", bulletsStart, enemyBulletsStart);
+
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        // enemy bullets
+        if (gameObjects[i]->GetType() == ENEMY)
+        {
+            Enemy *enemy = (Enemy *)gameObjects[i];
+            auto enemyBullets = enemy->GetBullets();
+            for (size_t b = 0; b < enemyBullets->size(); b++)
+            {
+                if ((*enemyBullets)[b].CheckCollision(player, &pushVector))
+                {
+                    (*enemyBullets)[b].HandleCollision(player, &pushVector);
+                    pushVector = Vector2Negate(pushVector);
+                    player->HandleCollision(&(*enemyBullets)[b], &pushVector);
+                }
+            }
+        }
+    }
+
+    // bullets of dead enemies
+    for (size_t b = 0; b < orphanBullets.size(); b++)
+    {
+        if (orphanBullets[b].CheckCollision(player, &pushVector))
+        {
+            orphanBullets[b].HandleCollision(player, &pushVector);
+            pushVector = Vector2Negate(pushVector);
+            player->HandleCollision(&orphanBullets[b], &pushVector);
+        }
+    }
+    RecordZone("Enemy bullets", enemyBulletsStart, GetRecorderTime());
+}
+
+int World::GetBudgetedMax(int maxCount)
+{
+    if (maxCount <= 0)
+    {
+        return 0;
+    }
+    return std::max(1, (int)(maxCount * entityBudget + 0.5f));
+}
+
+void World::TryToSpawnObject(GameObjectType type)
+{
+    if (spawnTimer > 0.0f)
+    {
+        return;
+    }
+
+    // with a lower budget there can be more objects than the max, they are not removed but no more are spawned
+    const int enemiesCount = shootersCount + stalkersCount + pulsersCount;
+    float spawnChance = 0.0f;
+    switch (type)
+    {
+    case ASTEROID:
+        spawnChance = asteroidsCount == diffSettings.maxAsteroids || (entityBudget < 1.0f && asteroidsCount >= GetBudgetedMax(diffSettings.maxAsteroids))
+                          ? 0.0f
+                          : diffSettings.asteroidsSpawnChance * entityBudget;
+        break;
+
+    case ENEMY:
+        spawnChance = enemiesCount == diffSettings.maxEnemies || (entityBudget < 1.0f && enemiesCount >= GetBudgetedMax(diffSettings.maxEnemies))
+                          ? 0.0f
+                          : diffSettings.enemiesSpawnChance * entityBudget;
+        break;
+    case POWER_UP:
+        // there is only one power up at a time, it isn't worth slowing down
+        spawnChance = powerupSpawned
+                          ? 0.0f
+                          : diffSettings.powerupSpawnChance;
+        break;
+    default:
+        return;
+    }
+
+    AddCounter(COUNTER_SPAWN_ROLLS);
+    if (GetGameRng(RNG_SPAWN)->GetInt(0, 100) >= spawnChance * 100)
+    {
+        return;
+    }
+
+    switch (type)
+    {
+    case ASTEROID:
+        gameObjects.push_back(new Asteroid(diffSettings.asteroidSpeedMultiplier));
+        asteroidsCount++;
+        AddCounter(COUNTER_SPAWNS);
+        RecordInstant("spawn asteroid");
+        break;
+    case ENEMY:
+    {
+
+        int enemyType = GetGameRng(RNG_SPAWN)->GetInt(0, 2);
+        if (enemyType == 0 && stalkersCount < GetBudgetedMax(diffSettings.maxStalkers))
+        {
+            gameObjects.push_back(new Enemy(player, diffSettings.enemiesAttributes, STALKER));
+            stalkersCount++;
+            AddCounter(COUNTER_SPAWNS);
+            RecordInstant("spawn stalker");
+        }
+        else if (enemyType == 1 && shootersCount < GetBudgetedMax(diffSettings.maxShooters))
+        {
+            gameObjects.push_back(new Enemy(player, diffSettings.enemiesAttributes, SHOOTER));
+            shootersCount++;
+            AddCounter(COUNTER_SPAWNS);
+            RecordInstant("spawn shooter");
+        }
+        else if (enemyType == 2 && pulsersCount < GetBudgetedMax(diffSettings.maxPulsers))
+        {
+            gameObjects.push_back(new Enemy(player, diffSettings.enemiesAttributes, PULSER));
+            pulsersCount++;
+            AddCounter(COUNTER_SPAWNS);
+            RecordInstant("spawn pulser");
+        } // else don't spawn anything
+        break;
+    }
+    case POWER_UP:
+        gameObjects.push_back(new PowerUp());
+        powerupSpawned = true;
+        AddCounter(COUNTER_SPAWNS);
+        RecordInstant("spawn power up");
+        break;
+    default:
+        break;
+    }
+}
+
+static size_t GetBulletsMemory(std::vector<Bullet> *bullets)
+{
+    size_t bytes = bullets->capacity() * sizeof(Bullet);
+    for (size_t i = 0; i < bullets->size(); i++)
+    {
+        bytes += (*bullets)[i].GetHitbox().capacity() * sizeof(Vector2);
+    }
+    return bytes;
+}
+
+void World::GetMemoryUsage(MemoryReport *report)
+{
+    size_t entities = gameObjects.capacity() * sizeof(GameObject *);
+    size_t bullets = GetBulletsMemory(&orphanBullets);
+    if (player != nullptr)
+    {
+        entities += sizeof(Player) + player->GetHitbox().capacity() * sizeof(Vector2);
+        entities += player->GetPowerups().size() * sizeof(PowerUp);
+        bullets += GetBulletsMemory(player->GetBullets());
+    }
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        GameObject *object = gameObjects[i];
+        entities += object->GetHitbox().capacity() * sizeof(Vector2);
+        switch (object->GetType())
+        {
+        case ASTEROID:
+            entities += sizeof(Asteroid);
+            break;
+        case ENEMY:
+            entities += sizeof(Enemy);
+            bullets += GetBulletsMemory(((Enemy *)object)->GetBullets());
+            break;
+        case POWER_UP:
+            entities += sizeof(PowerUp);
+            break;
+        default:
+            entities += sizeof(GameObject);
+            break;
+        }
+    }
+    AddMemoryUsage(report, MEMORY_ENTITIES, entities, 0);
+    AddMemoryUsage(report, MEMORY_BULLETS, bullets, 0);
+}
+
+void World::Capture(GameSnapshot *snapshot)
+{
+    WorldScope scope(this);
+    ClearGameSnapshot(snapshot);
+
+    WorldRecord *worldRecord = &snapshot->world;
+    worldRecord->gameTime = gameTime;
+    worldRecord->seed = seed;
+    worldRecord->difficulty = diffSettings.difficulty;
+    worldRecord->spawnTimer = spawnTimer;
+    worldRecord->powerupSpawned = powerupSpawned;
+    worldRecord->asteroidsCount = asteroidsCount;
+    worldRecord->shootersCount = shootersCount;
+    worldRecord->stalkersCount = stalkersCount;
+    worldRecord->pulsersCount = pulsersCount;
+
+    // world objects first, so their records are the first objects of the snapshot
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        gameObjects[i]->Capture(snapshot);
+    }
+    worldRecord->objectCount = gameObjects.size();
+    worldRecord->playerObject = player->Capture(snapshot);
+
+    // the contacts warm start the collisions of the next step, they are saved by the records of their objects
+    std::unordered_map<unsigned int, int> objectRecords;
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+        objectRecords[gameObjects[i]->GetId()] = i;
+    }
+    objectRecords[player->GetId()] = worldRecord->playerObject;
+    contactCache.ForEach([&](unsigned int a, unsigned int b, Contact contact)
+                         {
+                             auto recordA = objectRecords.find(a);
+                             auto recordB = objectRecords.find(b);
+                             if (recordA != objectRecords.end() && recordB != objectRecords.end())
+                             {
+                                 // zeroed and copied by fields, the padding of the records is written to the file too
+                                 ContactRecord record;
+                                 memset(&record, 0, sizeof(record));
+                                 record.a = recordA->second;
+                                 record.b = recordB->second;
+                                 record.contact.separated = contact.separated;
+                                 record.contact.separatingAxis = contact.separatingAxis;
+                                 record.contact.normal = contact.normal;
+                                 record.contact.depth = contact.depth;
+                                 record.contact.normalImpulse = contact.normalImpulse;
+                                 record.contact.touchingFrames = contact.touchingFrames;
+                                 record.contact.lastFrame = contact.lastFrame;
+                                 snapshot->contacts.push_back(record);
+                             } });
+    // in a fixed order, the same world always gives the same snapshot
+    std::sort(snapshot->contacts.begin(), snapshot->contacts.end(), [](const ContactRecord &x, const ContactRecord &y)
+              { return x.a != y.a ? x.a < y.a : x.b < y.b; });
+
+    worldRecord->orphanFirst = snapshot->bullets.size();
+    worldRecord->orphanCount = orphanBullets.size();
+    for (size_t i = 0; i < orphanBullets.size(); i++)
+    {
+        orphanBullets[i].CaptureBullet(snapshot);
+    }
+
+    for (int i = 0; i < NUM_RNG_STREAMS; i++)
+    {
+        worldRecord->rngs[i] = rngs[i].GetState();
+    }
+    SaveScoreRegistry(worldRecord->scores, &worldRecord->totalScore);
+}
+
+void World::Restore(const GameSnapshot *snapshot)
+{
+    WorldScope scope(this);
+    const WorldRecord *worldRecord = &snapshot->world;
+
+    // the objects are created again from their records with new ids, the contacts are added back once they exist
+    DeleteObjects();
+
+    // timers are scheduled again by the objects, relative to the restored game time
+    gameTime = worldRecord->gameTime;
+    timers.Reset(gameTime);
+
+    seed = worldRecord->seed;
+    UpdateDifficultySettings((Difficulty)worldRecord->difficulty);
+    spawnTimer = worldRecord->spawnTimer;
+    powerupSpawned = worldRecord->powerupSpawned;
+    asteroidsCount = worldRecord->asteroidsCount;
+    shootersCount = worldRecord->shootersCount;
+    stalkersCount = worldRecord->stalkersCount;
+    pulsersCount = worldRecord->pulsersCount;
+
+    player->Reset();
+    player->Restore(snapshot, &snapshot->objects[worldRecord->playerObject]);
+
+    std::vector<unsigned int> objectIds(snapshot->objects.size(), 0);
+    objectIds[worldRecord->playerObject] = player->GetId();
+    for (int i = 0; i < worldRecord->objectCount; i++)
+    {
+        const ObjectRecord *record = &snapshot->objects[i];
+        GameObject *object = nullptr;
+        switch (record->type)
+        {
+        case ASTEROID:
+            object = new Asteroid(record->origin, (AsteroidVariant)record->kind, 1);
+            break;
+        case ENEMY:
+            object = new Enemy(record->origin, player, diffSettings.enemiesAttributes, GetEnemyDefinition((EnemyType)record->kind));
+            break;
+        case POWER_UP:
+            object = new PowerUp(record->origin, (PowerUpType)record->kind, true);
+            break;
+        default:
+            break;
+        }
+        if (object == nullptr)
+        {
+            continue;
+        }
+        object->Restore(snapshot, record);
+        gameObjects.push_back(object);
+        objectIds[i] = object->GetId();
+    }
+
+    for (size_t i = 0; i < snapshot->contacts.size(); i++)
+    {
+        const ContactRecord *record = &snapshot->contacts[i];
+        if (record->a < 0 || record->a >= (int)objectIds.size() || record->b < 0 || record->b >= (int)objectIds.size())
+        {
+            continue;
+        }
+        const unsigned int a = objectIds[record->a];
+        const unsigned int b = objectIds[record->b];
+        if (a != 0 && b != 0)
+        {
+            contactCache.Add(a, b, record->contact);
+        }
+    }
+
+    for (int i = 0; i < worldRecord->orphanCount; i++)
+    {
+        const BulletRecord *record = &snapshot->bullets[worldRecord->orphanFirst + i];
+        orphanBullets.push_back(Bullet(record->object.origin, record->object.forwardDir, 0, record->isPlayerBullet));
+        orphanBullets.back().RestoreBullet(snapshot, record);
+    }
+
+    // the objects created above took numbers from the streams, so they are restored last
+    for (int i = 0; i < NUM_RNG_STREAMS; i++)
+    {
+        rngs[i].SetState(worldRecord->rngs[i]);
+    }
+    LoadScoreRegistry(worldRecord->scores, worldRecord->totalScore);
+}
+
+World *GetCurrentWorld()
+{
+    return currentWorld;
+}
+
+void SetCurrentWorld(World *world)
+{
+    currentWorld = world;
+}
+
+double GetGameTime()
+{
+    return currentWorld->gameTime;
+}
+
+TimerWheel *GetGameTimers()
+{
+    return &currentWorld->timers;
+}
+
+FlowField *GetGameFlowField()
+{
+    return &currentWorld->flowField;
+}
+
+EnemyBrains *GetGameEnemyBrains()
+{
+    return &currentWorld->enemyBrains;
+}
+
+Rng *GetGameRng(RngStream stream)
+{
+    return &currentWorld->rngs[stream];
+}
+
+ScoreRegistry *GetGameScores()
+{
+    return &currentWorld->scores;
+}
+
+unsigned int NewObjectId()
+{
+    static thread_local unsigned int looseObjectId = 1; // objects of tools and benchmarks, outside of any world
+    return currentWorld != nullptr ? currentWorld->nextObjectId++ : looseObjectId++;
+}
+
+float GetWorldFrameTime()
+{
+    return currentWorld->frameTime;
+}
+
+Rectangle GetWorldBounds()
+{
+    return currentWorld->bounds;
+}
@@ -24,11 +24,13 @@
 
 typedef void (*CoreFunc)(void);
 typedef bool (*CoreFuncBool)(void);
+typedef void (*CoreFuncArgs)(int, char **);
 
 HINSTANCE GameDLL = nullptr;
 CoreFuncBool InitGame = nullptr;
 CoreFuncBool GameLoop = nullptr;
 CoreFunc ExitGame = nullptr;
+CoreFuncArgs ParseGameArgs = nullptr;
 
 // for notifiying that the dll has been reloaded
 float notifyShowTime = 0; // in seconds
@@ -63,9 +65,48 @@ void DeleteTempDLL()
 #else
 
 #include "game/game.hpp"
+#include "utils/counters.hpp"
+
+#include <stdlib.h>
+#include <new>
+
+// only the game counts its allocations, the core library doesn't replace the allocator of the programs embedding it.
+// Each thread adds to its own counters, the flight recorder reads them once per frame
+static thread_local bool countingAllocation = false;
+
+void *operator new(size_t size)
+{
+    // the first count of a thread allocates its counters
+    if (!countingAllocation)
+    {
+        countingAllocation = true;
+        AddCounter(COUNTER_ALLOCATIONS);
+        countingAllocation = false;
+    }
+    void *ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
 
 #endif // WINDOWS_HOT_RELOAD
 
+// command line, given to the game every time it is loaded
+int gameArgc = 0;
+char **gameArgv = nullptr;
+
 void InitRaylib()
 {
     SetConfigFlags(FLAG_WINDOW_RESIZABLE);
@@ -106,6 +147,12 @@ bool LoadGame()
         TraceLog(LOG_ERROR, "Failed to load ExitGame\n");
         return false;
     }
+    ParseGameArgs = (CoreFuncArgs)GetProcAddress(GameDLL, "ParseGameArgs");
+    if (!ParseGameArgs)
+    {
+        TraceLog(LOG_ERROR, "Failed to load ParseGameArgs\n");
+        return false;
+    }
     // game dll loaded successfully
     notifyShowTime = 2.0f;
     lastDllLoadSuccess = true;
@@ -115,6 +162,7 @@ bool LoadGame()
     // -----------------------------------------------------------------------------
 #endif // WINDOWS_HOT_RELOAD
 
+    ParseGameArgs(gameArgc, gameArgv);
     return InitGame();
 }
 
@@ -140,8 +188,10 @@ void ExecuteGameLoop()
     GameLoop();
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    gameArgc = argc;
+    gameArgv = argv;
     InitRaylib();
     if (!LoadGame())
     {
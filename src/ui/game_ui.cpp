@@ -15,6 +15,7 @@
 #include "ui/components/menus/credits.hpp"
 
 char fpsButtonText[20];
+char resolutionButtonText[24];
 
 UIObject *CreateMainMenu()
 {
@@ -167,6 +168,26 @@ void ChangeFPSButtonFunc(Button *button)
     button->SetText(fpsButtonText);
 }
 
+void SetResolutionButtonText()
+{
+    const float scale = gameState.resolution.GetFixedScale();
+    if (scale == 0)
+    {
+        sprintf(resolutionButtonText, "Resolution: Auto");
+    }
+    else
+    {
+        sprintf(resolutionButtonText, "Resolution: %d%%", (int)(scale * 100));
+    }
+}
+
+void ChangeResolutionButtonFunc(Button *button)
+{
+    ChangeResolutionScale();
+    SetResolutionButtonText();
+    button->SetText(resolutionButtonText);
+}
+
 UIObject *CreateControlsMenu()
 {
     Button *backButton = new Button(Vector2{0, 0}, nullptr, "Back", BUTTON_PRIMARY, BUTTON_MEDIUM, []()
@@ -212,23 +233,28 @@ UIObject *CreateOptionsMenu()
         sprintf(fpsButtonText, "FPS: %d", gameState.fps);
     }
 
+    SetResolutionButtonText();
+
     Button *changeFPSButton = new Button(Vector2{0, 0}, nullptr, fpsButtonText, BUTTON_PRIMARY, BUTTON_MEDIUM, nullptr);
+    Button *resolutionButton = new Button(Vector2{0, 0}, nullptr, resolutionButtonText, BUTTON_PRIMARY, BUTTON_MEDIUM, nullptr);
     Button *backButton = new Button(Vector2{0, 0}, nullptr, "Back", BUTTON_PRIMARY, BUTTON_MEDIUM, nullptr);
 
     backButton->OnClick([]()
                         { PreviousScreen(); });
     changeFPSButton->OnClick([changeFPSButton]()
                              { ChangeFPSButtonFunc(changeFPSButton); });
+    resolutionButton->OnClick([resolutionButton]()
+                              { ChangeResolutionButtonFunc(resolutionButton); });
 
 #ifdef PLATFORM_DESKTOP
-    const int optionButtonCount = 3;
+    const int optionButtonCount = 4;
     Button *fullscreenButton = new Button(Vector2{0, 0}, nullptr, "Fullscreen", BUTTON_PRIMARY, BUTTON_MEDIUM, nullptr);
     fullscreenButton->OnClick([]()
                               { ToggleGameFullscreen(); });
-    Button *buttons[optionButtonCount] = {fullscreenButton, changeFPSButton, backButton};
+    Button *buttons[optionButtonCount] = {fullscreenButton, changeFPSButton, resolutionButton, backButton};
 #else
-    const int optionButtonCount = 2;
-    Button *buttons[optionButtonCount] = {changeFPSButton, backButton};
+    const int optionButtonCount = 3;
+    Button *buttons[optionButtonCount] = {changeFPSButton, resolutionButton, backButton};
 #endif // PLATFORM_DESKTOP
 
     Rectangle optionButtonRec = CreateCenteredButtonRec(buttons, optionButtonCount);
@@ -0,0 +1,87 @@
+#include "utils/counters.hpp"
+#include "utils/profiler.hpp"
+
+#include <atomic>
+
+#define COUNTER_CACHE_LINE 64 // bytes
+
+static const char *counterNames[] = {
+    "collision pairs",
+    "aabb rejects",
+    "sat tests",
+    "collision hits",
+    "bullet tests",
+    "draw batches",
+    "sprites",
+    "spawn rolls",
+    "spawns",
+    "sounds played",
+    "sounds skipped",
+    "removals",
+    "allocations",
+};
+static_assert(sizeof(counterNames) / sizeof(counterNames[0]) == NUM_COUNTERS, "every counter has a name");
+
+// the counters of one thread, only written by it. Blocks are never freed so the counts of finished threads stay in the totals.
+// Aligned to a cache line, so the blocks of two threads never share one
+typedef struct alignas(COUNTER_CACHE_LINE) CounterBlock
+{
+    std::atomic<uint64_t> values[NUM_COUNTERS];
+    CounterBlock *next;
+} CounterBlock;
+
+static std::atomic<CounterBlock *> counterBlocks = nullptr;
+
+static CounterBlock *AddCounterBlock()
+{
+    CounterBlock *block = new CounterBlock();
+    block->next = counterBlocks.load();
+    while (!counterBlocks.compare_exchange_weak(block->next, block))
+    {
+    }
+    return block;
+}
+
+static thread_local CounterBlock *threadCounters = AddCounterBlock();
+
+// frames are only closed by the main thread
+static uint64_t frameStartTotals[NUM_COUNTERS];
+static uint64_t frameValues[NUM_COUNTERS];
+
+void AddCounter(CounterID id, uint64_t amount)
+{
+    // a plain add, the owner is the only writer and the atomic only keeps the readers from seeing a torn value
+    std::atomic<uint64_t> *value = &threadCounters->values[id];
+    value->store(value->load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+const char *GetCounterName(CounterID id)
+{
+    return counterNames[id];
+}
+
+uint64_t GetCounterTotal(CounterID id)
+{
+    uint64_t total = 0;
+    for (CounterBlock *block = counterBlocks.load(); block != nullptr; block = block->next)
+    {
+        total += block->values[id].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void EndCountersFrame()
+{
+    for (int i = 0; i < NUM_COUNTERS; i++)
+    {
+        const uint64_t total = GetCounterTotal((CounterID)i);
+        frameValues[i] = total - frameStartTotals[i];
+        frameStartTotals[i] = total;
+        RecordCounter(counterNames[i], frameValues[i]);
+    }
+}
+
+uint64_t GetCounterFrameValue(CounterID id)
+{
+    return frameValues[id];
+}
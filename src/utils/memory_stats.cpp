@@ -0,0 +1,133 @@
+#include "utils/memory_stats.hpp"
+
+static const char *memoryCategoryNames[] = {
+    "textures",
+    "background",
+    "render targets",
+    "sounds",
+    "sound aliases",
+    "font",
+    "entities",
+    "bullets",
+};
+static_assert(sizeof(memoryCategoryNames) / sizeof(memoryCategoryNames[0]) == NUM_MEMORY_CATEGORIES, "every category has a name");
+
+// above what the game uses now, so only growth warns
+static MemoryUsage memoryBudgets[NUM_MEMORY_CATEGORIES] = {
+    {0, 16 * MEMORY_MB},            // textures
+    {0, 64 * MEMORY_MB},            // background, 4096x4096 rgba
+    {0, 64 * MEMORY_MB},            // render targets, a 4k window
+    {24 * MEMORY_MB, 0},            // sounds
+    {MEMORY_MB, 0},                 // sound aliases
+    {4 * MEMORY_MB, 8 * MEMORY_MB}, // font
+    {4 * MEMORY_MB, 0},             // entities
+    {4 * MEMORY_MB, 0},             // bullets
+};
+
+#ifdef PLATFORM_WEB
+static bool memoryBudgetsEnabled = true; // the heap can't grow past BUILD_WEB_HEAP_SIZE
+#else
+static bool memoryBudgetsEnabled = false;
+#endif // PLATFORM_WEB
+
+static bool overBudget[NUM_MEMORY_CATEGORIES];
+
+const char *GetMemoryCategoryName(MemoryCategory category)
+{
+    return memoryCategoryNames[category];
+}
+
+void AddMemoryUsage(MemoryReport *report, MemoryCategory category, size_t cpu, size_t gpu)
+{
+    report->categories[category].cpu += cpu;
+    report->categories[category].gpu += gpu;
+}
+
+MemoryUsage GetTotalMemoryUsage(const MemoryReport *report)
+{
+    MemoryUsage total = {0, 0};
+    for (int i = 0; i < NUM_MEMORY_CATEGORIES; i++)
+    {
+        total.cpu += report->categories[i].cpu;
+        total.gpu += report->categories[i].gpu;
+    }
+    return total;
+}
+
+size_t GetTextureBytes(Texture2D texture)
+{
+    if (texture.id == 0)
+    {
+        return 0;
+    }
+    size_t bytes = 0;
+    int width = texture.width;
+    int height = texture.height;
+    for (int i = 0; i < texture.mipmaps; i++)
+    {
+        bytes += GetPixelDataSize(width, height, texture.format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+size_t GetSoundBytes(Sound sound)
+{
+    if (sound.stream.buffer == nullptr)
+    {
+        return 0;
+    }
+    return (size_t)sound.frameCount * sound.stream.channels * sound.stream.sampleSize / 8;
+}
+
+void SetMemoryBudget(MemoryCategory category, MemoryUsage budget)
+{
+    memoryBudgets[category] = budget;
+}
+
+MemoryUsage GetMemoryBudget(MemoryCategory category)
+{
+    return memoryBudgets[category];
+}
+
+void EnableMemoryBudgets(bool enable)
+{
+    memoryBudgetsEnabled = enable;
+}
+
+bool AreMemoryBudgetsEnabled()
+{
+    return memoryBudgetsEnabled;
+}
+
+bool IsOverMemoryBudget(const MemoryReport *report, MemoryCategory category)
+{
+    const MemoryUsage usage = report->categories[category];
+    const MemoryUsage budget = memoryBudgets[category];
+    return (budget.cpu > 0 && usage.cpu > budget.cpu) || (budget.gpu > 0 && usage.gpu > budget.gpu);
+}
+
+int CheckMemoryBudgets(const MemoryReport *report)
+{
+    if (!memoryBudgetsEnabled)
+    {
+        return 0;
+    }
+    int count = 0;
+    for (int i = 0; i < NUM_MEMORY_CATEGORIES; i++)
+    {
+        const MemoryCategory category = (MemoryCategory)i;
+        const bool over = IsOverMemoryBudget(report, category);
+        if (over && !overBudget[i])
+        {
+            const MemoryUsage usage = report->categories[i];
+            const MemoryUsage budget = memoryBudgets[i];
+            TraceLog(LOG_WARNING, "MEMORY: %s over budget, cpu %.2f/%.2f MB, gpu %.2f/%.2f MB", memoryCategoryNames[i],
+                     (float)usage.cpu / MEMORY_MB, (float)budget.cpu / MEMORY_MB, (float)usage.gpu / MEMORY_MB, (float)budget.gpu / MEMORY_MB);
+        }
+        overBudget[i] = over;
+        count += over;
+    }
+    return count;
+}
@@ -0,0 +1,260 @@
+#include "utils/profiler.hpp"
+
+#include "raylib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+
+static std::atomic<bool> recorderEnabled = false;
+static const std::chrono::steady_clock::time_point recorderEpoch = std::chrono::steady_clock::now();
+
+// the ring is written with a shared index so any thread can record, the game only records from the main thread
+static RecorderEvent events[RECORDER_CAPACITY];
+static std::atomic<uint64_t> nextEvent = 0;
+
+static std::atomic<int> nextThread = 0;
+static thread_local int recorderThread = nextThread++;
+static std::atomic<const char *> threadNames[RECORDER_MAX_THREADS];
+
+// frames are only begun and ended by the main thread
+static int64_t frameStart = -1;
+static int frameIndex = 0;
+static int64_t lastDumpTime = -(int64_t)(RECORDER_DUMP_COOLDOWN * 1e9);
+static int dumps = 0;
+
+// a capture copies the ring to its file at the end of each frame
+static FILE *captureFile = nullptr;
+static char captureBuffer[TRACE_CAPTURE_BUFFER];
+static uint64_t captureNext = 0; // next event of the ring to write
+static size_t capturedEvents = 0;
+static size_t droppedEvents = 0;
+static bool captureFirst = true; // no event written yet, so the next one isn't preceded by a comma
+
+void EnableFlightRecorder(bool enable)
+{
+    recorderEnabled.store(enable, std::memory_order_relaxed);
+}
+
+bool IsFlightRecorderEnabled()
+{
+    return recorderEnabled.load(std::memory_order_relaxed);
+}
+
+int64_t GetRecorderTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - recorderEpoch).count();
+}
+
+static void Record(const char *name, RecorderEventType type, int64_t start, int64_t duration, int64_t value)
+{
+    RecorderEvent *event = &events[nextEvent.fetch_add(1, std::memory_order_relaxed) % RECORDER_CAPACITY];
+    *event = {name, start, duration, value, recorderThread, type};
+}
+
+void RecordZone(const char *name, int64_t start, int64_t end)
+{
+    if (IsFlightRecorderEnabled())
+    {
+        Record(name, RECORDER_ZONE, start, end - start, 0);
+    }
+}
+
+void RecordInstant(const char *name)
+{
+    if (IsFlightRecorderEnabled())
+    {
+        Record(name, RECORDER_INSTANT, GetRecorderTime(), 0, 0);
+    }
+}
+
+void RecordCounter(const char *name, int64_t value)
+{
+    if (IsFlightRecorderEnabled())
+    {
+        Record(name, RECORDER_COUNTER, GetRecorderTime(), 0, value);
+    }
+}
+
+void NameRecorderThread(const char *name)
+{
+    if (recorderThread < RECORDER_MAX_THREADS)
+    {
+        threadNames[recorderThread].store(name, std::memory_order_relaxed);
+    }
+}
+
+// chrome trace events, timestamps in us
+static void WriteTraceEvent(FILE *file, const RecorderEvent *event, bool *first)
+{
+    fprintf(file, *first ? "\n" : ",\n");
+    *first = false;
+    switch (event->type)
+    {
+    case RECORDER_ZONE:
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", event->name,
+                event->thread, event->start / 1e3, event->duration / 1e3);
+        break;
+    case RECORDER_INSTANT:
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", event->name,
+                event->thread, event->start / 1e3);
+        break;
+    case RECORDER_COUNTER:
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                event->name, event->thread, event->start / 1e3, (long long)event->value);
+        break;
+    }
+}
+
+static void WriteThreadNames(FILE *file, bool *first)
+{
+    for (int i = 0; i < RECORDER_MAX_THREADS; i++)
+    {
+        const char *name = threadNames[i].load(std::memory_order_relaxed);
+        if (name != nullptr)
+        {
+            fprintf(file, *first ? "\n" : ",\n");
+            *first = false;
+            fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", i, name);
+        }
+    }
+}
+
+// writes the events of the ring that started in the window
+static bool WriteTrace(const char *fileName, int64_t windowStart)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    const uint64_t end = nextEvent.load(std::memory_order_relaxed);
+    const uint64_t begin = end > RECORDER_CAPACITY ? end - RECORDER_CAPACITY : 0;
+    bool first = true;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    WriteThreadNames(file, &first);
+    for (uint64_t i = begin; i < end; i++)
+    {
+        const RecorderEvent *event = &events[i % RECORDER_CAPACITY];
+        if (event->start >= windowStart)
+        {
+            WriteTraceEvent(file, event, &first);
+        }
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+// copies the events recorded since the last flush to the capture file, the ones already overwritten are lost
+static void FlushTraceCapture()
+{
+    const uint64_t end = nextEvent.load(std::memory_order_relaxed);
+    if (end - captureNext > RECORDER_CAPACITY)
+    {
+        droppedEvents += end - captureNext - RECORDER_CAPACITY;
+        captureNext = end - RECORDER_CAPACITY;
+    }
+    capturedEvents += end - captureNext;
+    for (; captureNext < end; captureNext++)
+    {
+        WriteTraceEvent(captureFile, &events[captureNext % RECORDER_CAPACITY], &captureFirst);
+    }
+}
+
+bool StartTraceCapture(const char *fileName)
+{
+    if (captureFile != nullptr)
+    {
+        return false;
+    }
+    captureFile = fopen(fileName, "w");
+    if (captureFile == nullptr)
+    {
+        TraceLog(LOG_WARNING, "RECORDER: Failed to open %s", fileName);
+        return false;
+    }
+    // the file is written in big blocks, not on every frame
+    setvbuf(captureFile, captureBuffer, _IOFBF, TRACE_CAPTURE_BUFFER);
+    fprintf(captureFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    captureFirst = true;
+    captureNext = nextEvent.load(std::memory_order_relaxed);
+    capturedEvents = 0;
+    droppedEvents = 0;
+    EnableFlightRecorder(true);
+    TraceLog(LOG_INFO, "RECORDER: Capturing a trace to %s", fileName);
+    return true;
+}
+
+void StopTraceCapture()
+{
+    if (captureFile == nullptr)
+    {
+        return;
+    }
+    FlushTraceCapture();
+    // named at the end, threads started during the capture have their names by now
+    WriteThreadNames(captureFile, &captureFirst);
+    fprintf(captureFile, "\n]}\n");
+    const bool written = fclose(captureFile) == 0;
+    captureFile = nullptr;
+    if (written)
+    {
+        TraceLog(LOG_INFO, "RECORDER: Trace capture stopped, %d events written, %d dropped", (int)capturedEvents, (int)droppedEvents);
+    }
+    else
+    {
+        TraceLog(LOG_WARNING, "RECORDER: Failed to write the trace capture");
+    }
+}
+
+bool IsCapturingTrace()
+{
+    return captureFile != nullptr;
+}
+
+void BeginRecorderFrame()
+{
+    if (IsFlightRecorderEnabled())
+    {
+        frameStart = GetRecorderTime();
+    }
+}
+
+bool EndRecorderFrame()
+{
+    if (!IsFlightRecorderEnabled() || frameStart < 0)
+    {
+        return false;
+    }
+
+    const int64_t frameEnd = GetRecorderTime();
+    const int64_t frameTime = frameEnd - frameStart;
+    Record("Frame", RECORDER_ZONE, frameStart, frameTime, 0);
+    frameStart = -1;
+    frameIndex++;
+
+    if (captureFile != nullptr)
+    {
+        FlushTraceCapture();
+    }
+
+    if (frameTime < (int64_t)(RECORDER_SPIKE_TIME * 1e9) || dumps >= RECORDER_MAX_DUMPS ||
+        frameEnd - lastDumpTime < (int64_t)(RECORDER_DUMP_COOLDOWN * 1e9))
+    {
+        return false;
+    }
+
+    const char *fileName = TextFormat("hitch_%d.json", frameIndex);
+    if (!WriteTrace(fileName, frameEnd - (int64_t)(RECORDER_WINDOW * 1e9)))
+    {
+        TraceLog(LOG_WARNING, "RECORDER: Failed to write %s", fileName);
+        return false;
+    }
+    lastDumpTime = frameEnd;
+    dumps++;
+    TraceLog(LOG_INFO, "RECORDER: Frame %d took %.1f ms, wrote the last %.0f s to %s", frameIndex, frameTime / 1e6,
+             RECORDER_WINDOW, fileName);
+    return true;
+}
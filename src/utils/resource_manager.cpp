@@ -1,4 +1,6 @@
 #include "utils/resource_manager.hpp"
+#include "utils/profiler.hpp"
+#include "utils/counters.hpp"
 #include <map>
 
 using namespace std;
@@ -59,11 +61,14 @@ std::vector<Texture2D> ResourceManager::uiTextures;
 std::vector<Sound> ResourceManager::sounds;
 std::vector<Music> ResourceManager::music;
 Font ResourceManager::font;
+int ResourceManager::soundAliases = 0;
+int ResourceManager::soundBudget = -1;
 Texture2D ResourceManager::defaultTexture;
 Texture2D ResourceManager::invalidTexture;
 
 bool ResourceManager::LoadResources()
 {
+    RECORDER_ZONE("LoadResources");
     if (!IsWindowReady())
     {
         return false;
@@ -120,8 +125,27 @@ bool ResourceManager::LoadResources()
     return true;
 }
 
+void ResourceManager::LoadHeadlessResources()
+{
+    if (!spriteTextures.empty())
+    {
+        return; // already loaded, with or without a window
+    }
+    spriteTextures.assign(NUM_SPRITE_TEXTURES, invalidTexture);
+    uiTextures.assign(NUM_UI_TEXTURES, invalidTexture);
+    sounds.assign(NUM_SOUNDS, Sound{0});
+}
+
 void ResourceManager::UnloadResources()
 {
+    if (!IsWindowReady())
+    {
+        // headless, nothing was loaded on the gpu or the audio device
+        spriteTextures.clear();
+        uiTextures.clear();
+        sounds.clear();
+        return;
+    }
     for (size_t i = 0; i < spriteTextures.size(); i++)
     {
         UnloadTexture(spriteTextures[i]);
@@ -213,13 +237,99 @@ Sound *ResourceManager::GetSound(SoundID id)
 
 Sound ResourceManager::CreateSoundAlias(SoundID id)
 {
-    if (id >= sounds.size())
+    RECORDER_ZONE("CreateSoundAlias");
+    if (id >= sounds.size() || sounds[id].stream.buffer == nullptr)
     {
-        return {{0}};
+        return {{0}}; // headless
     }
+    soundAliases++;
     return LoadSoundAlias(sounds[id]);
 }
 
+void ResourceManager::UnloadSoundAlias(Sound alias)
+{
+    if (alias.frameCount > 0 && alias.stream.buffer != nullptr)
+    {
+        if (IsSoundPlaying(alias))
+        {
+            StopSound(alias);
+        }
+        soundAliases--;
+        ::UnloadSoundAlias(alias);
+    }
+}
+
+// the missing textures all share the invalid texture, each gpu texture is only counted once
+static void AddTextureUsage(MemoryReport *report, MemoryCategory category, Texture2D texture, std::vector<unsigned int> *counted)
+{
+    for (unsigned int id : *counted)
+    {
+        if (id == texture.id)
+        {
+            return;
+        }
+    }
+    counted->push_back(texture.id);
+    AddMemoryUsage(report, category, 0, GetTextureBytes(texture));
+}
+
+void ResourceManager::GetMemoryUsage(MemoryReport *report)
+{
+    std::vector<unsigned int> counted;
+    AddTextureUsage(report, MEMORY_TEXTURES, defaultTexture, &counted);
+    AddTextureUsage(report, MEMORY_TEXTURES, invalidTexture, &counted);
+    for (size_t i = 0; i < spriteTextures.size(); i++)
+    {
+        AddTextureUsage(report, MEMORY_TEXTURES, spriteTextures[i], &counted);
+    }
+    for (size_t i = 0; i < uiTextures.size(); i++)
+    {
+        AddTextureUsage(report, MEMORY_TEXTURES, uiTextures[i], &counted);
+    }
+    if (icon.data != nullptr)
+    {
+        AddMemoryUsage(report, MEMORY_TEXTURES, GetPixelDataSize(icon.width, icon.height, icon.format), 0);
+    }
+
+    for (size_t i = 0; i < sounds.size(); i++)
+    {
+        AddMemoryUsage(report, MEMORY_SOUNDS, GetSoundBytes(sounds[i]), 0);
+    }
+    AddMemoryUsage(report, MEMORY_SOUND_ALIASES, (size_t)soundAliases * SOUND_ALIAS_BYTES, 0);
+
+    size_t glyphBytes = (size_t)font.glyphCount * (sizeof(GlyphInfo) + sizeof(Rectangle));
+    for (int i = 0; i < font.glyphCount && font.glyphs != nullptr; i++)
+    {
+        const Image *image = &font.glyphs[i].image;
+        glyphBytes += image->data != nullptr ? GetPixelDataSize(image->width, image->height, image->format) : 0;
+    }
+    AddMemoryUsage(report, MEMORY_FONT, glyphBytes, GetTextureBytes(font.texture));
+}
+
+void ResourceManager::PlaySound(Sound sound)
+{
+    if (sound.stream.buffer == nullptr)
+    {
+        return;
+    }
+    if (soundBudget == 0)
+    {
+        AddCounter(COUNTER_SOUNDS_SKIPPED);
+        return;
+    }
+    if (soundBudget > 0)
+    {
+        soundBudget--;
+    }
+    AddCounter(COUNTER_SOUNDS_PLAYED);
+    ::PlaySound(sound);
+}
+
+void ResourceManager::SetSoundBudget(int sounds)
+{
+    soundBudget = sounds;
+}
+
 Font *ResourceManager::GetFont()
 {
     return &font;
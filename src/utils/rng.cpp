@@ -0,0 +1,46 @@
+#include "utils/rng.hpp"
+
+void Rng::Seed(uint64_t seed, uint64_t stream)
+{
+    s.state = 0;
+    s.increment = (stream << 1u) | 1u;
+    Next();
+    s.state += seed;
+    Next();
+}
+
+int Rng::GetInt(int min, int max)
+{
+    if (min > max)
+    {
+        const int tmp = max;
+        max = min;
+        min = tmp;
+    }
+
+    const uint32_t range = (uint32_t)((int64_t)max - (int64_t)min) + 1u;
+    if (range == 0)
+    {
+        return (int)Next(); // the whole int range
+    }
+
+    // multiply and reject the few values that would make the lower results more likely
+    uint64_t m = (uint64_t)Next() * range;
+    uint32_t low = (uint32_t)m;
+    if (low < range)
+    {
+        const uint32_t threshold = -range % range;
+        while (low < threshold)
+        {
+            m = (uint64_t)Next() * range;
+            low = (uint32_t)m;
+        }
+    }
+    return (int)((int64_t)min + (int64_t)(m >> 32));
+}
+
+Rng Rng::Split(uint64_t stream)
+{
+    const uint64_t seed = (uint64_t)Next() | ((uint64_t)Next() << 32);
+    return Rng(seed, stream);
+}
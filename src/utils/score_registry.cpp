@@ -1,6 +1,8 @@
 #include "utils/score_registry.hpp"
 
-std::map<ScoreType, int> scoreValues = {
+#include <map>
+
+const std::map<ScoreType, int> scoreValues = {
     {TIME_ALIVE, 100},
     {ENEMY_SHOOTER_KILLED, 2000},
     {ENEMY_STALKER_KILLED, 1500},
@@ -17,7 +19,7 @@ std::map<ScoreType, int> scoreValues = {
     {EXTRA_BULLET_UPGRADE_POWERUP_COLLECTED, 50},
 };
 
-std::map<ScoreType, const char *> scoreNames = {
+const std::map<ScoreType, const char *> scoreNames = {
     {TIME_ALIVE, "Seconds Alive"},
     {ENEMY_SHOOTER_KILLED, "Shooters Killed"},
     {ENEMY_STALKER_KILLED, "Stalkers Killed"},
@@ -34,59 +36,56 @@ std::map<ScoreType, const char *> scoreNames = {
     {EXTRA_BULLET_UPGRADE_POWERUP_COLLECTED, "Extra Bullet Upgrades Collected"},
 };
 
-std::map<ScoreType, float> scoreRegistry;
-
-float highScore = 0;
-float totalScore = 0;
-
 void InitScoreRegistry()
 {
-    totalScore = 0;
-    for (auto &score : scoreValues)
+    ScoreRegistry *registry = GetGameScores();
+    registry->totalScore = 0;
+    for (int i = 0; i < NUM_SCORE_TYPES; i++)
     {
-        scoreRegistry[score.first] = 0;
+        registry->scores[i] = 0;
     }
 }
 
 void AddScore(ScoreType type, float multiplier)
 {
+    ScoreRegistry *registry = GetGameScores();
     if (type == TIME_ALIVE)
     {
-        scoreRegistry[TIME_ALIVE] += 1.0f * GetFrameTime() * multiplier;
-        totalScore += scoreValues[type] * GetFrameTime() * multiplier;
+        registry->scores[TIME_ALIVE] += 1.0f * GetWorldFrameTime() * multiplier;
+        registry->totalScore += scoreValues.at(type) * GetWorldFrameTime() * multiplier;
     }
     else
     {
-        scoreRegistry[type] += 1.0f * multiplier;
-        totalScore += scoreValues[type] * multiplier;
+        registry->scores[type] += 1.0f * multiplier;
+        registry->totalScore += scoreValues.at(type) * multiplier;
     }
 
-    highScore = totalScore > highScore ? totalScore : highScore;
+    registry->highScore = registry->totalScore > registry->highScore ? registry->totalScore : registry->highScore;
 }
 
 int GetRawScore(ScoreType type)
 {
-    return scoreRegistry[type];
+    return GetGameScores()->scores[type];
 }
 
 int GetScore(ScoreType type)
 {
-    return scoreRegistry[type] * scoreValues[type];
+    return GetGameScores()->scores[type] * scoreValues.at(type);
 }
 
 int GetTotalScore()
 {
-    return totalScore;
+    return GetGameScores()->totalScore;
 }
 
 int GetHighScore()
 {
-    return highScore;
+    return GetGameScores()->highScore;
 }
 
 const char *GetScoreName(ScoreType type)
 {
-    return scoreNames[type];
+    return scoreNames.at(type);
 }
 
 const char *GetGenericScoreName(ScoreType type)
@@ -103,6 +102,26 @@ const char *GetGenericScoreName(ScoreType type)
     return "Unknown Score Type";
 }
 
+void SaveScoreRegistry(float scores[NUM_SCORE_TYPES], float *total)
+{
+    ScoreRegistry *registry = GetGameScores();
+    for (int i = 0; i < NUM_SCORE_TYPES; i++)
+    {
+        scores[i] = registry->scores[i];
+    }
+    *total = registry->totalScore;
+}
+
+void LoadScoreRegistry(const float scores[NUM_SCORE_TYPES], float total)
+{
+    ScoreRegistry *registry = GetGameScores();
+    for (int i = 0; i < NUM_SCORE_TYPES; i++)
+    {
+        registry->scores[i] = scores[i];
+    }
+    registry->totalScore = total;
+}
+
 void ResetScoreRegistry()
 {
     InitScoreRegistry();
@@ -0,0 +1,411 @@
+#include "utils/simd.hpp"
+
+#include <math.h>
+#include <mutex>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SIMD_HAS_SSE2
+#if defined(__GNUC__) || defined(__clang__)
+// the AVX2 kernels are compiled with a target attribute and only used if the cpu supports them
+#include <immintrin.h>
+#define SIMD_HAS_AVX2
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define SIMD_HAS_WASM128
+#endif
+
+typedef struct SimdKernels
+{
+    void (*translate)(Vector2 *points, size_t count, Vector2 translation);
+    void (*transform)(const Vector2 *src, Vector2 *dst, size_t count, PointTransform transform);
+    void (*pointsInPolygon)(const float *xs, const float *ys, size_t count, const HalfPlane *planes, size_t planeCount, unsigned char *inside);
+} SimdKernels;
+
+// ------------------------------------------------------------------------------------------ //
+// ------------------------------------- SCALAR KERNELS ------------------------------------- //
+// ------------------------------------------------------------------------------------------ //
+
+static void TranslatePointsScalar(Vector2 *points, size_t count, Vector2 translation)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        points[i].x += translation.x;
+        points[i].y += translation.y;
+    }
+}
+
+static void TransformPointsScalar(const Vector2 *src, Vector2 *dst, size_t count, PointTransform t)
+{
+    const Vector2 offset = {t.pivot.x + t.translation.x, t.pivot.y + t.translation.y};
+    for (size_t i = 0; i < count; i++)
+    {
+        const float dx = src[i].x - t.pivot.x;
+        const float dy = src[i].y - t.pivot.y;
+        dst[i].x = t.cos * dx - t.sin * dy + offset.x;
+        dst[i].y = t.sin * dx + t.cos * dy + offset.y;
+    }
+}
+
+static void PointsInConvexPolygonScalar(const float *xs, const float *ys, size_t count, const HalfPlane *planes, size_t planeCount, unsigned char *inside)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        bool in = true;
+        for (size_t p = 0; p < planeCount && in; p++)
+        {
+            in = planes[p].normalX * xs[i] + planes[p].normalY * ys[i] <= planes[p].distance;
+        }
+        inside[i] = in;
+    }
+}
+
+// Points are stored interleaved (x0 y0 x1 y1 ...), so every vector holds whole points.
+// Rotating a point needs its swapped components: x' = c * x - s * y, y' = c * y + s * x
+// which is computed for all the lanes at once as v * (c c c c) + swap(v) * (-s s -s s)
+
+// ------------------------------------------------------------------------------------------ //
+// -------------------------------------- SSE2 KERNELS -------------------------------------- //
+// ------------------------------------------------------------------------------------------ //
+
+#ifdef SIMD_HAS_SSE2
+static void TranslatePointsSSE2(Vector2 *points, size_t count, Vector2 translation)
+{
+    float *data = (float *)points;
+    const __m128 t = _mm_setr_ps(translation.x, translation.y, translation.x, translation.y);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_ps(data + 2 * i, _mm_add_ps(_mm_loadu_ps(data + 2 * i), t));
+    }
+    TranslatePointsScalar(points + i, count - i, translation);
+}
+
+static void TransformPointsSSE2(const Vector2 *src, Vector2 *dst, size_t count, PointTransform t)
+{
+    const float *in = (const float *)src;
+    float *out = (float *)dst;
+    const __m128 pivot = _mm_setr_ps(t.pivot.x, t.pivot.y, t.pivot.x, t.pivot.y);
+    const __m128 offset = _mm_add_ps(pivot, _mm_setr_ps(t.translation.x, t.translation.y, t.translation.x, t.translation.y));
+    const __m128 c = _mm_set1_ps(t.cos);
+    const __m128 s = _mm_setr_ps(-t.sin, t.sin, -t.sin, t.sin);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128 d = _mm_sub_ps(_mm_loadu_ps(in + 2 * i), pivot);
+        const __m128 swapped = _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_ps(out + 2 * i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(d, c), _mm_mul_ps(swapped, s)), offset));
+    }
+    TransformPointsScalar(src + i, dst + i, count - i, t);
+}
+
+static void PointsInConvexPolygonSSE2(const float *xs, const float *ys, size_t count, const HalfPlane *planes, size_t planeCount, unsigned char *inside)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(xs + i);
+        const __m128 y = _mm_loadu_ps(ys + i);
+        __m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (size_t p = 0; p < planeCount; p++)
+        {
+            const __m128 d = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(planes[p].normalX)), _mm_mul_ps(y, _mm_set1_ps(planes[p].normalY)));
+            in = _mm_and_ps(in, _mm_cmple_ps(d, _mm_set1_ps(planes[p].distance)));
+        }
+        const int mask = _mm_movemask_ps(in);
+        for (int j = 0; j < 4; j++)
+        {
+            inside[i + j] = (mask >> j) & 1;
+        }
+    }
+    PointsInConvexPolygonScalar(xs + i, ys + i, count - i, planes, planeCount, inside + i);
+}
+#endif // SIMD_HAS_SSE2
+
+// ------------------------------------------------------------------------------------------ //
+// -------------------------------------- AVX2 KERNELS -------------------------------------- //
+// ------------------------------------------------------------------------------------------ //
+
+#ifdef SIMD_HAS_AVX2
+SIMD_TARGET_AVX2 static void TranslatePointsAVX2(Vector2 *points, size_t count, Vector2 translation)
+{
+    float *data = (float *)points;
+    const __m256 t = _mm256_setr_ps(translation.x, translation.y, translation.x, translation.y,
+                                    translation.x, translation.y, translation.x, translation.y);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_ps(data + 2 * i, _mm256_add_ps(_mm256_loadu_ps(data + 2 * i), t));
+    }
+    TranslatePointsSSE2(points + i, count - i, translation);
+}
+
+SIMD_TARGET_AVX2 static void TransformPointsAVX2(const Vector2 *src, Vector2 *dst, size_t count, PointTransform t)
+{
+    const float *in = (const float *)src;
+    float *out = (float *)dst;
+    const __m256 pivot = _mm256_setr_ps(t.pivot.x, t.pivot.y, t.pivot.x, t.pivot.y,
+                                        t.pivot.x, t.pivot.y, t.pivot.x, t.pivot.y);
+    const __m256 translation = _mm256_setr_ps(t.translation.x, t.translation.y, t.translation.x, t.translation.y,
+                                              t.translation.x, t.translation.y, t.translation.x, t.translation.y);
+    const __m256 offset = _mm256_add_ps(pivot, translation);
+    const __m256 c = _mm256_set1_ps(t.cos);
+    const __m256 s = _mm256_setr_ps(-t.sin, t.sin, -t.sin, t.sin, -t.sin, t.sin, -t.sin, t.sin);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(in + 2 * i), pivot);
+        const __m256 swapped = _mm256_permute_ps(d, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm256_storeu_ps(out + 2 * i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d, c), _mm256_mul_ps(swapped, s)), offset));
+    }
+    TransformPointsSSE2(src + i, dst + i, count - i, t);
+}
+
+SIMD_TARGET_AVX2 static void PointsInConvexPolygonAVX2(const float *xs, const float *ys, size_t count, const HalfPlane *planes, size_t planeCount, unsigned char *inside)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(xs + i);
+        const __m256 y = _mm256_loadu_ps(ys + i);
+        __m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (size_t p = 0; p < planeCount; p++)
+        {
+            const __m256 d = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(planes[p].normalX)), _mm256_mul_ps(y, _mm256_set1_ps(planes[p].normalY)));
+            in = _mm256_and_ps(in, _mm256_cmp_ps(d, _mm256_set1_ps(planes[p].distance), _CMP_LE_OQ));
+        }
+        const int mask = _mm256_movemask_ps(in);
+        for (int j = 0; j < 8; j++)
+        {
+            inside[i + j] = (mask >> j) & 1;
+        }
+    }
+    PointsInConvexPolygonSSE2(xs + i, ys + i, count - i, planes, planeCount, inside + i);
+}
+#endif // SIMD_HAS_AVX2
+
+// ------------------------------------------------------------------------------------------ //
+// ------------------------------------ WASM SIMD KERNELS ----------------------------------- //
+// ------------------------------------------------------------------------------------------ //
+
+#ifdef SIMD_HAS_WASM128
+static void TranslatePointsWasm128(Vector2 *points, size_t count, Vector2 translation)
+{
+    float *data = (float *)points;
+    const v128_t t = wasm_f32x4_make(translation.x, translation.y, translation.x, translation.y);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        wasm_v128_store(data + 2 * i, wasm_f32x4_add(wasm_v128_load(data + 2 * i), t));
+    }
+    TranslatePointsScalar(points + i, count - i, translation);
+}
+
+static void TransformPointsWasm128(const Vector2 *src, Vector2 *dst, size_t count, PointTransform t)
+{
+    const float *in = (const float *)src;
+    float *out = (float *)dst;
+    const v128_t pivot = wasm_f32x4_make(t.pivot.x, t.pivot.y, t.pivot.x, t.pivot.y);
+    const v128_t offset = wasm_f32x4_add(pivot, wasm_f32x4_make(t.translation.x, t.translation.y, t.translation.x, t.translation.y));
+    const v128_t c = wasm_f32x4_splat(t.cos);
+    const v128_t s = wasm_f32x4_make(-t.sin, t.sin, -t.sin, t.sin);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const v128_t d = wasm_f32x4_sub(wasm_v128_load(in + 2 * i), pivot);
+        const v128_t swapped = wasm_i32x4_shuffle(d, d, 1, 0, 3, 2);
+        wasm_v128_store(out + 2 * i, wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(d, c), wasm_f32x4_mul(swapped, s)), offset));
+    }
+    TransformPointsScalar(src + i, dst + i, count - i, t);
+}
+
+static void PointsInConvexPolygonWasm128(const float *xs, const float *ys, size_t count, const HalfPlane *planes, size_t planeCount, unsigned char *inside)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const v128_t x = wasm_v128_load(xs + i);
+        const v128_t y = wasm_v128_load(ys + i);
+        v128_t in = wasm_i32x4_splat(-1);
+        for (size_t p = 0; p < planeCount; p++)
+        {
+            const v128_t d = wasm_f32x4_add(wasm_f32x4_mul(x, wasm_f32x4_splat(planes[p].normalX)), wasm_f32x4_mul(y, wasm_f32x4_splat(planes[p].normalY)));
+            in = wasm_v128_and(in, wasm_f32x4_le(d, wasm_f32x4_splat(planes[p].distance)));
+        }
+        const int mask = wasm_i32x4_bitmask(in);
+        for (int j = 0; j < 4; j++)
+        {
+            inside[i + j] = (mask >> j) & 1;
+        }
+    }
+    PointsInConvexPolygonScalar(xs + i, ys + i, count - i, planes, planeCount, inside + i);
+}
+#endif // SIMD_HAS_WASM128
+
+// ------------------------------------------------------------------------------------------ //
+// ---------------------------------------- DISPATCH ---------------------------------------- //
+// ------------------------------------------------------------------------------------------ //
+
+static SimdBackend currentBackend = NUM_SIMD_BACKENDS; // not selected yet
+static SimdKernels kernels = {TranslatePointsScalar, TransformPointsScalar, PointsInConvexPolygonScalar};
+static std::once_flag backendSelected;
+
+static SimdBackend GetBestSimdBackend()
+{
+    for (int i = NUM_SIMD_BACKENDS - 1; i > SIMD_SCALAR; i--)
+    {
+        if (IsSimdBackendSupported((SimdBackend)i))
+        {
+            return (SimdBackend)i;
+        }
+    }
+    return SIMD_SCALAR;
+}
+
+static inline const SimdKernels *GetKernels()
+{
+    // worlds are stepped in several threads, the first kernel call of any of them selects the backend
+    // and the others wait for it instead of reading a half written table
+    std::call_once(backendSelected, []()
+                   {
+                       if (currentBackend == NUM_SIMD_BACKENDS)
+                       {
+                           SetSimdBackend(GetBestSimdBackend());
+                       } });
+    return &kernels;
+}
+
+bool IsSimdBackendSupported(SimdBackend backend)
+{
+    switch (backend)
+    {
+    case SIMD_SCALAR:
+        return true;
+#ifdef SIMD_HAS_SSE2
+    case SIMD_SSE2:
+        return true;
+#endif // SIMD_HAS_SSE2
+#ifdef SIMD_HAS_AVX2
+    case SIMD_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif // SIMD_HAS_AVX2
+#ifdef SIMD_HAS_WASM128
+    case SIMD_WASM128:
+        return true;
+#endif // SIMD_HAS_WASM128
+    default:
+        return false;
+    }
+}
+
+bool SetSimdBackend(SimdBackend newBackend)
+{
+    if (!IsSimdBackendSupported(newBackend))
+    {
+        return false;
+    }
+
+    switch (newBackend)
+    {
+#ifdef SIMD_HAS_SSE2
+    case SIMD_SSE2:
+        kernels = {TranslatePointsSSE2, TransformPointsSSE2, PointsInConvexPolygonSSE2};
+        break;
+#endif // SIMD_HAS_SSE2
+#ifdef SIMD_HAS_AVX2
+    case SIMD_AVX2:
+        kernels = {TranslatePointsAVX2, TransformPointsAVX2, PointsInConvexPolygonAVX2};
+        break;
+#endif // SIMD_HAS_AVX2
+#ifdef SIMD_HAS_WASM128
+    case SIMD_WASM128:
+        kernels = {TranslatePointsWasm128, TransformPointsWasm128, PointsInConvexPolygonWasm128};
+        break;
+#endif // SIMD_HAS_WASM128
+    default:
+        kernels = {TranslatePointsScalar, TransformPointsScalar, PointsInConvexPolygonScalar};
+        break;
+    }
+    currentBackend = newBackend;
+    return true;
+}
+
+SimdBackend GetSimdBackend()
+{
+    GetKernels();
+    return currentBackend;
+}
+
+const char *GetSimdBackendName(SimdBackend backend)
+{
+    static const char *names[] = {"Scalar", "SSE2", "AVX2", "WASM SIMD128"};
+    return backend < NUM_SIMD_BACKENDS ? names[backend] : "Unknown";
+}
+
+PointTransform MakePointTransform(Vector2 pivot, float angle, float scale, Vector2 translation)
+{
+    const float radians = angle * DEG2RAD;
+    return {pivot, cosf(radians) * scale, sinf(radians) * scale, translation};
+}
+
+void TranslatePoints(Vector2 *points, size_t count, Vector2 translation)
+{
+    GetKernels()->translate(points, count, translation);
+}
+
+void TransformPoints(const Vector2 *src, Vector2 *dst, size_t count, PointTransform transform)
+{
+    GetKernels()->transform(src, dst, count, transform);
+}
+
+size_t MakeConvexHalfPlanes(const Vector2 *polygon, size_t count, HalfPlane *planes, size_t maxPlanes)
+{
+    // hitboxes repeat the first vertex to close the polygon
+    if (count > 1 && polygon[0].x == polygon[count - 1].x && polygon[0].y == polygon[count - 1].y)
+    {
+        count--;
+    }
+    if (count < 3 || count > maxPlanes)
+    {
+        return 0;
+    }
+
+    // the sign of the area gives the winding order, so the normals can always point outwards
+    float area = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const Vector2 a = polygon[i];
+        const Vector2 b = polygon[(i + 1) % count];
+        area += a.x * b.y - b.x * a.y;
+    }
+    const float sign = area >= 0 ? 1.0f : -1.0f;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const Vector2 a = polygon[i];
+        const Vector2 b = polygon[(i + 1) % count];
+        const Vector2 c = polygon[(i + 2) % count];
+
+        // every turn has to go in the winding direction
+        const float turn = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+        if (turn * sign < 0)
+        {
+            return 0;
+        }
+
+        const Vector2 edge = {b.x - a.x, b.y - a.y};
+        planes[i].normalX = sign * edge.y;
+        planes[i].normalY = -sign * edge.x;
+        planes[i].distance = planes[i].normalX * a.x + planes[i].normalY * a.y;
+    }
+    return count;
+}
+
+void PointsInConvexPolygon(const float *xs, const float *ys, size_t count, const HalfPlane *planes, size_t planeCount, unsigned char *inside)
+{
+    GetKernels()->pointsInPolygon(xs, ys, count, planes, planeCount, inside);
+}
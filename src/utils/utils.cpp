@@ -1,5 +1,6 @@
 #include "utils/utils.hpp"
 #include "raymath.h"
+#include "utils/profiler.hpp"
 
 Rectangle CreateCenteredButtonRec(Button **mainMenuButtons, int numButtons)
 {
@@ -13,7 +14,7 @@ Rectangle CreateCenteredButtonRec(Button **mainMenuButtons, int numButtons)
     return centeredMenu;
 }
 
-std::vector<Vector2> getAxes(std::vector<Vector2> hitbox)
+std::vector<Vector2> getAxes(const std::vector<Vector2> &hitbox)
 {
     std::vector<Vector2> axes = {};
 
@@ -34,7 +35,7 @@ std::vector<Vector2> getAxes(std::vector<Vector2> hitbox)
     return axes;
 }
 
-Vector2 Project(Vector2 axis, std::vector<Vector2> hitbox)
+Vector2 Project(Vector2 axis, const std::vector<Vector2> &hitbox)
 {
     float min = 0;
     float max = 0;
@@ -70,15 +71,15 @@ bool Overlaps(Vector2 a, Vector2 b, float *overlap)
     return false;
 }
 
-Vector2 RandomVecOutsideScreen(float margin)
+Vector2 RandomVecOutsideScreen(float margin, Rectangle world, Rng *rng)
 {
     // y-axis is inverted in raylib
     // x-axis is normal
 
-    const int top = -GetScreenHeight() / 2 - margin;
-    const int right = GetScreenWidth() / 2 + margin;
-    const int bottom = GetScreenHeight() / 2 + margin;
-    const int left = -GetScreenWidth() / 2 - margin;
+    const int top = world.y - margin;
+    const int right = world.x + world.width + margin;
+    const int bottom = world.y + world.height + margin;
+    const int left = world.x - margin;
 
     //            margin
     //           |--|
@@ -96,24 +97,25 @@ Vector2 RandomVecOutsideScreen(float margin)
     //           |                                      |
     //          left                                  right
     //
-    // Visible world is Rectangle{-screenWidth/2, -screenHeight/2, screenWidth, screenHeight} (the center of the screen is the world's origin)
+    // Visible world is Rectangle{-screenWidth/2, -screenHeight/2, screenWidth, screenHeight} (the center of the screen is the world's origin),
+    // worlds without a window have the same rectangle with their own size
 
     // pick a random side and a random position on that side
-    int side = GetRandomValue(0, 3);
+    int side = rng->GetInt(0, 3);
     Vector2 pos;
     switch (side)
     {
     case 0: // top
-        pos = {(float)GetRandomValue(left, right), top + margin / 2};
+        pos = {(float)rng->GetInt(left, right), top + margin / 2};
         break;
     case 1: // right
-        pos = {right - margin / 2, (float)GetRandomValue(top, bottom)};
+        pos = {right - margin / 2, (float)rng->GetInt(top, bottom)};
         break;
     case 2: // bottom
-        pos = {(float)GetRandomValue(left, right), bottom - margin / 2};
+        pos = {(float)rng->GetInt(left, right), bottom - margin / 2};
         break;
     case 3: // left
-        pos = {left + margin / 2, (float)GetRandomValue(top, bottom)};
+        pos = {left + margin / 2, (float)rng->GetInt(top, bottom)};
         break;
     default:
         break;
@@ -122,15 +124,16 @@ Vector2 RandomVecOutsideScreen(float margin)
 }
 
 // "InsideScreen" refers to the visible world
-Vector2 RandomVecInsideScreen(float margin)
+Vector2 RandomVecInsideScreen(float margin, Rectangle world, Rng *rng)
 {
     // margin is the distance from the edge of the screen
-    return {(float)GetRandomValue(-GetScreenWidth() / 2 + margin, GetScreenWidth() / 2 - margin),
-            (float)GetRandomValue(-GetScreenHeight() / 2 + margin, GetScreenHeight() / 2 - margin)};
+    return {(float)rng->GetInt(world.x + margin, world.x + world.width - margin),
+            (float)rng->GetInt(world.y + margin, world.y + world.height - margin)};
 }
 
-Texture2D *GenerateStarsBackground(int width, int height, int numStars, int minRadius, int maxRadius)
+Texture2D *GenerateStarsBackground(int width, int height, int numStars, int minRadius, int maxRadius, Rng *rng)
 {
+    RECORDER_ZONE("GenerateStarsBackground");
     Texture2D starsBackground = {0};
     Image spaceBackgroundImg = GenImageColor(width, height, BLANK);
 
@@ -139,9 +142,9 @@ Texture2D *GenerateStarsBackground(int width, int height, int numStars, int minR
 
     for (int i = 0; i < numStars; i++)
     {
-        Color starColor = {255, 255, 255, (unsigned char)GetRandomValue(minStarAlpha * 255, maxStarAlpha * 255)};
-        ImageDrawCircle(&spaceBackgroundImg, GetRandomValue(0, width - maxRadius * 2),
-                        GetRandomValue(0, height - maxRadius * 2), GetRandomValue(minRadius, maxRadius), starColor);
+        Color starColor = {255, 255, 255, (unsigned char)rng->GetInt(minStarAlpha * 255, maxStarAlpha * 255)};
+        ImageDrawCircle(&spaceBackgroundImg, rng->GetInt(0, width - maxRadius * 2),
+                        rng->GetInt(0, height - maxRadius * 2), rng->GetInt(minRadius, maxRadius), starColor);
     }
 
     starsBackground = LoadTextureFromImage(spaceBackgroundImg);